@@ -0,0 +1,424 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory. Written by
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+/**
+ * Benchmark harness for the examples and drivers
+ *
+ * Usage: bench [options], run from the bench/ directory (see 'make run')
+ *
+ * Reads a matrix of problems (default bench.matrix), runs every case through
+ * the MPI launcher for each processor count and writes one JSON document with
+ * the statistics of each case (default bench.json).  Each line of the matrix
+ * has the form
+ *
+ *    name  nprocs  command
+ *
+ * where nprocs is a comma separated list of processor counts and command is
+ * relative to the repository root.  A group {a,b,c} in the command expands to
+ * one case per value, e.g. "-ntime {256,1024} -ml {2,3}" gives four cases.
+ * Lines starting with '#' are comments.
+ *
+ * The programs are run with BRAID_BENCH_FILE set, so braid_Drive() (or the
+ * block_gs/gj loops) appends a JSON record with the iterations, the final
+ * residual, the wall time and the per-level phase times of the run.  Each case
+ * is repeated and the harness reports min, median, mean and standard deviation
+ * of the wall time, the median run's iterations and convergence, and all the
+ * raw records.  A case is reported with "converged": 1 only if every repeat
+ * met its tolerance, so the time is a time-to-tolerance only for converged
+ * cases.  Cases that fail or do not converge are flagged in the output and
+ * counted in "unconverged", and the harness then exits with status 1.
+ *
+ * Each run is made in a scratch directory, removed afterwards, so whatever the
+ * programs write stays out of the tree.  The matrix turns their solution
+ * output off where they have an option for it, to keep file I/O out of the
+ * timings.
+ *
+ * The launcher is taken from the MPIRUN environment variable (default
+ * "mpirun -np"), and the processor count is appended to it.
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench_util.h"
+
+/*--------------------------------------------------------------------------
+ * Expand the first {a,b,c} group of each command, until none are left.
+ * Returns the new list of commands and sets *ncmds.
+ *--------------------------------------------------------------------------*/
+
+static char **
+bench_Expand(const char *command, int *ncmds)
+{
+   char  **cmds, **next;
+   int     n, nnext, i, done;
+
+   cmds    = (char **) malloc(sizeof(char *));
+   cmds[0] = bench_StrCopy(command);
+   n       = 1;
+
+   done = 0;
+   while (!done)
+   {
+      done  = 1;
+      next  = NULL;
+      nnext = 0;
+      for (i = 0; i < n; i++)
+      {
+         char *open  = strchr(cmds[i], '{');
+         char *close = (open != NULL) ? strchr(open, '}') : NULL;
+
+         if (close == NULL)
+         {
+            next = (char **) realloc(next, (nnext+1) * sizeof(char *));
+            next[nnext++] = cmds[i];
+            continue;
+         }
+
+         /* One new command per value in the group */
+         done = 0;
+         {
+            char *value = open + 1;
+
+            while (value <= close)
+            {
+               char   *end = value;
+               size_t  len;
+
+               while (*end != ',' && end != close)
+               {
+                  end++;
+               }
+               len  = (open - cmds[i]) + (end - value) + strlen(close+1) + 1;
+               next = (char **) realloc(next, (nnext+1) * sizeof(char *));
+               next[nnext] = (char *) malloc(len);
+               sprintf(next[nnext], "%.*s%.*s%s", (int) (open - cmds[i]), cmds[i],
+                       (int) (end - value), value, close+1);
+               nnext++;
+               value = end + 1;
+            }
+         }
+         free(cmds[i]);
+      }
+      free(cmds);
+      cmds = next;
+      n    = nnext;
+   }
+
+   *ncmds = n;
+   return cmds;
+}
+
+/*--------------------------------------------------------------------------
+ * Sort helper
+ *--------------------------------------------------------------------------*/
+
+static int
+bench_CompareRuns(const void *a, const void *b)
+{
+   double ta = ((const bench_Run *) a)->time;
+   double tb = ((const bench_Run *) b)->time;
+
+   return (ta > tb) - (ta < tb);
+}
+
+/*--------------------------------------------------------------------------
+ * Print min/median/mean/stddev of the runs' braid and launcher times
+ *--------------------------------------------------------------------------*/
+
+static void
+bench_PrintStats(FILE *fp, const char *key, bench_Run *runs, int nruns, int wall)
+{
+   double  *t = (double *) malloc(nruns * sizeof(double));
+   double   tmin, tmed, mean, stddev;
+   int      i;
+
+   for (i = 0; i < nruns; i++)
+   {
+      t[i] = wall ? runs[i].wall : runs[i].time;
+   }
+   bench_Stats(t, nruns, &tmin, &tmed, &mean, &stddev);
+   fprintf(fp, "\"%s\": {\"min\": %1.6e, \"median\": %1.6e, \"mean\": %1.6e, \"stddev\": %1.6e}",
+           key, tmin, tmed, mean, stddev);
+   free(t);
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+int
+main(int argc, char *argv[])
+{
+   const char  *matrix   = "bench.matrix";
+   const char  *output   = "bench.json";
+   const char  *root     = "..";
+   const char  *filter   = NULL;
+   const char  *launcher = getenv("MPIRUN");
+   const char  *recfile  = "bench.record";
+   const char  *logfile  = "bench.log";
+   int          repeats  = 3;
+   int          warmups  = 1;
+   int          maxprocs = 0;
+   int          dryrun   = 0;
+
+   char         line[BENCH_MAXLINE], name[256], plist[256], host[256];
+   char         commit[64], date[64], recpath[BENCH_MAXLINE], command[2*BENCH_MAXLINE];
+   char       **cmds;
+   bench_Run   *runs;
+   FILE        *mfp, *ofp, *pfp;
+   time_t       now;
+   int          arg_index, ncmds, ncases, nbad, icmd, nprocs, irun, nok, nconv, offset;
+   char        *np;
+
+   if (launcher == NULL)
+   {
+      launcher = "mpirun -np";
+   }
+
+   arg_index = 1;
+   while (arg_index < argc)
+   {
+      if ( strcmp(argv[arg_index], "-help") == 0 )
+      {
+         printf("\n");
+         printf("  -m <file>      : matrix of problems (default bench.matrix)\n");
+         printf("  -o <file>      : JSON output file (default bench.json)\n");
+         printf("  -r <repeats>   : timed runs of each case (default 3)\n");
+         printf("  -w <warmups>   : untimed runs before the timed ones (default 1)\n");
+         printf("  -np <nprocs>   : skip cases with more than nprocs processors\n");
+         printf("  -f <name>      : only run problems whose name contains name\n");
+         printf("  -root <dir>    : repository root the commands are relative to (default ..)\n");
+         printf("  -dry           : print the commands without running them\n");
+         printf("\n");
+         printf("  The launcher is $MPIRUN (default \"mpirun -np\")\n");
+         printf("  Exits with status 1 if a case fails or does not converge\n");
+         printf("\n");
+         exit(0);
+      }
+      else if ( strcmp(argv[arg_index], "-m") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         matrix = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-o") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         output = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-r") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         repeats = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-w") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         warmups = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-np") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         maxprocs = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-f") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         filter = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-root") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         root = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-dry") == 0 )
+      {
+         arg_index++;
+         dryrun = 1;
+      }
+      else
+      {
+         printf("ABORTING: incorrect command line parameter %s\n", argv[arg_index]);
+         exit(1);
+      }
+   }
+   if (repeats < 1)
+   {
+      repeats = 1;
+   }
+
+   mfp = fopen(matrix, "r");
+   if (mfp == NULL)
+   {
+      printf("ABORTING: cannot open matrix file %s\n", matrix);
+      exit(1);
+   }
+   ofp = dryrun ? NULL : fopen(output, "w");
+   if (!dryrun && ofp == NULL)
+   {
+      printf("ABORTING: cannot open output file %s\n", output);
+      exit(1);
+   }
+
+   bench_SetRecordFile(recfile, recpath);
+
+   /* Header: enough to reproduce the numbers */
+   sprintf(line, "git -C %s rev-parse --short HEAD 2>/dev/null", root);
+   commit[0] = '\0';
+   pfp = popen(line, "r");
+   if (pfp != NULL)
+   {
+      if (fgets(commit, sizeof(commit), pfp) == NULL)
+      {
+         commit[0] = '\0';
+      }
+      commit[strcspn(commit, "\n")] = '\0';
+      pclose(pfp);
+   }
+   if (gethostname(host, sizeof(host)) != 0)
+   {
+      strcpy(host, "unknown");
+   }
+   now = time(NULL);
+   strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+   if (!dryrun)
+   {
+      fprintf(ofp, "{\n\"commit\": ");
+      bench_PrintString(ofp, commit);
+      fprintf(ofp, ",\n\"host\": ");
+      bench_PrintString(ofp, host);
+      fprintf(ofp, ",\n\"date\": \"%s\",\n\"launcher\": ", date);
+      bench_PrintString(ofp, launcher);
+      fprintf(ofp, ",\n\"repeats\": %d,\n\"warmups\": %d,\n\"cases\": [", repeats, warmups);
+   }
+
+   runs   = (bench_Run *) malloc(repeats * sizeof(bench_Run));
+   ncases = 0;
+   nbad   = 0;
+   while (fgets(line, BENCH_MAXLINE, mfp) != NULL)
+   {
+      line[strcspn(line, "\n")] = '\0';
+      if (line[0] == '#' || sscanf(line, "%255s %255s %n", name, plist, &offset) < 2)
+      {
+         continue;
+      }
+      if (filter != NULL && strstr(name, filter) == NULL)
+      {
+         continue;
+      }
+
+      cmds = bench_Expand(line + offset, &ncmds);
+      for (icmd = 0; icmd < ncmds; icmd++)
+      {
+         for (np = strtok(plist, ","); np != NULL; np = strtok(NULL, ","))
+         {
+            nprocs = atoi(np);
+            if (nprocs < 1 || (maxprocs > 0 && nprocs > maxprocs))
+            {
+               continue;
+            }
+
+            printf("%s: np %d: %s\n", name, nprocs, cmds[icmd]);
+            if (dryrun)
+            {
+               continue;
+            }
+
+            sprintf(command, "%s/%s", root, cmds[icmd]);
+            for (irun = 0; irun < warmups; irun++)
+            {
+               bench_RunOne(launcher, nprocs, command, recpath, logfile, &runs[0]);
+               free(runs[0].record);
+            }
+            nok   = 0;
+            nconv = 0;
+            for (irun = 0; irun < repeats; irun++)
+            {
+               bench_RunOne(launcher, nprocs, command, recpath, logfile, &runs[irun]);
+               nok   += (runs[irun].record != NULL);
+               nconv += (runs[irun].record != NULL && runs[irun].converged);
+            }
+
+            /* One JSON object per case */
+            fprintf(ofp, "%s\n{\"name\": ", (ncases > 0) ? "," : "");
+            bench_PrintString(ofp, name);
+            fprintf(ofp, ", \"command\": ");
+            bench_PrintString(ofp, cmds[icmd]);
+            fprintf(ofp, ", \"nprocs\": %d, \"ok\": %d", nprocs, (nok == repeats));
+            if (nok == repeats)
+            {
+               qsort(runs, repeats, sizeof(bench_Run), bench_CompareRuns);
+               fprintf(ofp, ", \"niter\": %d, \"converged\": %d,\n ",
+                       runs[repeats/2].niter, (nconv == repeats));
+               bench_PrintStats(ofp, "time", runs, repeats, 0);
+               fprintf(ofp, ",\n ");
+               bench_PrintStats(ofp, "wall", runs, repeats, 1);
+               fprintf(ofp, ",\n \"records\": [");
+               for (irun = 0; irun < repeats; irun++)
+               {
+                  fprintf(ofp, "%s\n  %s", (irun > 0) ? "," : "", runs[irun].record);
+               }
+               fprintf(ofp, "]");
+               printf("   %d iterations, converged %d, median time %1.3e\n",
+                      runs[repeats/2].niter, (nconv == repeats),
+                      runs[repeats/2].time);
+            }
+            if (nconv < repeats)
+            {
+               printf("   NOT CONVERGED: %d of %d runs %s\n", repeats - nconv, repeats,
+                      (nok < repeats) ? "failed or did not converge" : "did not converge");
+               nbad++;
+            }
+            fprintf(ofp, "}");
+            fflush(ofp);
+            for (irun = 0; irun < repeats; irun++)
+            {
+               free(runs[irun].record);
+            }
+            ncases++;
+         }
+         /* strtok modified plist, so read it again for the next command */
+         sscanf(line, "%255s %255s", name, plist);
+         free(cmds[icmd]);
+      }
+      free(cmds);
+   }
+   free(runs);
+   fclose(mfp);
+
+   if (!dryrun)
+   {
+      fprintf(ofp, "\n],\n\"unconverged\": %d\n}\n", nbad);
+      fclose(ofp);
+      remove(recpath);
+      printf("Wrote %d cases to %s\n", ncases, output);
+      if (nbad > 0)
+      {
+         printf("WARNING: %d of %d cases failed or did not converge\n", nbad, ncases);
+      }
+   }
+
+   return (nbad > 0);
+}
@@ -0,0 +1,278 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory. Written by
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "bench_util.h"
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+double
+bench_Wtime()
+{
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return (double) tv.tv_sec + 1.0e-6 * (double) tv.tv_usec;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+char *
+bench_StrCopy(const char *str)
+{
+   char *copy = (char *) malloc(strlen(str)+1);
+
+   strcpy(copy, str);
+   return copy;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+void
+bench_PrintString(FILE *fp, const char *str)
+{
+   fputc('"', fp);
+   for ( ; *str != '\0'; str++)
+   {
+      if (*str == '"' || *str == '\\')
+      {
+         fputc('\\', fp);
+      }
+      fputc(*str, fp);
+   }
+   fputc('"', fp);
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+int
+bench_RecordValue(const char *record, const char *key, double *value)
+{
+   char        pattern[64];
+   const char *pos;
+
+   sprintf(pattern, "\"%s\": ", key);
+   pos = strstr(record, pattern);
+   if (pos == NULL || sscanf(pos + strlen(pattern), "%lf", value) != 1)
+   {
+      return 0;
+   }
+   return 1;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+int
+bench_RecordSum(const char *record, const char *key, double *sum)
+{
+   char        pattern[64];
+   const char *pos;
+   char       *end;
+   double      value;
+
+   *sum = 0.0;
+   sprintf(pattern, "\"%s\": [", key);
+   pos = strstr(record, pattern);
+   if (pos == NULL)
+   {
+      return 0;
+   }
+   pos += strlen(pattern);
+   while (*pos != ']' && *pos != '\0')
+   {
+      value = strtod(pos, &end);
+      if (end == pos)
+      {
+         break;
+      }
+      *sum += value;
+      pos = end;
+      while (*pos == ',' || *pos == ' ')
+      {
+         pos++;
+      }
+   }
+   return 1;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+void
+bench_SetRecordFile(const char *recfile, char *recpath)
+{
+   if (getcwd(recpath, BENCH_MAXLINE - strlen(recfile) - 2) == NULL)
+   {
+      recpath[0] = '\0';
+   }
+   strcat(recpath, "/");
+   strcat(recpath, recfile);
+   setenv("BRAID_BENCH_FILE", recpath, 1);
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+void
+bench_RunOne(const char *launcher,
+             int         nprocs,
+             const char *command,
+             const char *recpath,
+             const char *logfile,
+             bench_Run  *run)
+{
+   char    line[2*BENCH_MAXLINE], cwd[BENCH_MAXLINE], scratch[BENCH_MAXLINE+32];
+   char   *shell;
+   FILE   *fp;
+   double  value, t0;
+   int     abscmd, abslog;
+
+   run->wall      = 0.0;
+   run->time      = 0.0;
+   run->niter     = 0;
+   run->converged = 0;
+   run->record    = NULL;
+
+   /* Run in a new scratch directory, with out/ for the examples, so that the
+    * solution files of the programs stay out of the tree */
+   if (getcwd(cwd, sizeof(cwd)) == NULL)
+   {
+      strcpy(cwd, ".");
+   }
+   snprintf(scratch, sizeof(scratch), "%s/bench.run.XXXXXX", cwd);
+   if (mkdtemp(scratch) == NULL)
+   {
+      printf("   failed: cannot create a scratch directory in %s\n", cwd);
+      return;
+   }
+   snprintf(line, sizeof(line), "%s/out", scratch);
+   mkdir(line, 0755);
+
+   /* Relative paths of the program and the log are from the current directory
+    * (a program name without a '/' is left to the PATH) */
+   abscmd = (command[0] == '/' || command[strcspn(command, "/ ")] != '/');
+   abslog = (logfile[0] == '/');
+   shell = (char *) malloc(strlen(command) + strlen(logfile) + 2*strlen(cwd) +
+                           strlen(scratch) + ((launcher != NULL) ? strlen(launcher) : 0) + 64);
+   sprintf(shell, "cd %s && ", scratch);
+   if (launcher != NULL)
+   {
+      sprintf(shell + strlen(shell), "%s %d ", launcher, nprocs);
+   }
+   sprintf(shell + strlen(shell), "%s%s%s > %s%s%s 2>&1",
+           abscmd ? "" : cwd, abscmd ? "" : "/", command,
+           abslog ? "" : cwd, abslog ? "" : "/", logfile);
+
+   remove(recpath);
+   t0 = bench_Wtime();
+   if (system(shell) != 0)
+   {
+      printf("   failed: %s (see %s)\n", shell, logfile);
+   }
+   run->wall = bench_Wtime() - t0;
+   free(shell);
+
+   snprintf(line, sizeof(line), "rm -rf %s", scratch);
+   if (system(line) != 0)
+   {
+      printf("   warning: could not remove %s\n", scratch);
+   }
+
+   /* Keep the last record (time chunks append one record per chunk) */
+   fp = fopen(recpath, "r");
+   if (fp == NULL)
+   {
+      return;
+   }
+   while (fgets(line, BENCH_MAXLINE, fp) != NULL)
+   {
+      if (line[0] == '{')
+      {
+         line[strcspn(line, "\n")] = '\0';
+         free(run->record);
+         run->record = bench_StrCopy(line);
+      }
+   }
+   fclose(fp);
+
+   if (run->record != NULL)
+   {
+      if (bench_RecordValue(run->record, "time", &value))
+      {
+         run->time = value;
+      }
+      if (bench_RecordValue(run->record, "niter", &value))
+      {
+         run->niter = (int) value;
+      }
+      if (bench_RecordValue(run->record, "converged", &value))
+      {
+         run->converged = (int) value;
+      }
+   }
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+void
+bench_Stats(double *t, int n, double *min, double *median, double *mean, double *stddev)
+{
+   double  var, ti;
+   int     i, j;
+
+   /* Insertion sort, n is small */
+   for (i = 1; i < n; i++)
+   {
+      ti = t[i];
+      for (j = i; j > 0 && t[j-1] > ti; j--)
+      {
+         t[j] = t[j-1];
+      }
+      t[j] = ti;
+   }
+   *min    = t[0];
+   *median = (n % 2) ? t[n/2] : 0.5 * (t[n/2-1] + t[n/2]);
+   *mean   = 0.0;
+   for (i = 0; i < n; i++)
+   {
+      *mean += t[i] / n;
+   }
+   var = 0.0;
+   for (i = 0; i < n; i++)
+   {
+      var += (t[i] - *mean) * (t[i] - *mean);
+   }
+   *stddev = (n > 1) ? sqrt(var / (n - 1)) : 0.0;
+}
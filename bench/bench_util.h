@@ -0,0 +1,116 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory. Written by
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+/** \file bench_util.h
+ * \brief Helpers shared by the benchmark drivers bench.c and scaling.c.
+ *
+ * A run launches one command with BRAID_BENCH_FILE pointing to a scratch
+ * file, and reads back the JSON record that braid_Drive() appends there (see
+ * braid_SetBenchFile()).  The record is kept as a string, and single values
+ * or per-level arrays are read from it by key.
+ **/
+
+#ifndef bench_util_HEADER
+#define bench_util_HEADER
+
+#include <stdio.h>
+
+#define BENCH_MAXLINE 4096
+
+/**
+ * One run of a command
+ **/
+typedef struct
+{
+   double  wall;          /**< wall time of the launched process */
+   double  time;          /**< braid wall time from the record */
+   int     niter;         /**< iterations from the record */
+   int     converged;     /**< convergence from the record */
+   char   *record;        /**< the raw JSON record, NULL if there was none */
+
+} bench_Run;
+
+/**
+ * Wall clock time in seconds
+ **/
+double
+bench_Wtime();
+
+/**
+ * Return a malloc'd copy of *str*
+ **/
+char *
+bench_StrCopy(const char *str);
+
+/**
+ * Print *str* to a JSON file as a quoted string
+ **/
+void
+bench_PrintString(FILE *fp, const char *str);
+
+/**
+ * Get the number stored under *key* in a JSON record.  Returns 0 if the key
+ * is missing (or its value is null), 1 otherwise.
+ **/
+int
+bench_RecordValue(const char *record, const char *key, double *value);
+
+/**
+ * Get the sum of the per-level array stored under *key* (e.g., "relax" in the
+ * phases, or "bytes").  Returns 0 if the key is missing, 1 otherwise.
+ **/
+int
+bench_RecordSum(const char *record, const char *key, double *sum);
+
+/**
+ * Point BRAID_BENCH_FILE to *recfile* in the current directory.  The absolute
+ * path is returned in *recpath* (of length BENCH_MAXLINE), so the programs may
+ * run in another directory.
+ **/
+void
+bench_SetRecordFile(const char *recfile, char *recpath);
+
+/**
+ * Run *command* on *nprocs* processors through *launcher* (the processor
+ * count is appended to it), or directly if *launcher* is NULL, with output to
+ * *logfile*.  Then read the last record in *recpath* into *run*.  The command
+ * runs in a scratch directory bench.run.* (with an out/ subdirectory), which
+ * is removed afterwards, and a relative program path is taken from the
+ * current directory.
+ **/
+void
+bench_RunOne(const char *launcher,
+             int         nprocs,
+             const char *command,
+             const char *recpath,
+             const char *logfile,
+             bench_Run  *run);
+
+/**
+ * Min, median, mean and (sample) standard deviation of t[0:n-1].  The array
+ * is sorted on return.
+ **/
+void
+bench_Stats(double *t, int n, double *min, double *median, double *mean, double *stddev);
+
+#endif
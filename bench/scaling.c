@@ -0,0 +1,403 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory. Written by
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+/**
+ * Time-parallel scaling study for one braid program
+ *
+ * Usage: scaling [options] command [arguments], run from the bench/ directory
+ *
+ * Runs the command on each processor count (-np), repeated for stability,
+ * and reads the record that braid_Drive() writes to BRAID_BENCH_FILE (see
+ * braid_SetBenchFile()).  From the median run of each count it reports the
+ * braid wall time, the speedup and parallel efficiency against the smallest
+ * count, the messages and bytes sent between time neighbors, and the wall
+ * time of each phase summed over the levels.  For a strong scaling study the
+ * command is fixed; with -weak n, the string {N} in the command is replaced
+ * by n*P, so the number of time steps per processor is fixed.
+ *
+ * Each count is also compared to sequential time stepping.  By default the
+ * reference is the same command with "-ml 1" appended (a one level solve is
+ * sequential time stepping in braid).  With -seq, any other program can be
+ * used, e.g. ex-04-serial.  If the reference writes no record, its process
+ * wall time is compared to the wall time of the parallel runs instead.  The
+ * crossover is the smallest processor count at which MGRIT beats the
+ * reference.
+ *
+ * Runs on one processor do not use the launcher, so a build of the program
+ * with mpistubs (make sequential=yes) can be used for them, see -exe1.
+ * The launcher is taken from the MPIRUN environment variable (default
+ * "mpirun -np").  The results are printed as a table and written to a CSV
+ * file (default scaling.csv).
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_util.h"
+
+#define SCALING_MAXNP 64
+
+static const char *phase_names[] =
+   {"relax", "restrict", "interp", "coarse", "access", "anderson"};
+#define SCALING_NPHASES 6
+
+/*--------------------------------------------------------------------------
+ * Replace each {N} in *command* by *n*
+ *--------------------------------------------------------------------------*/
+
+static void
+scaling_Substitute(const char *command, int n, char *result)
+{
+   const char *pos;
+
+   result[0] = '\0';
+   while ((pos = strstr(command, "{N}")) != NULL)
+   {
+      strncat(result, command, pos - command);
+      sprintf(result + strlen(result), "%d", n);
+      command = pos + 3;
+   }
+   strcat(result, command);
+}
+
+/*--------------------------------------------------------------------------
+ * Run *command* repeats times and return the run with the median braid time
+ * (or wall time, if there is no record) in *median*.  The other records are
+ * freed.
+ *--------------------------------------------------------------------------*/
+
+static void
+scaling_RunMedian(const char *launcher,
+                  int         nprocs,
+                  const char *command,
+                  const char *recpath,
+                  int         repeats,
+                  bench_Run  *median)
+{
+   bench_Run  *runs = (bench_Run *) malloc(repeats * sizeof(bench_Run));
+   double     *t    = (double *) malloc(repeats * sizeof(double));
+   double      tmin, tmed, mean, stddev;
+   int         irun, imed;
+
+   for (irun = 0; irun < repeats; irun++)
+   {
+      bench_RunOne(launcher, nprocs, command, recpath, "scaling.log", &runs[irun]);
+      t[irun] = (runs[irun].record != NULL) ? runs[irun].time : runs[irun].wall;
+   }
+   bench_Stats(t, repeats, &tmin, &tmed, &mean, &stddev);
+
+   /* The run closest to the median (the median itself for odd repeats) */
+   imed = 0;
+   for (irun = 0; irun < repeats; irun++)
+   {
+      double ti = (runs[irun].record != NULL) ? runs[irun].time : runs[irun].wall;
+      double tm = (runs[imed].record != NULL) ? runs[imed].time : runs[imed].wall;
+      if ( (ti-tmed)*(ti-tmed) < (tm-tmed)*(tm-tmed) )
+      {
+         imed = irun;
+      }
+   }
+   *median = runs[imed];
+   for (irun = 0; irun < repeats; irun++)
+   {
+      if (irun != imed)
+      {
+         free(runs[irun].record);
+      }
+   }
+   free(runs);
+   free(t);
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+int
+main(int argc, char *argv[])
+{
+   const char  *launcher = getenv("MPIRUN");
+   const char  *seqcmd   = NULL;
+   const char  *exe1     = NULL;
+   const char  *output   = "scaling.csv";
+   char        *nplist   = "1,2,4,8";
+   int          repeats  = 3;
+   int          weak     = 0;
+   int          launch1  = 0;
+
+   char         command[BENCH_MAXLINE], cmd[BENCH_MAXLINE], ref[BENCH_MAXLINE+16];
+   char         args[BENCH_MAXLINE];
+   char         lastref[BENCH_MAXLINE+16], recpath[BENCH_MAXLINE];
+   int          np[SCALING_MAXNP];
+   bench_Run    runs[SCALING_MAXNP], seqruns[SCALING_MAXNP];
+   double       tpar[SCALING_MAXNP], tseq[SCALING_MAXNP];
+   double       value, speedup, efficiency, phases[SCALING_NPHASES];
+   double       messages, bytes;
+   char        *tok;
+   int          arg_index, nnp, i, p, crossover, wallbasis;
+   FILE        *fp;
+
+   if (launcher == NULL || launcher[0] == '\0')
+   {
+      launcher = "mpirun -np";
+   }
+
+   arg_index = 1;
+   while (arg_index < argc && argv[arg_index][0] == '-')
+   {
+      if ( strcmp(argv[arg_index], "-help") == 0 )
+      {
+         printf("\n");
+         printf("  scaling [options] command [arguments]\n");
+         printf("\n");
+         printf("  -np <list>     : comma separated processor counts (default 1,2,4,8)\n");
+         printf("  -r <repeats>   : runs per count, the median is reported (default 3)\n");
+         printf("  -weak <n>      : weak scaling, {N} in the command is replaced by n*P\n");
+         printf("  -seq <cmd>     : sequential reference (default: the command with -ml 1)\n");
+         printf("  -exe1 <cmd>    : command for one processor, e.g. built with mpistubs\n");
+         printf("  -launch1       : run one processor through the launcher as well\n");
+         printf("  -o <file>      : CSV output file (default scaling.csv)\n");
+         printf("\n");
+         printf("  The launcher is $MPIRUN (default \"mpirun -np\")\n");
+         printf("\n");
+         exit(0);
+      }
+      else if ( strcmp(argv[arg_index], "-np") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         nplist = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-r") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         repeats = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-weak") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         weak = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-seq") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         seqcmd = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-exe1") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         exe1 = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-launch1") == 0 )
+      {
+         arg_index++;
+         launch1 = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-o") == 0 && arg_index+1 < argc )
+      {
+         arg_index++;
+         output = argv[arg_index++];
+      }
+      else
+      {
+         printf("ABORTING: incorrect command line parameter %s\n", argv[arg_index]);
+         exit(1);
+      }
+   }
+   if (arg_index >= argc)
+   {
+      printf("ABORTING: no command given (see scaling -help)\n");
+      exit(1);
+   }
+   if (repeats < 1)
+   {
+      repeats = 1;
+   }
+
+   /* The command is the rest of the line */
+   command[0] = '\0';
+   for ( ; arg_index < argc; arg_index++)
+   {
+      if (strlen(command) + strlen(argv[arg_index]) + 2 >= BENCH_MAXLINE)
+      {
+         printf("ABORTING: command too long\n");
+         exit(1);
+      }
+      strcat(command, argv[arg_index]);
+      strcat(command, (arg_index < argc-1) ? " " : "");
+   }
+
+   nnp = 0;
+   for (tok = strtok(nplist, ","); tok != NULL && nnp < SCALING_MAXNP; tok = strtok(NULL, ","))
+   {
+      if (atoi(tok) > 0)
+      {
+         np[nnp++] = atoi(tok);
+      }
+   }
+   if (nnp == 0)
+   {
+      printf("ABORTING: no processor counts\n");
+      exit(1);
+   }
+
+   bench_SetRecordFile("scaling.record", recpath);
+
+   /* Parallel runs, and the sequential reference for each problem size */
+   wallbasis  = 0;
+   lastref[0] = '\0';
+   for (i = 0; i < nnp; i++)
+   {
+      scaling_Substitute(command, weak*np[i], cmd);
+      if (seqcmd != NULL)
+      {
+         scaling_Substitute(seqcmd, weak*np[i], ref);
+      }
+      else
+      {
+         sprintf(ref, "%s -ml 1", cmd);
+      }
+
+      printf("np %d: %s\n", np[i], cmd);
+      if (np[i] == 1 && !launch1)
+      {
+         if (exe1 != NULL)
+         {
+            /* Same arguments, other executable */
+            strcpy(args, (strchr(cmd, ' ') != NULL) ? strchr(cmd, ' ') : "");
+            sprintf(cmd, "%s%s", exe1, args);
+         }
+         scaling_RunMedian(NULL, 1, cmd, recpath, repeats, &runs[i]);
+      }
+      else
+      {
+         scaling_RunMedian(launcher, np[i], cmd, recpath, repeats, &runs[i]);
+      }
+
+      if (strcmp(ref, lastref) != 0)
+      {
+         printf("sequential: %s\n", ref);
+         scaling_RunMedian(NULL, 1, ref, recpath, repeats, &seqruns[i]);
+         strcpy(lastref, ref);
+      }
+      else
+      {
+         seqruns[i] = seqruns[i-1];
+         seqruns[i].record = (seqruns[i-1].record != NULL) ?
+            bench_StrCopy(seqruns[i-1].record) : NULL;
+      }
+      if (runs[i].record == NULL || seqruns[i].record == NULL)
+      {
+         wallbasis = 1;
+      }
+   }
+
+   /* Compare braid times if all runs have records, wall times otherwise */
+   for (i = 0; i < nnp; i++)
+   {
+      tpar[i] = wallbasis ? runs[i].wall    : runs[i].time;
+      tseq[i] = wallbasis ? seqruns[i].wall : seqruns[i].time;
+   }
+
+   fp = fopen(output, "w");
+   if (fp == NULL)
+   {
+      printf("ABORTING: cannot open output file %s\n", output);
+      exit(1);
+   }
+   fprintf(fp, "nprocs,ntime,niter,converged,time,wall,speedup,efficiency,seq_time,vs_seq,"
+           "messages,bytes");
+   for (p = 0; p < SCALING_NPHASES; p++)
+   {
+      fprintf(fp, ",%s", phase_names[p]);
+   }
+   fprintf(fp, "\n");
+
+   printf("\n%s scaling, %s times\n\n", weak ? "Weak" : "Strong", wallbasis ? "process wall" : "braid");
+   printf("%6s %8s %5s %4s %11s %8s %6s %11s %7s %10s %12s %10s %10s %10s %10s\n",
+          "nprocs", "ntime", "iter", "conv", "time", "speedup", "eff", "seq time",
+          "vs seq", "messages", "bytes", "relax", "restrict", "interp", "coarse");
+
+   crossover = 0;
+   for (i = 0; i < nnp; i++)
+   {
+      const char *rec = (runs[i].record != NULL) ? runs[i].record : "";
+
+      if (weak)
+      {
+         efficiency = tpar[0] / tpar[i];
+         speedup    = efficiency * np[i] / np[0];
+      }
+      else
+      {
+         speedup    = tpar[0] / tpar[i];
+         efficiency = speedup * np[0] / np[i];
+      }
+      if (!crossover && tpar[i] < tseq[i])
+      {
+         crossover = np[i];
+      }
+
+      value = 0.0;
+      bench_RecordValue(rec, "ntime", &value);
+      bench_RecordSum(rec, "messages", &messages);
+      bench_RecordSum(rec, "bytes", &bytes);
+      for (p = 0; p < SCALING_NPHASES; p++)
+      {
+         bench_RecordSum(rec, phase_names[p], &phases[p]);
+      }
+
+      printf("%6d %8d %5d %4d %11.4e %8.3f %6.3f %11.4e %7.3f %10.0f %12.0f %10.3e %10.3e %10.3e %10.3e\n",
+             np[i], (int) value, runs[i].niter, runs[i].converged, tpar[i], speedup,
+             efficiency, tseq[i], tseq[i] / tpar[i], messages, bytes,
+             phases[0], phases[1], phases[2], phases[3]);
+      fprintf(fp, "%d,%d,%d,%d,%1.6e,%1.6e,%1.6e,%1.6e,%1.6e,%1.6e,%.0f,%.0f",
+              np[i], (int) value, runs[i].niter, runs[i].converged, runs[i].time,
+              runs[i].wall, speedup, efficiency, tseq[i], tseq[i] / tpar[i],
+              messages, bytes);
+      for (p = 0; p < SCALING_NPHASES; p++)
+      {
+         fprintf(fp, ",%1.6e", phases[p]);
+      }
+      fprintf(fp, "\n");
+   }
+   fclose(fp);
+
+   printf("\n");
+   if (crossover)
+   {
+      printf("MGRIT beats sequential time stepping from %d processors\n", crossover);
+   }
+   else
+   {
+      printf("MGRIT does not beat sequential time stepping up to %d processors\n", np[nnp-1]);
+   }
+   printf("Wrote %s\n", output);
+
+   for (i = 0; i < nnp; i++)
+   {
+      free(runs[i].record);
+      free(seqruns[i].record);
+   }
+   remove(recpath);
+
+   return 0;
+}
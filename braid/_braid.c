@@ -32,8 +32,10 @@
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
-braid_Int _braid_error_flag = 0;
-FILE    *_braid_printfile  = NULL;
+_braid_ThreadLocal braid_Int _braid_error_flag = 0;
+_braid_ThreadLocal braid_Real _braid_alloc_bytes = 0.0;
+_braid_ThreadLocal braid_Real _braid_alloc_count = 0.0;
+_braid_ThreadLocal FILE    *_braid_printfile  = NULL;
 
 braid_Int 
 _braid_VectorBarCopy(braid_VectorBar bar, braid_VectorBar *bar_ptr)
@@ -593,6 +595,131 @@ _braid_ChunkFeatureCheck(braid_Core core)
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_PrecFeatureCheck(braid_Core core)
+{
+   braid_Int  adjoint  = _braid_CoreElt(core, adjoint );
+   braid_Int  trimgrit = _braid_CoreElt(core, trimgrit);
+   braid_Int  useshell = _braid_CoreElt(core, useshell);
+   braid_Int  refine   = _braid_CoreElt(core, refine  );
+   braid_Int  residual = (_braid_CoreElt(core, residual) != NULL);
+
+   if ( adjoint || trimgrit || useshell || refine || residual )
+   {
+      _braid_printf("\nCoarse-level precision not supported with adjoint, TriMGRIT, shell vectors,"
+                    " time refinement or a user residual!\n");
+      exit(1);
+   }
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaFeatureCheck(braid_Core core)
+{
+   braid_Int  adjoint  = _braid_CoreElt(core, adjoint );
+   braid_Int  trimgrit = _braid_CoreElt(core, trimgrit);
+   braid_Int  useshell = _braid_CoreElt(core, useshell);
+   braid_Int  scoarsen = (_braid_CoreElt(core, scoarsen) != NULL);
+   braid_Int  residual = (_braid_CoreElt(core, residual) != NULL);
+   braid_Int  lowprec  = (_braid_CoreElt(core, prec_level) > 0);
+
+   if ( adjoint || trimgrit || useshell || scoarsen || residual || lowprec )
+   {
+      _braid_printf("\nDelta correction not supported with adjoint, TriMGRIT, shell vectors,"
+                    " spatial coarsening, a user residual or coarse-level precision!\n");
+      exit(1);
+   }
+   if (_braid_CoreElt(core, innerprod) == NULL)
+   {
+      _braid_printf("\nDelta correction needs an inner product!\n");
+      exit(1);
+   }
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_AndersonFeatureCheck(braid_Core core)
+{
+   braid_Int  adjoint  = _braid_CoreElt(core, adjoint );
+   braid_Int  useshell = _braid_CoreElt(core, useshell);
+   braid_Int  refine   = _braid_CoreElt(core, refine  );
+   braid_Int  nchunks  = _braid_CoreElt(core, nchunks );
+
+   if ( adjoint || useshell || refine || (nchunks > 1) )
+   {
+      _braid_printf("\nAnderson acceleration not supported with adjoint, shell vectors,"
+                    " time refinement or time chunks!\n");
+      exit(1);
+   }
+   if (_braid_CoreElt(core, innerprod) == NULL)
+   {
+      _braid_printf("\nAnderson acceleration needs an inner product!\n");
+      exit(1);
+   }
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_AsyncFeatureCheck(braid_Core core)
+{
+   braid_Int  adjoint  = _braid_CoreElt(core, adjoint );
+   braid_Int  trimgrit = _braid_CoreElt(core, trimgrit);
+   braid_Int  useshell = _braid_CoreElt(core, useshell);
+   braid_Int  lowprec  = (_braid_CoreElt(core, prec_level) > 0);
+   braid_Int  delta    = (_braid_CoreElt(core, delta_rank) > 0);
+
+   if ( adjoint || trimgrit || useshell || lowprec || delta )
+   {
+      _braid_printf("\nAsynchronous steps not supported with adjoint, TriMGRIT, shell vectors,"
+                    " coarse-level precision or the Delta correction!\n");
+      exit(1);
+   }
+   if (_braid_CoreElt(core, step_finish) == NULL)
+   {
+      _braid_printf("\nAsynchronous steps need a finish routine!\n");
+      exit(1);
+   }
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CompressFeatureCheck(braid_Core core)
+{
+   braid_Int  adjoint  = _braid_CoreElt(core, adjoint );
+   braid_Int  trimgrit = _braid_CoreElt(core, trimgrit);
+   braid_Int  useshell = _braid_CoreElt(core, useshell);
+   braid_Int  anderson = (_braid_CoreElt(core, anderson_dim) > 0);
+
+   if ( adjoint || trimgrit || useshell || anderson )
+   {
+      _braid_printf("\nCompressed storage not supported with adjoint, TriMGRIT, shell vectors"
+                    " or Anderson acceleration!\n");
+      exit(1);
+   }
+   if ( (_braid_CoreElt(core, storage) != 0) && (_braid_CoreElt(core, memory_budget) == 0.0) )
+   {
+      _braid_printf("\nCompressed storage needs F-points stored on all levels (storage 0)"
+                    " or a memory budget!\n");
+      exit(1);
+   }
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * ZTODO: Should we use the error handling facility here and above?
  *----------------------------------------------------------------------------*/
@@ -644,6 +771,43 @@ _braid_FeatureCheck(braid_Core core)
    {
       _braid_TriMGRITFeatureCheck(core);
    }  
+   if (_braid_CoreElt(core, prec_level) > 0)
+   {
+      _braid_PrecFeatureCheck(core);
+   }
+   if (_braid_CoreElt(core, delta_rank) > 0)
+   {
+      _braid_DeltaFeatureCheck(core);
+   }
+   if (_braid_CoreElt(core, step_begin) != NULL)
+   {
+      _braid_AsyncFeatureCheck(core);
+   }
+   if (_braid_CoreElt(core, anderson_dim) > 0)
+   {
+      _braid_AndersonFeatureCheck(core);
+   }
+   if (_braid_CoreElt(core, compress_storage) > 0)
+   {
+      _braid_CompressFeatureCheck(core);
+   }
+   if ( (_braid_CoreElt(core, trilinearize) != NULL) && !trimgrit )
+   {
+      _braid_printf("\nNewton linearizations (braid_SetTriNewton) need TriMGRIT!\n");
+      exit(1);
+   }
+   if ( _braid_CoreElt(core, tridirect) && !trimgrit )
+   {
+      _braid_printf("\nThe direct solve (braid_SetTriDirect) needs TriMGRIT!\n");
+      exit(1);
+   }
+   if ( (_braid_CoreElt(core, reuse) == 2) &&
+        (adjoint || trimgrit || _braid_CoreElt(core, refine) || (nchunks > 1)) )
+   {
+      _braid_printf("\nKeeping the FAS right-hand sides (braid_SetReuseSolution) is not"
+                    " supported with adjoint, TriMGRIT, time refinement or time chunks!\n");
+      exit(1);
+   }
 
    return _braid_error_flag;
 }
@@ -698,6 +862,165 @@ _braid_GetInterval(braid_Core   core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Map the level 0 frozen index to 'level'.  A point i on level l+1 is the point
+ * i*m on level l, so it is frozen if i*m <= frozen, that is, i <= frozen/m.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_GetFrozenIndex(braid_Core   core,
+                      braid_Int    level,
+                      braid_Int   *frozen_ptr)
+{
+   _braid_Grid  **grids  = _braid_CoreElt(core, grids);
+   braid_Int      frozen = _braid_CoreElt(core, frozen_index);
+   braid_Int      l, cfactor;
+
+   for (l = 0; (l < level) && (frozen > 0); l++)
+   {
+      cfactor = _braid_GridElt(grids[l], cfactor);
+      frozen  = frozen / cfactor;
+   }
+   *frozen_ptr = frozen;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Grow the frozen region by the longest run of C-points after it whose
+ * combined residual norm, with that of the frozen region, stays below
+ * frozen_tol*tol.  The C-point residuals in the run are then added to
+ * frozen_rnorm (and the full residuals to frozen_full_rnorm), and removed from
+ * tnorm_a.  They do not change any more, since the cycle skips frozen points.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_UpdateFrozenIndex(braid_Core  core)
+{
+   MPI_Comm       comm         = _braid_CoreElt(core, comm);
+   braid_Real     frozen_tol   = _braid_CoreElt(core, frozen_tol);
+   braid_Real     tol          = _braid_CoreElt(core, tol);
+   braid_Int      rtol         = _braid_CoreElt(core, rtol);
+   braid_Int      tnorm        = _braid_CoreElt(core, tnorm);
+   braid_Real     rnorm0       = _braid_CoreElt(core, rnorm0);
+   braid_Real    *tnorm_a      = _braid_CoreElt(core, tnorm_a);
+   braid_Real    *full_tnorm_a = _braid_CoreElt(core, full_tnorm_a);
+   braid_Int      frozen       = _braid_CoreElt(core, frozen_index);
+   braid_Int      gupper       = _braid_CoreElt(core, gupper);
+   _braid_Grid  **grids        = _braid_CoreElt(core, grids);
+   braid_Int      ncpoints     = _braid_GridElt(grids[0], ncpoints);
+   braid_Int      cfactor      = _braid_GridElt(grids[0], cfactor);
+
+   braid_Real     thresh, rnorm, rnorm_temp, before, norms[2], gnorms[2];
+   braid_Int      interval, flo, fhi, ci, first, gfirst, myid;
+
+   if ( (frozen_tol <= 0.0) || _braid_CoreElt(core, refine) || _braid_CoreElt(core, adjoint) ||
+        (_braid_CoreElt(core, anderson_dim) > 0) )
+   {
+      return _braid_error_flag;
+   }
+
+   /* Scale tol the same way as the halting check does */
+   if (rtol)
+   {
+      if (rnorm0 == braid_INVALID_RNORM)
+      {
+         return _braid_error_flag;
+      }
+      tol *= rnorm0;
+   }
+   thresh = frozen_tol*tol;
+   if ( (tnorm != 1) && (tnorm != 3) )
+   {
+      thresh = thresh*thresh;
+   }
+
+   /* The combined residual norm of the processors before me, in time order */
+   MPI_Comm_rank(comm, &myid);
+   rnorm = 0.0;
+   for (interval = 0; interval < ncpoints; interval++)
+   {
+      _braid_GetInterval(core, 0, interval, &flo, &fhi, &ci);
+      if (ci > frozen)
+      {
+         rnorm_temp = tnorm_a[interval];
+         if ( (tnorm != 1) && (tnorm != 3) )
+         {
+            rnorm_temp = rnorm_temp*rnorm_temp;
+         }
+         rnorm = _braid_TNormAdd(tnorm, rnorm, rnorm_temp);
+      }
+   }
+   /* Exclusive prefix, left undefined on the first processor */
+   before = 0.0;
+   MPI_Exscan(&rnorm, &before, 1, braid_MPI_REAL, (tnorm == 3) ? MPI_MAX : MPI_SUM, comm);
+   if (myid == 0)
+   {
+      before = 0.0;
+   }
+   rnorm = _braid_TNormAdd(tnorm, _braid_CoreElt(core, frozen_rnorm), before);
+
+   /* Find the first C-point where the combined norm reaches the threshold */
+   first = gupper+1;
+   for (interval = 0; interval < ncpoints; interval++)
+   {
+      _braid_GetInterval(core, 0, interval, &flo, &fhi, &ci);
+      if (ci > frozen)
+      {
+         rnorm_temp = tnorm_a[interval];
+         if ( (tnorm != 1) && (tnorm != 3) )
+         {
+            rnorm_temp = rnorm_temp*rnorm_temp;
+         }
+         rnorm = _braid_TNormAdd(tnorm, rnorm, rnorm_temp);
+         if ( !(rnorm < thresh) )
+         {
+            first = ci;
+            break;
+         }
+      }
+   }
+   MPI_Allreduce(&first, &gfirst, 1, braid_MPI_INT, MPI_MIN, comm);
+   if (gfirst > gupper)
+   {
+      gfirst = (gupper/cfactor)*cfactor + cfactor;
+   }
+   if (gfirst-cfactor <= frozen)
+   {
+      return _braid_error_flag;
+   }
+
+   /* Move the newly frozen residuals from tnorm_a into frozen_rnorm */
+   norms[0] = norms[1] = 0.0;
+   for (interval = 0; interval < ncpoints; interval++)
+   {
+      _braid_GetInterval(core, 0, interval, &flo, &fhi, &ci);
+      if ( (ci > frozen) && (ci < gfirst) )
+      {
+         rnorm_temp = tnorm_a[interval];
+         if ( (tnorm != 1) && (tnorm != 3) )
+         {
+            rnorm_temp = rnorm_temp*rnorm_temp;
+         }
+         norms[0] = _braid_TNormAdd(tnorm, norms[0], rnorm_temp);
+         tnorm_a[interval] = 0.0;
+         if (full_tnorm_a != NULL)
+         {
+            norms[1] = _braid_TNormAdd(tnorm, norms[1], full_tnorm_a[interval]);
+         }
+      }
+   }
+   MPI_Allreduce(norms, gnorms, 2, braid_MPI_REAL, (tnorm == 3) ? MPI_MAX : MPI_SUM, comm);
+   _braid_CoreElt(core, frozen_rnorm) =
+      _braid_TNormAdd(tnorm, _braid_CoreElt(core, frozen_rnorm), gnorms[0]);
+   _braid_CoreElt(core, frozen_full_rnorm) =
+      _braid_TNormAdd(tnorm, _braid_CoreElt(core, frozen_full_rnorm), gnorms[1]);
+
+   _braid_CoreElt(core, frozen_index) = gfirst-cfactor;
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -836,6 +1159,130 @@ _braid_InitGuess(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Prepare the grids for a warm restart
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_WarmRestart(braid_Core  core)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   braid_Int          reuse    = _braid_CoreElt(core, reuse);
+   braid_Int          nlevels  = _braid_CoreElt(core, nlevels);
+   braid_Int          adjoint  = _braid_CoreElt(core, adjoint);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_Int          ilower   = _braid_GridElt(grids[0], ilower);
+   braid_Int          iupper   = _braid_GridElt(grids[0], iupper);
+   braid_Real        *ta       = _braid_GridElt(grids[0], ta);
+
+   braid_BaseVector   u, *fa, *tau;
+   braid_Vector       v, *adjoints;
+   braid_Int          level, i, ii, iu, sflag, npoints;
+
+   /* With time chunks, the grids hold the last chunk */
+   if (_braid_CoreElt(core, nchunks) > 1)
+   {
+      return _braid_error_flag;
+   }
+
+   if (reuse == 2)
+   {
+      /* Move the kept FAS right-hand sides back, the first cycle skips the
+       * down cycle and starts on the coarsest level */
+      for (level = 1; level < nlevels; level++)
+      {
+         fa  = _braid_GridElt(grids[level], fa);
+         tau = _braid_GridElt(grids[level], tau);
+         if (tau != NULL)
+         {
+            npoints = _braid_GridElt(grids[level], iupper) - _braid_GridElt(grids[level], ilower) + 1;
+            for (ii = 0; ii < npoints; ii++)
+            {
+               if (fa[ii] != NULL)
+               {
+                  _braid_BaseFree(core, app, fa[ii]);
+               }
+               fa[ii]  = tau[ii];
+               tau[ii] = NULL;
+            }
+         }
+      }
+      _braid_CoreElt(core, reuse_tau) = (nlevels > 1);
+
+      return _braid_error_flag;
+   }
+
+   /* Replace the user's vectors only, so adjoint bar vectors stay valid */
+   for (i = ilower; i <= iupper; i++)
+   {
+      _braid_UGetIndex(core, 0, i, &iu, &sflag);
+      if (sflag == 0)
+      {
+         _braid_UGetVectorRef(core, 0, i, &u);
+         _braid_CoreFcn(core, init)(app, ta[i-ilower], &v);
+         _braid_CoreFcn(core, free)(app, u->userVector);
+         u->userVector = v;
+      }
+   }
+
+   for (level = 1; level < nlevels; level++)
+   {
+      _braid_GridClean(core, grids[level]);
+   }
+   _braid_CoreElt(core, rnorm0) = braid_INVALID_RNORM;
+
+   if (adjoint)
+   {
+      adjoints = _braid_CoreElt(core, optim)->adjoints;
+      for (i = ilower; i <= iupper; i++)
+      {
+         _braid_UGetIndex(core, 0, i, &iu, &sflag);
+         if ( (iu > -1) && (adjoints[iu] != NULL) )
+         {
+            _braid_CoreFcn(core, sum)(app, -1.0, adjoints[iu], 1.0, adjoints[iu]);
+         }
+      }
+      _braid_CoreElt(core, optim)->rnorm0_adj = braid_INVALID_RNORM;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Keep the FAS right-hand sides of a coarse level for a warm restart
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_KeepTau(braid_Core  core,
+               braid_Int   level)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_Int          npoints  = _braid_GridElt(grids[level], iupper) - _braid_GridElt(grids[level], ilower) + 1;
+   braid_BaseVector  *fa       = _braid_GridElt(grids[level], fa);
+   braid_BaseVector  *tau      = _braid_GridElt(grids[level], tau);
+   braid_Int          ii;
+
+   if (tau == NULL)
+   {
+      tau = _braid_CTAlloc(braid_BaseVector, _braid_max(npoints, 1));
+      _braid_GridElt(grids[level], tau) = tau;
+   }
+
+   /* Move the vectors, so the grid clean does not free them */
+   for (ii = 0; ii < npoints; ii++)
+   {
+      if (tau[ii] != NULL)
+      {
+         _braid_BaseFree(core, app, tau[ii]);
+      }
+      tau[ii] = fa[ii];
+      fa[ii]  = NULL;
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * Copy the initialized C-points on the fine grid, to all coarse levels.
  * Allows first down cycle to be skipped, in FMG fashion.
@@ -914,6 +1361,31 @@ _braid_ErrorHandler(const char *filename,
 #endif
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+size_t
+_braid_CountAlloc(size_t nbytes)
+{
+   _braid_alloc_bytes += (braid_Real) nbytes;
+   _braid_alloc_count += 1.0;
+
+   return nbytes;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+size_t
+_braid_CountCAlloc(size_t count,
+                   size_t size)
+{
+   _braid_alloc_bytes += (braid_Real) count * (braid_Real) size;
+   _braid_alloc_count += 1.0;
+
+   return count;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -1005,3 +1477,125 @@ _braid_ChunkSetInitialCondition(braid_Core core)
 
    return _braid_error_flag;
 }
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_WriteBenchRecord(braid_Core   core,
+                        const char  *filename)
+{
+   MPI_Comm             comm_world  = _braid_CoreElt(core, comm_world);
+   braid_Int            myid        = _braid_CoreElt(core, myid_world);
+   braid_Int            max_levels  = _braid_CoreElt(core, max_levels);
+   braid_Int            nlevels     = _braid_CoreElt(core, nlevels);
+   braid_Int            rtol        = _braid_CoreElt(core, rtol);
+   braid_Real           tol         = _braid_CoreElt(core, tol);
+   braid_PtFcnResidual  fullres     = _braid_CoreElt(core, full_rnorm_res);
+   braid_Real          *phase_times = _braid_CoreElt(core, phase_times);
+   braid_Real          *comm_volume = _braid_CoreElt(core, comm_volume);
+   braid_Real          *ncalls      = _braid_CoreElt(core, ncalls);
+   braid_Int            nvectors    = _braid_CoreElt(core, nvectors_peak);
+   _braid_Grid        **grids       = _braid_CoreElt(core, grids);
+
+   static const char *phase_names[_braid_NPHASES] =
+      {"relax", "restrict", "interp", "coarse", "access", "anderson"};
+   static const char *call_names[_braid_NCALLS] =
+      {"step", "init", "clone", "free", "sum", "spatialnorm", "access", "bufpack",
+       "bufunpack", "triresidual", "trisolve"};
+
+   braid_Real   *gtimes, *gvolume;
+   braid_Real    counts[_braid_NCALLS+2], gcounts[_braid_NCALLS+2];
+   braid_Real    rnorm;
+   braid_Int     nprocs, converged, level, p, gnvectors;
+   FILE         *fp;
+
+   /* User calls, then the bytes and number of allocations since the start of
+    * braid_Drive() (before the allocations below) */
+   for (p = 0; p < _braid_NCALLS; p++)
+   {
+      counts[p] = ncalls[p];
+   }
+   counts[_braid_NCALLS]   = _braid_alloc_bytes - _braid_CoreElt(core, alloc_bytes0);
+   counts[_braid_NCALLS+1] = _braid_alloc_count - _braid_CoreElt(core, alloc_count0);
+   MPI_Allreduce(counts, gcounts, _braid_NCALLS+2, braid_MPI_REAL, MPI_SUM, comm_world);
+   MPI_Allreduce(&nvectors, &gnvectors, 1, braid_MPI_INT, MPI_MAX, comm_world);
+
+   gtimes = _braid_CTAlloc(braid_Real, max_levels*_braid_NPHASES);
+   MPI_Allreduce(phase_times, gtimes, max_levels*_braid_NPHASES, braid_MPI_REAL,
+                 MPI_MAX, comm_world);
+   gvolume = _braid_CTAlloc(braid_Real, max_levels*2);
+   MPI_Allreduce(comm_volume, gvolume, max_levels*2, braid_MPI_REAL, MPI_SUM,
+                 comm_world);
+   MPI_Comm_size(comm_world, &nprocs);
+
+   if (myid == 0)
+   {
+      /* Converged if the final residual meets the (possibly relative) tolerance */
+      _braid_GetRNorm(core, -1, &rnorm);
+      if (rtol)
+      {
+         tol *= (fullres != NULL) ? _braid_CoreElt(core, full_rnorm0) :
+                                    _braid_CoreElt(core, rnorm0);
+      }
+      converged = (rnorm <= tol);
+
+      fp = fopen(filename, "a");
+      if (fp == NULL)
+      {
+         _braid_printf("  Braid: Warning, could not open benchmark file %s\n", filename);
+      }
+      else
+      {
+         fprintf(fp, "{\"ntime\": %d, \"nprocs\": %d, \"nlevels\": %d, \"cfactor\": %d,"
+                 " \"trimgrit\": %d, \"niter\": %d,",
+                 _braid_CoreElt(core, ntime), nprocs, nlevels,
+                 (nlevels > 1) ? _braid_GridElt(grids[0], cfactor) : 1,
+                 _braid_CoreElt(core, trimgrit), _braid_CoreElt(core, niter));
+         if (_braid_isnan(rnorm - rnorm))
+         {
+            /* JSON has no NaN or Inf (rnorm - rnorm is NaN for both) */
+            fprintf(fp, " \"rnorm\": null,");
+         }
+         else
+         {
+            fprintf(fp, " \"rnorm\": %1.6e,", rnorm);
+         }
+         fprintf(fp, " \"tol\": %1.6e, \"converged\": %d, \"time\": %1.6e, \"phases\": {",
+                 tol, converged, _braid_CoreElt(core, globaltime));
+         for (p = 0; p < _braid_NPHASES; p++)
+         {
+            fprintf(fp, "%s\"%s\": [", (p > 0) ? ", " : "", phase_names[p]);
+            for (level = 0; level < nlevels; level++)
+            {
+               fprintf(fp, "%s%1.6e", (level > 0) ? ", " : "",
+                       gtimes[level*_braid_NPHASES + p]);
+            }
+            fprintf(fp, "]");
+         }
+         fprintf(fp, "}, \"messages\": [");
+         for (level = 0; level < nlevels; level++)
+         {
+            fprintf(fp, "%s%.0f", (level > 0) ? ", " : "", gvolume[2*level]);
+         }
+         fprintf(fp, "], \"bytes\": [");
+         for (level = 0; level < nlevels; level++)
+         {
+            fprintf(fp, "%s%.0f", (level > 0) ? ", " : "", gvolume[2*level+1]);
+         }
+         fprintf(fp, "], \"calls\": {");
+         for (p = 0; p < _braid_NCALLS; p++)
+         {
+            fprintf(fp, "%s\"%s\": %.0f", (p > 0) ? ", " : "", call_names[p], gcounts[p]);
+         }
+         fprintf(fp, "}, \"vectors_peak\": %d, \"alloc_bytes\": %.0f, \"alloc_count\": %.0f}\n",
+                 gnvectors, gcounts[_braid_NCALLS], gcounts[_braid_NCALLS+1]);
+         fclose(fp);
+      }
+   }
+
+   _braid_TFree(gtimes);
+   _braid_TFree(gvolume);
+
+   return _braid_error_flag;
+}
@@ -42,6 +42,16 @@
 extern "C" {
 #endif
 
+/**
+ * Global variables are private to each rank when the ranks are threads
+ * (braid_THREADS, see mpistubs.h)
+ **/
+#ifdef braid_THREADS
+#define _braid_ThreadLocal __thread
+#else
+#define _braid_ThreadLocal
+#endif
+
 /*--------------------------------------------------------------------------
  * Error handling
  *--------------------------------------------------------------------------*/
@@ -50,7 +60,7 @@ extern "C" {
  * This is the global XBraid error flag.  If it is ever nonzero, an error has 
  * occurred. 
  **/
-extern braid_Int _braid_error_flag;
+extern _braid_ThreadLocal braid_Int _braid_error_flag;
 
 void _braid_ErrorHandler(const char *filename, braid_Int line, braid_Int ierr, const char *msg);
 #define _braid_Error(IERR, msg)       _braid_ErrorHandler(__FILE__, __LINE__, IERR, msg)
@@ -60,23 +70,42 @@ void _braid_ErrorHandler(const char *filename, braid_Int line, braid_Int ierr, c
  * Memory allocation macros
  *--------------------------------------------------------------------------*/
 
+/**
+ * Bytes and number of allocations requested through the allocation macros
+ * below on this process (a re-allocation counts its new size).  These are
+ * reported in the benchmark record (see @ref _braid_WriteBenchRecord).
+ **/
+extern _braid_ThreadLocal braid_Real _braid_alloc_bytes;
+extern _braid_ThreadLocal braid_Real _braid_alloc_count;
+
+/**
+ * Add nbytes to the allocation counters and return it
+ **/
+size_t _braid_CountAlloc(size_t nbytes);
+
+/**
+ * Add count elements of size bytes to the allocation counters and return
+ * count, so that calloc() still checks the product for overflow
+ **/
+size_t _braid_CountCAlloc(size_t count, size_t size);
+
 /** 
  * Allocation macro 
  **/
 #define _braid_TAlloc(type, count) \
-( (type *)malloc((size_t)(sizeof(type) * (count))) )
+( (type *)malloc(_braid_CountAlloc((size_t)(sizeof(type) * (count)))) )
 
 /** 
  * Allocation macro 
  **/
 #define _braid_CTAlloc(type, count) \
-( (type *)calloc((size_t)(count), (size_t)sizeof(type)) )
+( (type *)calloc(_braid_CountCAlloc((size_t)(count), sizeof(type)), sizeof(type)) )
 
 /** 
  * Re-allocation macro 
  **/
 #define _braid_TReAlloc(ptr, type, count) \
-( (type *)realloc((char *)ptr, (size_t)(sizeof(type) * (count))) )
+( (type *)realloc((char *)ptr, _braid_CountAlloc((size_t)(sizeof(type) * (count)))) )
 
 /** 
  * Free memory macro 
@@ -94,6 +123,13 @@ void _braid_ErrorHandler(const char *filename, braid_Int line, braid_Int ierr, c
 #ifndef _braid_min
 #define _braid_min(a,b)  (((a)<(b)) ? (a) : (b))
 #endif
+
+/**
+ * Combine the residual norm contributions a and b for temporal norm tnorm
+ * (sum for the one-norm, max for the inf-norm, and sum of the squares for the
+ * two-norm)
+ **/
+#define _braid_TNormAdd(tnorm, a, b)  (((tnorm) == 3) ? _braid_max(a, b) : ((a) + (b)))
 #ifndef _braid_isnan
 #define _braid_isnan(a) (a != a)
 #endif
@@ -137,6 +173,7 @@ struct _braid_BaseVector_struct
 {
    braid_Vector    userVector;      /**< holds the users primal vector */
    braid_VectorBar bar;             /**< holds the bar vector (shared pointer implementation) */
+   braid_Int       lowprec;         /**< boolean, userVector is stored in the coarse-level (low) precision */
 };
 typedef struct _braid_BaseVector_struct *braid_BaseVector;
 
@@ -173,7 +210,7 @@ typedef struct _braid_Optimization_struct *braid_Optim;
  * Used for initiating and completing nonblocking communication to pass
  * braid_BaseVectors between processors.
  **/
-typedef struct
+typedef struct _braid_CommHandle_struct
 {
    braid_Int         request_type;    /**< two values: recv type = 1, and send type = 0 */
    braid_Int         num_requests;    /**< number of active requests for this handle, usually 1 */
@@ -181,9 +218,65 @@ typedef struct
    MPI_Status       *status;          /**< MPI status */
    void             *buffer;          /**< Buffer for message */
    braid_BaseVector *vector_ptr;      /**< braid vector being received */
+   braid_Int         level;           /**< level of the vector being received */
+   braid_BaseVector  vector;          /**< vector sent or received in place (see @ref braid_SetBufDescribe) */
+   MPI_Datatype      dtype;           /**< datatype describing vector, if sent or received in place */
+   braid_Int         shm;             /**< shared-memory message: 0 = no (MPI), 1 = pending, 2 = complete */
+   braid_Int         size;            /**< size of a shared-memory send in bytes */
+   braid_Int         shm_seq;         /**< number of a shared-memory message, counted per neighbor */
+   struct _braid_CommHandle_struct *shm_next; /**< next pending shared-memory message */
    
 } _braid_CommHandle;
 
+/**
+ * Direct solver data for an affine TriMGRIT level (see @ref braid_SetTriDirect).
+ * The blocks are probed at the current iterate (again in each new
+ * Newton-TriMGRIT linearization epoch).  The local rows are factored with
+ * block Thomas, and process 0 holds the factored reduced system that couples
+ * the first and last points of the processes.  Dense blocks are N x N (2N x 2N
+ * in the reduced system).
+ **/
+typedef struct
+{
+   braid_Int     nblock;     /**< block size N, the number of braid_Reals packed per vector */
+   braid_Int     npoints;    /**< number of local points */
+   braid_Int     left;       /**< process with the left interface point (-1 if none) */
+   braid_Int     right;      /**< process with the right interface point (-1 if none) */
+   braid_Int     lin_epoch;  /**< Newton-TriMGRIT linearization epoch the blocks were probed in */
+   braid_Real   *L;          /**< lower blocks */
+   braid_Real   *D;          /**< LU factors of the eliminated diagonal blocks */
+   braid_Real   *U;          /**< eliminated upper blocks */
+   braid_Int    *piv;        /**< pivots of D */
+   braid_Real   *ulast;      /**< upper block of the last point, coupling to the right process */
+   braid_Real   *b;          /**< rhs and solution of the local rows */
+   braid_Real   *z;          /**< interface values [u_first; u_last] of all processes */
+
+   braid_Int     nreduced;   /**< number of processes with points (process 0 only) */
+   braid_Int    *rprocs;     /**< these processes (process 0 only) */
+   braid_Real   *RL;         /**< reduced lower blocks (process 0 only) */
+   braid_Real   *RD;         /**< reduced LU factors (process 0 only) */
+   braid_Real   *RU;         /**< reduced upper blocks (process 0 only) */
+   braid_Int    *rpiv;       /**< reduced pivots (process 0 only) */
+
+} _braid_TriDirect;
+
+/**
+ * Anderson acceleration data (see @ref braid_SetAnderson). A space-time vector
+ * is an array of the local vectors stored on level 0, in the order of *index*.
+ **/
+typedef struct
+{
+   braid_Int           npoints;   /**< number of local vectors stored on level 0 */
+   braid_Int          *index;     /**< their time indices */
+   braid_Int           ncols;     /**< number of difference columns kept */
+   braid_BaseVector   *x;         /**< iterate at the start of the last cycle */
+   braid_BaseVector   *f;         /**< residual g(x) - x of the last cycle (NULL before the first) */
+   braid_BaseVector   *g;         /**< result g(x) of the last cycle (NULL before the first) */
+   braid_BaseVector  **dF;        /**< differences of f over the last cycles (anderson_dim columns) */
+   braid_BaseVector  **dG;        /**< differences of g over the last cycles (anderson_dim columns) */
+
+} _braid_Anderson;
+
 /**
  * XBraid Grid structure for a certain time level
  *
@@ -206,6 +299,8 @@ typedef struct
    braid_Real        *ta;            /**< time values                (all points) */
    braid_BaseVector  *va;            /**< restricted unknown vectors (all points, NULL on level 0) */
    braid_BaseVector  *fa;            /**< rhs vectors f              (all points, NULL on level 0) */
+   char             **uz;            /**< compressed F-point vectors (level 0 with braid_SetCompressStorage, else NULL) */
+   braid_Int          uz_index;      /**< index into ua of the decompressed F-point view, -1 if none */
 
    braid_Int          recv_index;    /**<  -1 means no receive */
    braid_Int          send_index;    /**<  -1 means no send */
@@ -217,6 +312,17 @@ typedef struct
    braid_BaseVector  *va_alloc;      /**< original memory allocation for va */
    braid_BaseVector  *fa_alloc;      /**< original memory allocation for fa */
 
+   braid_BaseVector  *delta_v;       /**< Delta correction bases V (rank per time step, NULL on level 0) */
+   braid_BaseVector  *delta_w;       /**< Delta correction differences W (rank per time step, NULL on level 0) */
+   braid_BaseVector  *tau;           /**< FAS right-hand sides kept for a warm restart (all points, only with reuse 2) */
+
+   void             **la;            /**< TriMGRIT linearizations (all points, only with Newton-TriMGRIT) */
+   braid_Int         *la_epoch;      /**< linearization epoch in which each point of la was built */
+   braid_Int          lin_epoch;     /**< current linearization epoch, 0 before the first */
+   braid_Int          lin_iter;      /**< iteration in which the current epoch started */
+
+   _braid_TriDirect  *tridirect;     /**< direct solver data (coarsest TriMGRIT level, with braid_SetTriDirect) */
+
    braid_BaseVector ulast;          /**< stores last time step */
 
 } _braid_Grid;
@@ -258,8 +364,27 @@ typedef struct _braid_Core_struct
    braid_PtFcnSCoarsen    scoarsen;         /**< (optional) return a spatially coarsened vector */
    braid_PtFcnSRefine     srefine;          /**< (optional) return a spatially refined vector */
    braid_PtFcnTimeGrid    tgrid;            /**< (optional) return time point values on level 0 */
+   braid_PtFcnBufCompress   bufcompress;    /**< (optional) compress a packed message */
+   braid_PtFcnBufDecompress bufdecompress;  /**< (optional) decompress a packed message */
+   braid_PtFcnBufDescribe bufdescribe;      /**< (optional) describe a vector as an MPI datatype, for in place messages */
+   braid_PtFcnPrecConvert lp_demote;        /**< (optional) convert a vector to the coarse-level precision */
+   braid_PtFcnPrecConvert lp_promote;       /**< (optional) convert a vector back to the fine-level precision */
+   braid_PtFcnStep        lp_step;          /**< (optional) step function on coarse-level precision vectors */
+   braid_PtFcnClone       lp_clone;         /**< (optional) clone a coarse-level precision vector */
+   braid_PtFcnFree        lp_free;          /**< (optional) free a coarse-level precision vector */
+   braid_PtFcnSum         lp_sum;           /**< (optional) sum of coarse-level precision vectors */
+   braid_PtFcnBufPack     lp_bufpack;       /**< (optional) pack a coarse-level precision vector */
+   braid_PtFcnBufUnpack   lp_bufunpack;     /**< (optional) unpack a coarse-level precision vector */
+   braid_PtFcnInnerProd   innerprod;        /**< (optional) inner product of two vectors, for the Delta correction and Anderson acceleration */
+   braid_Int              anderson_dim;     /**< number of cycles kept by the Anderson acceleration (0 is off) */
+   braid_Int              anderson_ortho;   /**< Gram-Schmidt variant of the Anderson acceleration */
+   _braid_Anderson       *anderson;         /**< Anderson acceleration data */
+   braid_PtFcnStepBegin   step_begin;       /**< (optional) begin an asynchronous step, in relaxation */
+   braid_PtFcnStepPoll    step_poll;        /**< (optional) test an asynchronous step for completion */
+   braid_PtFcnStepFinish  step_finish;      /**< (optional) complete an asynchronous step */
 
    braid_Int              access_level;     /**< determines how often to call the user's access routine */ 
+   braid_PtFcnAccessBulk  access_bulk;      /**< (optional) access all local vectors on the finest grid in one call */
    braid_Int              print_level;      /**< determines amount of output printed to screen (0,1,2,3) */
    braid_Int              io_level;         /**< determines amount of output printed to files (0,1) */
    braid_Int              seq_soln;         /**< boolean, controls if the initial guess is from sequential time stepping*/
@@ -276,17 +401,50 @@ typedef struct _braid_Core_struct
    braid_Int              fmg;              /**< use FMG cycle */
    braid_Int              nfmg;             /**< number of fmg cycles to do initially before switching to V-cycles */
    braid_Int              nfmg_Vcyc;        /**< number of V-cycle calls at each level in FMG */
+   braid_Int              nested_vcyc;      /**< number of V-cycles at each coarse level in the nested iteration startup (0 is off) */
    braid_Int              warm_restart;     /**< boolean, indicates whether this is a warm restart of an existing braid_Core */
+   braid_Int              reuse;            /**< on warm restarts, 0: start from init, 1: start from the previous solution, 2: also keep the FAS right-hand sides */
+   braid_Int              reuse_tau;        /**< boolean, the first cycle starts on the coarsest level with the kept FAS right-hand sides */
    braid_Int              tnorm;            /**< choice of temporal norm */
    braid_Real            *tnorm_a;          /**< local array of residual norms on a proc's interval, used for inf-norm */
+   braid_Real             frozen_tol;       /**< fraction of tol that marks a C-point as converged (0 turns off frozen regions) */
+   braid_Int              frozen_index;     /**< last frozen fine grid C-point, points 0 < i <= frozen_index are frozen */
+   braid_Real             frozen_rnorm;     /**< residual norm contribution of the frozen region (see @ref _braid_TNormAdd) */
+   braid_Real             frozen_full_rnorm;/**< full residual norm contribution of the frozen region */
    braid_Real             rnorm0;           /**< initial residual norm */
    braid_Real            *rnorms;           /**< residual norm history */
    braid_PtFcnResidual    full_rnorm_res;   /**< (optional) used to compute full residual norm */
    braid_Real             full_rnorm0;      /**< (optional) initial full residual norm */
    braid_Real            *full_rnorms;      /**< (optional) full residual norm history */
+   braid_Int              full_rnorm_freq;  /**< compute the full residual norm every full_rnorm_freq iterations */
+   braid_Real            *full_tnorm_a;     /**< local full residual norm of each interval, added to frozen_full_rnorm when it freezes */
+
+   braid_Int              compress_level;   /**< compress messages on levels >= compress_level (-1 is off) */
+   braid_Real             compress_rfactor; /**< compress messages only while rnorm > compress_rfactor*tol */
+   braid_Int              prec_level;       /**< vectors on levels >= prec_level use the low precision (0 is off) */
+   braid_Int              delta_rank;       /**< rank of the Delta correction on coarse levels (0 is off) */
+
+   braid_Int              shmcomm;          /**< boolean, exchange with same-node time neighbors through shared memory */
+   braid_Int              shm_active;       /**< boolean, the shared-memory window is set up */
+   MPI_Comm               shm_comm;         /**< communicator of the ranks on this node */
+   MPI_Win                shm_win;          /**< shared-memory window holding one message slot per rank */
+   braid_Int              shm_left;         /**< left time neighbor (rank in comm) sharing memory, or -1 */
+   braid_Int              shm_right;        /**< right time neighbor (rank in comm) sharing memory, or -1 */
+   braid_Int              shm_slot_size;    /**< size of the data part of a slot in bytes */
+   void                  *shm_recv_slot;    /**< my slot in the shared-memory window, or NULL */
+   void                  *shm_send_slot;    /**< slot of my right neighbor, or NULL */
+   braid_Int              shm_nsends;       /**< number of shared-memory sends posted so far */
+   braid_Int              shm_nrecvs;       /**< number of shared-memory receives posted so far */
+   _braid_CommHandle     *shm_recvs;        /**< queue of pending shared-memory receives */
+
+   char                  *sol_filename;     /**< (optional) binary file for the final fine grid solution */
 
    braid_Int              storage;          /**< storage = 0 (C-points), = 1 (all) */
    braid_Int              useshell;         /**< activate the shell structure of vectors */
+   braid_Real             memory_budget;    /**< vector memory budget per processor in bytes, selects storage (0 is off) */
+   braid_Real            *level_memory;     /**< estimated peak vector memory on each level (max over processors) */
+   braid_Int              compress_storage; /**< compress the F-point vectors stored on level 0 (0 is off) */
+   braid_Real             storage_ratio;    /**< compression ratio of the stored F-point vectors after the last run */
 
    braid_Int              gupper;           /**< global size of the fine grid */
 
@@ -305,6 +463,14 @@ typedef struct _braid_Core_struct
 
    braid_Real             localtime;        /**< local wall time for braid_Drive() */
    braid_Real             globaltime;       /**< global wall time for braid_Drive() */
+   braid_Real            *phase_times;      /**< local wall time of each cycle phase on each level, see @ref _braid_PhaseTime */
+   braid_Real            *comm_volume;      /**< messages and bytes sent to time neighbors from each level (max_levels x 2) */
+   braid_Real            *ncalls;           /**< calls of each user routine in braid_Drive(), see @ref _braid_CallCount */
+   braid_Int              nvectors;         /**< user vectors currently allocated by the base layer (init, clone, unpack) */
+   braid_Int              nvectors_peak;    /**< largest nvectors during braid_Drive() */
+   braid_Real             alloc_bytes0;     /**< _braid_alloc_bytes at the start of braid_Drive() */
+   braid_Real             alloc_count0;     /**< _braid_alloc_count at the start of braid_Drive() */
+   char                  *bench_filename;   /**< (optional) file that receives a JSON record of each run */
 
    /* Data for adjoint and optimization */
    braid_Optim            optim;             /**< structure that stores optimization variables (objective function, etc.) */ 
@@ -331,6 +497,13 @@ typedef struct _braid_Core_struct
    braid_Int              trimgrit;      /**< using TriMGRIT algorithm (1) or not (0)? */
    braid_PtFcnTriResidual triresidual;   /**< compute residual at time point i */
    braid_PtFcnTriSolve    trisolve;      /**< solve for time point i */
+   braid_PtFcnTriLinearize trilinearize; /**< (optional) linearize at time point i, for Newton-TriMGRIT */
+   braid_PtFcnTriLinFree  trilinfree;    /**< (optional) free a linearization */
+   braid_Int              newton_start;  /**< first iteration that reuses linearizations */
+   braid_Int              newton_lag;    /**< iterations a fine-level linearization is kept */
+   braid_Int              newton_clag;   /**< iterations a coarse-level linearization is kept */
+   void                  *tri_lin;       /**< linearization of the point in TriSolve (status) */
+   braid_Int              tridirect;     /**< solve the coarsest level directly (affine TriResidual)? */
 
    /** Data elements required for the Status structures */
    /** Common Status properties */
@@ -374,6 +547,74 @@ typedef struct _braid_Core_struct
  **/
 #define _braid_GridElt(grid, elt)  ((grid) -> elt)
 
+/**
+ * Accessor for _braid_TriDirect attributes
+ **/
+#define _braid_TriDirectElt(td, elt)  ((td) -> elt)
+
+/**
+ * Accessor for _braid_Anderson attributes
+ **/
+#define _braid_AndersonElt(anderson, elt) ((anderson) -> elt)
+
+/**
+ * Phases of the cycle timed on each level.  A phase covers the wall time of
+ * the routine called with that level (e.g., interp on level l is the time in
+ * the interpolation from level l to level l-1).  The coarse phase is the
+ * coarsest TriMGRIT solve, and anderson the cycle acceleration on level 0.
+ **/
+#define _braid_PHASE_RELAX     0
+#define _braid_PHASE_RESTRICT  1
+#define _braid_PHASE_INTERP    2
+#define _braid_PHASE_COARSE    3
+#define _braid_PHASE_ACCESS    4
+#define _braid_PHASE_ANDERSON  5
+#define _braid_NPHASES         6
+
+/**
+ * Add the wall time since t0 to phase p on the given level
+ **/
+#define _braid_PhaseTime(core, level, p, t0) \
+   ( _braid_CoreElt(core, phase_times)[(level)*_braid_NPHASES + (p)] += MPI_Wtime() - (t0) )
+
+/**
+ * Count a message of nbytes sent from the given level (only during braid_Drive)
+ **/
+#define _braid_CommCount(core, level, nbytes) \
+   ( (_braid_CoreElt(core, comm_volume) == NULL) ? 0.0 : \
+     (_braid_CoreElt(core, comm_volume)[2*(level)]   += 1.0, \
+      _braid_CoreElt(core, comm_volume)[2*(level)+1] += (braid_Real) (nbytes)) )
+
+/**
+ * User routines whose calls are counted by the base layer
+ **/
+#define _braid_CALL_STEP         0
+#define _braid_CALL_INIT         1
+#define _braid_CALL_CLONE        2
+#define _braid_CALL_FREE         3
+#define _braid_CALL_SUM          4
+#define _braid_CALL_SPATIALNORM  5
+#define _braid_CALL_ACCESS       6
+#define _braid_CALL_BUFPACK      7
+#define _braid_CALL_BUFUNPACK    8
+#define _braid_CALL_TRIRESIDUAL  9
+#define _braid_CALL_TRISOLVE     10
+#define _braid_NCALLS            11
+
+/**
+ * Count a call of user routine c (only during braid_Drive)
+ **/
+#define _braid_CallCount(core, c) \
+   ( (_braid_CoreElt(core, ncalls) == NULL) ? 0.0 : (_braid_CoreElt(core, ncalls)[c] += 1.0) )
+
+/**
+ * Count n user vectors allocated (n < 0 for freed) by the base layer
+ **/
+#define _braid_VectorCount(core, n) \
+   ( _braid_CoreElt(core, nvectors) += (n), \
+     _braid_CoreElt(core, nvectors_peak) = \
+        _braid_max(_braid_CoreElt(core, nvectors), _braid_CoreElt(core, nvectors_peak)) )
+
 /** 
  * Accessor for _braid_Core attributes 
  **/
@@ -384,6 +625,20 @@ typedef struct _braid_Core_struct
  **/
 #define _braid_CoreFcn(core, fcn)     (*((core)  -> fcn))
 
+/** 
+ * Accessor for _braid_Core functions that have a coarse-level precision
+ * counterpart (see @ref braid_SetCoarsePrecision).  The choice is made by
+ * the precision of the braid_BaseVector u.
+ **/
+#define _braid_CorePrecFcn(core, u, fcn) \
+( *( ((u) -> lowprec) ? ((core) -> lp_##fcn) : ((core) -> fcn) ) )
+
+/** 
+ * Boolean, true if vectors on this level are stored in the coarse-level precision
+ **/
+#define _braid_IsLowPrec(core, level) \
+( (_braid_CoreElt(core, prec_level) > 0) && ((level) >= _braid_CoreElt(core, prec_level)) )
+
 /*--------------------------------------------------------------------------
  * Print file for redirecting stdout when needed
  *--------------------------------------------------------------------------*/
@@ -391,7 +646,7 @@ typedef struct _braid_Core_struct
 /** 
  * This is the print file for redirecting stdout for all XBraid screen output
  **/
-extern FILE *_braid_printfile;
+extern _braid_ThreadLocal FILE *_braid_printfile;
 
 /*--------------------------------------------------------------------------
  * Coarsening macros
@@ -435,6 +690,52 @@ extern FILE *_braid_printfile;
 #define _braid_PriorCPoint(index, cfactor) \
 ( ((braid_Int)(index)/(cfactor))*(cfactor) )
 
+/*--------------------------------------------------------------------------
+ * Communication macros
+ *--------------------------------------------------------------------------*/
+
+/**
+ * Message codecs, stored in the message header when compression is on
+ **/
+#define _braid_COMM_RAW    0
+#define _braid_COMM_FLOAT  1
+#define _braid_COMM_USER   2
+
+/**
+ * Messages are sent in full precision for the rest of the run once a residual
+ * conv factor exceeds this value (see @ref _braid_CommCompress)
+ **/
+#define _braid_COMM_STALL  0.9
+
+/**
+ * Codecs of the compressed F-point vectors (see @ref braid_SetCompressStorage)
+ **/
+#define _braid_UZ_RAW    0
+#define _braid_UZ_QUANT  1
+#define _braid_UZ_USER   2
+
+/**
+ * Size in bytes of the header of a compressed F-point vector.  The header holds
+ * the codec, the packed size, the stored size, and the bytes per quantization
+ * code.
+ **/
+#define _braid_UZHeaderSize (2*sizeof(braid_Real))
+
+/**
+ * Size in bytes of the message header.  The header holds the codec and the
+ * sizes of the uncompressed and compressed message, and is only sent when compression is on
+ * (see @ref braid_SetCompressComm).  It is padded to keep the message aligned.
+ **/
+#define _braid_CommHeaderSize(core) \
+( (_braid_CoreElt(core, compress_level) > -1) ? 2*sizeof(braid_Real) : 0 )
+
+/**
+ * Boolean, true if time-neighbor messages are sent and received in place
+ * through the user's BufDescribe (see @ref braid_SetBufDescribe)
+ **/
+#define _braid_CommInPlace(core) \
+( (_braid_CoreElt(core, bufdescribe) != NULL) && !_braid_CoreElt(core, adjoint) )
+
 /*--------------------------------------------------------------------------
  * Prototypes
  *--------------------------------------------------------------------------*/
@@ -512,6 +813,67 @@ _braid_CommSendInit(braid_Core           core,
                     braid_BaseVector     vector,
                     _braid_CommHandle  **handle_ptr);
 
+/**
+ * Write the message header in *buffer* and, if compression is currently active
+ * on *level*, compress the *size_ptr* bytes packed after the header in place.
+ * The packed *vector* is used to estimate the error floor of the codec.  On
+ * return, *size_ptr* is the number of bytes to send, including the header.
+ */
+braid_Int
+_braid_CommCompress(braid_Core        core,
+                    braid_Int         level,
+                    braid_BaseVector  vector,
+                    void             *buffer,
+                    braid_Int        *size_ptr);
+
+/**
+ * Undo @ref _braid_CommCompress on a received *buffer*.  On return,
+ * *message_ptr* points to the uncompressed message for BufUnpack.
+ */
+braid_Int
+_braid_CommDecompress(braid_Core   core,
+                      void        *buffer,
+                      void       **message_ptr);
+
+/**
+ * Set up the shared-memory window used to exchange messages with time
+ * neighbors on the same node (see @ref braid_SetShmComm)
+ */
+braid_Int
+_braid_ShmCommInit(braid_Core  core);
+
+/**
+ * Free the shared-memory window
+ */
+braid_Int
+_braid_ShmCommDestroy(braid_Core  core);
+
+/**
+ * Queue a shared-memory receive, or complete a send by writing it into the
+ * slot of the right neighbor.  If that slot is still full, the send is posted
+ * with MPI instead.
+ */
+braid_Int
+_braid_ShmCommPost(braid_Core          core,
+                   _braid_CommHandle  *handle);
+
+/**
+ * Complete the pending shared-memory receives, oldest first, up to *handle*,
+ * without blocking.  If the message of *handle* is in my slot, it is left
+ * there and *ready_ptr* is set, so that it can be unpacked in place.
+ */
+braid_Int
+_braid_ShmCommProgress(braid_Core          core,
+                       _braid_CommHandle  *handle,
+                       braid_Int          *ready_ptr);
+
+/**
+ * Release my slot after the message of *handle* was unpacked from it
+ */
+braid_Int
+_braid_ShmCommRelease(braid_Core          core,
+                      _braid_CommHandle  *handle);
+
 /**
  * Block on the comm handle *handle_ptr* until the MPI operation (send or recv)
  * has completed
@@ -520,6 +882,16 @@ braid_Int
 _braid_CommWait(braid_Core         core,
                _braid_CommHandle **handle_ptr);
 
+/**
+ * Test without blocking whether the MPI operation of the comm handle *handle*
+ * has completed, and return the answer in *done_ptr*.  A NULL handle is done.
+ * The handle must still be completed with _braid_CommWait().
+ */
+braid_Int
+_braid_CommTest(braid_Core          core,
+                _braid_CommHandle  *handle,
+                braid_Int          *done_ptr);
+
 /**
  * Initialize communication for TriMGRIT.
  */
@@ -557,7 +929,10 @@ _braid_UGetIndex(braid_Core   core,
 
 /**
  * Returns a reference to the local u-vector on grid *level* at point *index*.
- * If the u-vector is not stored, returns NULL.
+ * If the u-vector is not stored, returns NULL.  A compressed F-point vector
+ * (see @ref braid_SetCompressStorage) is returned as a decompressed view that
+ * stays valid until the next compressed point is referenced.  Changes to the
+ * view must be stored back with @ref _braid_USetVectorRef.
  */
 braid_Int
 _braid_UGetVectorRef(braid_Core        core,
@@ -600,6 +975,47 @@ _braid_USetVector(braid_Core        core,
                   braid_BaseVector  u,
                   braid_Int         move);
 
+/**
+ * Skip the frozen F-points at the start of *flo*, ..., *fhi* on a coarse grid
+ * (see @ref braid_SetFrozenRegion).  Returns in *fstart_ptr* the first F-point
+ * that is not frozen and, if points were skipped, in *u_ptr* a copy of the
+ * value before it (else NULL).  Frozen coarse points keep their restricted
+ * values va[], and if my send index is skipped, that value is sent.
+ */
+braid_Int
+_braid_USkipFrozen(braid_Core        core,
+                   braid_Int         level,
+                   braid_Int         frozen,
+                   braid_Int         flo,
+                   braid_Int         fhi,
+                   braid_Int        *fstart_ptr,
+                   braid_BaseVector *u_ptr);
+
+/**
+ * Pack *u* and quantize it with an error below the stopping tolerance (see
+ * @ref braid_SetCompressStorage).  The returned record starts with a header of
+ * size @ref _braid_UZHeaderSize and is freed with @ref _braid_TFree.
+ */
+braid_Int
+_braid_UCompress(braid_Core         core,
+                 braid_BaseVector   u,
+                 char             **z_ptr);
+
+/**
+ * Unpack a new vector from a record produced by @ref _braid_UCompress.
+ */
+braid_Int
+_braid_UDecompress(braid_Core         core,
+                   char              *z,
+                   braid_BaseVector  *u_ptr);
+
+/**
+ * Compute the compression ratio of the F-point vectors stored on level 0 over
+ * all processors, and store it in the core for @ref braid_PrintStats.
+ */
+braid_Int
+_braid_UCompressRatio(braid_Core  core);
+
 /**
  * Basic communication (from the left, to the right).  Arguments *recv_msg* and
  * *send_msg* are booleans that indicate whether or not to initiate a receive
@@ -658,6 +1074,26 @@ _braid_GetInterval(braid_Core   core,
                    braid_Int   *fhi_ptr,
                    braid_Int   *ci_ptr);
 
+/**
+ * Return in *frozen_ptr* the last frozen point on grid *level* (see @ref
+ * braid_SetFrozenRegion).  Points 0 < *i* <= *frozen_ptr* are skipped by
+ * relaxation, restriction and interpolation, and keep their values.  A value
+ * of 0 means no frozen region.
+ */
+braid_Int
+_braid_GetFrozenIndex(braid_Core   core,
+                      braid_Int    level,
+                      braid_Int   *frozen_ptr);
+
+/**
+ * Update the frozen region from the level 0 C-pt residual norms in *tnorm_a*,
+ * and move the residual norms of the newly frozen C-pts from *tnorm_a* into
+ * the core's frozen_rnorm.  Called at the end of the level 0 restriction, after
+ * the new rnorm is set.
+ */
+braid_Int
+_braid_UpdateFrozenIndex(braid_Core  core);
+
 /** 
  * Call user's access function in order to give access to XBraid and the current
  * vector.  Most commonly, this lets the user write *u* to screen, disk, etc...
@@ -691,6 +1127,105 @@ _braid_Step(braid_Core        core,
             braid_BaseVector  ustop,
             braid_BaseVector  u);
 
+/**
+ * Begin the asynchronous step to time step *index* on *level*, as in
+ * _braid_Step().  Complete it with _braid_StepFinish().
+ */
+braid_Int
+_braid_StepBegin(braid_Core        core,
+                 braid_Int         level,
+                 braid_Int         index,
+                 braid_BaseVector  ustop,
+                 braid_BaseVector  u);
+
+/**
+ * Test whether the asynchronous step to time step *index* on *level* can be
+ * finished without waiting.  Always done if the user gave no poll routine.
+ */
+braid_Int
+_braid_StepPoll(braid_Core        core,
+                braid_Int         level,
+                braid_Int         index,
+                braid_BaseVector  u,
+                braid_Int        *done_ptr);
+
+/**
+ * Complete the asynchronous step to time step *index* on *level*, including
+ * the FAS right-hand side and the refinement factors, as in _braid_Step().
+ */
+braid_Int
+_braid_StepFinish(braid_Core        core,
+                  braid_Int         level,
+                  braid_Int         index,
+                  braid_BaseVector  u);
+
+/**
+ * Take the step to time step *index* on *level* without the FAS right-hand
+ * side, i.e., Phi(u) plus the Delta correction W V^T u if a basis was built
+ * for this step (never on level 0).  The step status must be set up by the
+ * caller.
+ */
+braid_Int
+_braid_DeltaStep(braid_Core        core,
+                 braid_Int         level,
+                 braid_Int         index,
+                 braid_BaseVector  ustop,
+                 braid_BaseVector  u);
+
+/**
+ * Build the Delta correction basis for the coarse step to time step *index*
+ * on *level* > 0, if not done already.  Arnoldi on the fine propagator over
+ * the step, linearized about va[index-1], gives V, and W = (Phi_f - Phi_c) V.
+ * Nothing is done if the fine interval of the step is not local or
+ * va[index-1] is zero.
+ */
+braid_Int
+_braid_DeltaBuild(braid_Core  core,
+                  braid_Int   level,
+                  braid_Int   index);
+
+/**
+ * Propagate *u* over the coarse step to time step *index* on *level* > 0,
+ * with the fine steps of its interval on *level*-1 (*fine* = 1), or with one
+ * plain coarse step (*fine* = 0).
+ */
+braid_Int
+_braid_DeltaPropagate(braid_Core        core,
+                      braid_Int         level,
+                      braid_Int         index,
+                      braid_Int         fine,
+                      braid_BaseVector  u);
+
+/**
+ * Return in *z_ptr* the propagator of @ref _braid_DeltaPropagate applied to
+ * *v*, linearized about *u0* by the finite difference
+ * (Phi(u0 + delta v) - y0) / delta, where *y0* = Phi(u0).
+ */
+braid_Int
+_braid_DeltaLinearize(braid_Core        core,
+                      braid_Int         level,
+                      braid_Int         index,
+                      braid_Int         fine,
+                      braid_BaseVector  u0,
+                      braid_BaseVector  y0,
+                      braid_Real        delta,
+                      braid_BaseVector  v,
+                      braid_BaseVector *z_ptr);
+
+/**
+ * Replace the vectors stored on level 0, the result of the last cycle, with
+ * the Anderson-accelerated iterate (see @ref braid_SetAnderson). The first call
+ * only saves the iterate.  Collective over the temporal communicator.
+ */
+braid_Int
+_braid_AndersonUpdate(braid_Core  core);
+
+/**
+ * Free the Anderson acceleration data
+ */
+braid_Int
+_braid_AndersonDestroy(braid_Core  core);
+
 /**
  * Compute residual *r*
  */
@@ -778,6 +1313,27 @@ braid_Int
 _braid_GridDestroy(braid_Core    core,
                    _braid_Grid  *grid);
 
+/**
+ * Prepare a warm restart (a second or later call to braid_Drive).  With
+ * *reuse* 1 nothing is done, so the previous solution is the initial guess.
+ * With *reuse* 0 the stored vectors on level 0 are set with init, the coarse
+ * levels are cleaned, and the adjoint vectors and initial residual norm are
+ * reset, as for a new braid_Core.  With *reuse* 2 the FAS right-hand sides
+ * kept by @ref _braid_KeepTau are moved back to fa on the coarse levels, and
+ * the first cycle starts on the coarsest level.
+ */
+braid_Int
+_braid_WarmRestart(braid_Core  core);
+
+/**
+ * Move the FAS right-hand sides fa on *level* to tau, where the grid clean
+ * at the end of an interpolation leaves them for the next warm restart.  Only
+ * used with braid_SetReuseSolution(core, 2).
+ */
+braid_Int
+_braid_KeepTau(braid_Core  core,
+               braid_Int   level);
+
 /**
  * Set initial guess on *level*.  Only C-pts are initialized on level 0,
  * otherwise stored values are initialized based on restricted fine-grid values.
@@ -787,20 +1343,19 @@ _braid_InitGuess(braid_Core  core,
                  braid_Int   level);
 
 /**
- * Compute full temporal residual norm with user-provided residual routine. 
- * Output goes in *return_rnorm. 
+ * Do nu sweeps of F-then-C relaxation on *level*
  */
 braid_Int
-_braid_ComputeFullRNorm(braid_Core  core,
-                        braid_Int   level,
-                        braid_Real *return_rnorm);
+_braid_FCRelax(braid_Core  core,
+               braid_Int   level);
 
 /**
- * Do nu sweeps of F-then-C relaxation on *level*
+ * Do nu sweeps of F-then-C relaxation on *level* with asynchronous steps,
+ * keeping one step in flight on each interval (see @ref braid_SetStepAsync)
  */
 braid_Int
-_braid_FCRelax(braid_Core  core,
-               braid_Int   level);
+_braid_FCRelaxAsync(braid_Core  core,
+                    braid_Int   level);
 
 /**
  * F-Relax on *level* and then restrict to *level+1*
@@ -812,7 +1367,10 @@ _braid_FCRelax(braid_Core  core,
  * If the user has set spatial coarsening, then this user-defined routine is
  * also called.
  *
- * If *level==0*, then *rnorm_ptr* will contain the residual norm.
+ * If *level==0*, then *rnorm_ptr* will contain the residual norm.  If a full
+ * residual routine is set and this iteration is due (see full_rnorm_freq), the
+ * full residual norm is accumulated during the same F-relaxation sweep and
+ * stored with _braid_SetFullRNorm.
  */
 braid_Int
 _braid_FRestrict(braid_Core   core,       /**< braid_Core (_braid_Core) struct */   
@@ -856,6 +1414,17 @@ braid_Int
 _braid_FRefine(braid_Core   core,
                braid_Int   *refined_ptr);
 
+/**
+ * Call the user's bulk access routine (see @ref braid_SetAccessBulk) with the
+ * vectors *u* at all local time points of grid *level*, ordered by time.
+ */
+braid_Int
+_braid_AccessBulk(braid_Core         core,
+                  braid_Int          level,
+                  braid_Int          done,
+                  braid_Int          calling_function,
+                  braid_BaseVector  *u);
+
 /** 
  * Call the user's access function in order to give access to XBraid and the
  * current vector at grid *level and iteration *iter*.  Most commonly, this lets
@@ -868,6 +1437,78 @@ _braid_FAccess(braid_Core     core,
                braid_Int      level,
                braid_Int      done);
 
+/**
+ * Return braid_ERROR_GENERIC if a feature that checkpoints do not support
+ * (TriMGRIT, shell vectors, time chunks) is in use.
+ */
+braid_Int
+_braid_CheckpointCheck(braid_Core  core);
+
+/**
+ * Pack vector *u* into a checkpoint *slot* (a size and precision header,
+ * then the BufPack data).  A NULL vector gives an empty slot.
+ */
+braid_Int
+_braid_CheckpointPack(braid_Core        core,
+                      void             *slot,
+                      braid_BaseVector  u);
+
+/**
+ * Unpack a checkpoint *slot* into a vector with the precision of grid
+ * *level*.  An empty slot returns NULL.
+ */
+braid_Int
+_braid_CheckpointUnpack(braid_Core         core,
+                        braid_Int          level,
+                        void              *slot,
+                        braid_BaseVector  *u_ptr);
+
+/**
+ * Collectively write the stored vectors of all grid levels, the adjoint
+ * vectors and the residual norm history to the file *filename*.
+ */
+braid_Int
+_braid_WriteCheckpoint(braid_Core   core,
+                       const char  *filename);
+
+/**
+ * Build the grid hierarchy from the checkpoint file *filename* instead of
+ * the user's initial guess, and turn on warm_restart.
+ */
+braid_Int
+_braid_ReadCheckpoint(braid_Core   core,
+                      const char  *filename);
+
+/**
+ * Return the size in bytes of one record in the solution file set with
+ * braid_SetWriteSolution (a time value, an index, the packed size, and the
+ * BufPack data padded to a multiple of 8 bytes).
+ */
+braid_Int
+_braid_SolutionRecordSize(braid_Core   core,
+                          braid_Int   *recsize_ptr);
+
+/**
+ * Pack vector *u* at time *t* and fine grid index *index* into the record at
+ * *record* of the local solution buffer.
+ */
+braid_Int
+_braid_SolutionRecordPack(braid_Core        core,
+                          void             *record,
+                          braid_Int         index,
+                          braid_Real        t,
+                          braid_BaseVector  u);
+
+/**
+ * Collectively write the local records in *buffer* (one for each point
+ * ilower..iupper on level 0) to the solution file, at their global position.
+ * The first chunk creates the file, and rank 0 writes the header.
+ */
+braid_Int
+_braid_SolutionWrite(braid_Core   core,
+                     void        *buffer,
+                     braid_Int    recsize);
+
 /**
  * Initialize grid hierarchy with *fine_grid* serving as the finest grid.
  * Boolean *refined* indicates whether *fine_grid* was created by refining a
@@ -879,6 +1520,18 @@ _braid_InitHierarchy(braid_Core    core,
                      _braid_Grid  *fine_grid,
                      braid_Int     refined);
 
+/**
+ * Estimate the peak vector memory on each level from the user's buffer size,
+ * and store the maximum over processors in *level_memory*.  If *choose* is
+ * set, first pick the storage level threshold (see braid_SetStorage) that
+ * stores F-points on as many levels as fit in *memory_budget*, starting from
+ * the coarsest level.  Called by _braid_InitHierarchy() when a memory budget
+ * is set and before the u-vectors are allocated.
+ */
+braid_Int
+_braid_ChooseStorage(braid_Core  core,
+                     braid_Int   choose);
+
 /**
  * Print out the residual norm for every C-point.
  * Processor 0 gathers all the rnorms and prints them
@@ -934,6 +1587,14 @@ _braid_GetFullRNorm(braid_Core  core,
                     braid_Int   iter,
                     braid_Real *rnorm_ptr);
 
+/**
+ * Compute the TriMGRIT residual norm over all points of *level* and set it
+ * for the current iteration.  Used after the one-level direct solve.
+ */
+braid_Int
+_braid_TriComputeRNorm(braid_Core  core,
+                       braid_Int   level);
+
 /**
  *  Delete the last residual, for use if F-Refinement is done. 
  */
@@ -1032,6 +1693,36 @@ _braid_AdjointFeatureCheck(braid_Core core);
 braid_Int
 _braid_ChunkFeatureCheck(braid_Core core);
 
+/**
+ * Sanity check for non-supported coarse-level precision features 
+ */
+braid_Int
+_braid_PrecFeatureCheck(braid_Core core);
+
+/**
+ * Sanity check for non-supported Delta correction features 
+ */
+braid_Int
+_braid_DeltaFeatureCheck(braid_Core core);
+
+/**
+ * Sanity check for non-supported asynchronous step features 
+ */
+braid_Int
+_braid_AsyncFeatureCheck(braid_Core core);
+
+/**
+ * Sanity check for non-supported Anderson acceleration features
+ */
+braid_Int
+_braid_AndersonFeatureCheck(braid_Core core);
+
+/**
+ * Sanity check for non-supported compressed storage features 
+ */
+braid_Int
+_braid_CompressFeatureCheck(braid_Core core);
+
 /**
  * Returns a reference to the vector at the last time step.
  * Return NULL if it is not stored on this processor.
@@ -1047,6 +1738,19 @@ _braid_UGetLast(braid_Core        core,
 braid_Int
 _braid_ChunkSetInitialCondition(braid_Core core);
 
+/**
+ * Append a one-line JSON record of the last run (problem size, iterations,
+ * final residual, wall time, per-level phase times, communication volume,
+ * user routine calls, peak user vectors and allocations) to *filename*.  The
+ * phase times and peak vectors are reduced with a max and the counts with a
+ * sum over all processors, and only processor 0 writes the record.  Called
+ * at the end of braid_Drive() when braid_SetBenchFile() or the
+ * BRAID_BENCH_FILE environment variable is set.
+ */
+braid_Int
+_braid_WriteBenchRecord(braid_Core   core,
+                        const char  *filename);
+
 /**
  * TriMGRIT FCF-relaxation routine
  */
@@ -1085,6 +1789,41 @@ _braid_TriSolve(braid_Core  core,
                 braid_Int   level,
                 braid_Int   index);
 
+/**
+ * Start a new linearization epoch on *level* for Newton-TriMGRIT, if the
+ * current one has expired.  The points are then linearized in their next
+ * _braid_TriSolve().
+ */
+braid_Int
+_braid_TriNewtonUpdate(braid_Core  core,
+                       braid_Int   level);
+
+/**
+ * Probe the blocks of the affine TriMGRIT system on *level* with TriResidual
+ * at the current iterate (whose ghost points must be current), factor the
+ * local rows, and factor the reduced interface system on process 0.
+ * Collective over the temporal communicator.
+ */
+braid_Int
+_braid_TriDirectSetup(braid_Core  core,
+                      braid_Int   level);
+
+/**
+ * Solve the TriMGRIT system on *level* exactly, assuming TriResidual is
+ * affine, by adding the correction from the probed blocks to u.  Sets up the
+ * solver on the first call, and again when the Newton-TriMGRIT linearization
+ * epoch changes.  Collective over the temporal communicator.
+ */
+braid_Int
+_braid_TriDirectSolve(braid_Core  core,
+                      braid_Int   level);
+
+/**
+ * Free the direct solver data *td*
+ */
+braid_Int
+_braid_TriDirectDestroy(_braid_TriDirect  *td);
+
 /**
  * TriMGRIT solve routine.  Compute residual for time step 'index' on grid 'level':
  *    A(u)    (if 'fas' == 0)
@@ -69,18 +69,72 @@ _braid_BaseStep(braid_Core       core,
   }
 
    /* Call the users Step function */
+   _braid_CallCount(core, _braid_CALL_STEP);
    if ( fstop == NULL )
    {
-      _braid_CoreFcn(core, step)(app, ustop->userVector, NULL, u->userVector, status);
+      _braid_CorePrecFcn(core, u, step)(app, ustop->userVector, NULL, u->userVector, status);
    }
    else
    {
       /* fstop not supported by adjoint! */
-      _braid_CoreFcn(core, step)(app, ustop->userVector, fstop->userVector, u->userVector, status);
+      _braid_CorePrecFcn(core, u, step)(app, ustop->userVector, fstop->userVector, u->userVector, status);
    }
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseStepBegin(braid_Core       core,
+                     braid_App        app,
+                     braid_BaseVector ustop,
+                     braid_BaseVector fstop,
+                     braid_BaseVector u,
+                     braid_StepStatus status )
+{
+   _braid_CallCount(core, _braid_CALL_STEP);
+   if ( fstop == NULL )
+   {
+      _braid_CoreFcn(core, step_begin)(app, ustop->userVector, NULL, u->userVector, status);
+   }
+   else
+   {
+      _braid_CoreFcn(core, step_begin)(app, ustop->userVector, fstop->userVector, u->userVector, status);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseStepPoll(braid_Core       core,
+                    braid_App        app,
+                    braid_BaseVector u,
+                    braid_StepStatus status,
+                    braid_Int       *done_ptr )
+{
+   _braid_CoreFcn(core, step_poll)(app, u->userVector, status, done_ptr);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseStepFinish(braid_Core       core,
+                      braid_App        app,
+                      braid_BaseVector u,
+                      braid_StepStatus status )
+{
+   _braid_CoreFcn(core, step_finish)(app, u->userVector, status);
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -101,11 +155,14 @@ _braid_BaseInit(braid_Core        core,
    if (verbose_adj) printf("%d INIT\n", myid);
 
    /* Allocate the braid_BaseVector */
-   u = (braid_BaseVector) malloc(sizeof(braid_Vector) + sizeof(braid_VectorBar));
+   u = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
    u->userVector = NULL;
    u->bar        = NULL;
+   u->lowprec    = 0;
 
    /* Allocate and initialize the userVector */
+   _braid_CallCount(core, _braid_CALL_INIT);
+   _braid_VectorCount(core, 1);
    _braid_CoreFcn(core, init)(app, t, &(u->userVector));
 
    /* Allocate and initialize the bar vector */
@@ -158,12 +215,15 @@ _braid_BaseClone(braid_Core         core,
    if (verbose_adj) printf("%d: CLONE\n", myid);
 
    /* Allocate the braid_BaseVector */
-   v = (braid_BaseVector) malloc(sizeof(braid_Vector) + sizeof(braid_VectorBar));
+   v = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
    v->userVector  = NULL;
    v->bar = NULL;
+   v->lowprec = u->lowprec;
 
    /* Allocate and copy the userVector */
-   _braid_CoreFcn(core, clone)(app, u->userVector, &(v->userVector) );
+   _braid_CallCount(core, _braid_CALL_CLONE);
+   _braid_VectorCount(core, 1);
+   _braid_CorePrecFcn(core, u, clone)(app, u->userVector, &(v->userVector) );
 
    /* Allocate and initialize the bar vector to zero*/
    if ( adjoint )
@@ -227,7 +287,9 @@ _braid_BaseFree(braid_Core       core,
    }
 
    /* Free the user's vector */
-   _braid_CoreFcn(core, free)(app, u->userVector);
+   _braid_CallCount(core, _braid_CALL_FREE);
+   _braid_VectorCount(core, -1);
+   _braid_CorePrecFcn(core, u, free)(app, u->userVector);
 
    if ( adjoint )
    {
@@ -281,7 +343,8 @@ _braid_BaseSum(braid_Core        core,
    }
 
     /* Sum up the user's vector */
-   _braid_CoreFcn(core, sum)(app, alpha, x->userVector, beta, y->userVector);
+   _braid_CallCount(core, _braid_CALL_SUM);
+   _braid_CorePrecFcn(core, x, sum)(app, alpha, x->userVector, beta, y->userVector);
 
    return _braid_error_flag;
 }
@@ -296,11 +359,28 @@ _braid_BaseSpatialNorm(braid_Core        core,
                        braid_Real       *norm_ptr )
 {
    /* Compute the spatial norm of the user's vector */
+   _braid_CallCount(core, _braid_CALL_SPATIALNORM);
    _braid_CoreFcn(core, spatialnorm)(app, u->userVector, norm_ptr);
 
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseInnerProd(braid_Core        core,
+                     braid_App         app,
+                     braid_BaseVector  u,
+                     braid_BaseVector  v,
+                     braid_Real       *prod_ptr )
+{
+   /* Compute the inner product of the user's vectors */
+   _braid_CoreFcn(core, innerprod)(app, u->userVector, v->userVector, prod_ptr);
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -331,6 +411,7 @@ _braid_BaseAccess(braid_Core          core,
    }
 
    /* Access the user's vector */
+   _braid_CallCount(core, _braid_CALL_ACCESS);
    _braid_CoreFcn(core, access)(app, u->userVector, status);
 
    return _braid_error_flag;
@@ -394,7 +475,8 @@ _braid_BaseBufPack(braid_Core          core,
    }
 
    /* BufPack the user's vector */
-   _braid_CoreFcn(core, bufpack)(app, u->userVector, buffer, status);
+   _braid_CallCount(core, _braid_CALL_BUFPACK);
+   _braid_CorePrecFcn(core, u, bufpack)(app, u->userVector, buffer, status);
 
    return _braid_error_flag;
 }
@@ -423,11 +505,14 @@ _braid_BaseBufUnpack(braid_Core          core,
    if ( verbose_adj ) printf("%d: BUFUNPACK\n", myid);
 
    /* Allocate the braid_BaseVector */
-   u = (braid_BaseVector) malloc(sizeof(braid_Vector) + sizeof(braid_VectorBar));
+   u = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
    u->userVector  = NULL;
    u->bar = NULL;
+   u->lowprec = 0;
 
    /* BufUnpack the user's vector */
+   _braid_CallCount(core, _braid_CALL_BUFUNPACK);
+   _braid_VectorCount(core, 1);
    _braid_CoreFcn(core, bufunpack)(app, buffer, &(u->userVector), status);
 
    if ( adjoint )
@@ -463,6 +548,72 @@ _braid_BaseBufUnpack(braid_Core          core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseBufDescribe(braid_Core          core,
+                       braid_App           app,
+                       braid_Int           level,
+                       braid_Real          t,
+                       braid_BaseVector   *u_ptr,
+                       MPI_Datatype       *dtype_ptr )
+{
+   braid_BaseVector u            = *u_ptr;
+   braid_Int        myid         = _braid_CoreElt(core, myid);
+   braid_Int        verbose_adj  = _braid_CoreElt(core, verbose_adj);
+
+   if ( verbose_adj ) printf("%d: BUFDESCRIBE\n", myid);
+
+   if ( u == NULL )
+   {
+      /* Allocate the braid_BaseVector, the user allocates the userVector */
+      u = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
+      u->userVector = NULL;
+      u->bar        = NULL;
+      u->lowprec    = _braid_IsLowPrec(core, level);
+   }
+
+   /* Describe the user's vector */
+   _braid_CoreFcn(core, bufdescribe)(app, level, t, &(u->userVector), dtype_ptr);
+
+   *u_ptr = u;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseBufUnpackLowPrec(braid_Core          core,
+                            braid_App           app,
+                            void               *buffer,
+                            braid_BaseVector   *u_ptr,
+                            braid_BufferStatus  status )
+{
+   braid_BaseVector u;
+   braid_Int        myid         = _braid_CoreElt(core, myid);
+   braid_Int        verbose_adj  = _braid_CoreElt(core, verbose_adj);
+
+   if ( verbose_adj ) printf("%d: BUFUNPACK\n", myid);
+
+   /* Allocate the braid_BaseVector */
+   u = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
+   u->userVector = NULL;
+   u->bar        = NULL;
+   u->lowprec    = 1;
+
+   /* BufUnpack the user's vector */
+   _braid_CallCount(core, _braid_CALL_BUFUNPACK);
+   _braid_VectorCount(core, 1);
+   _braid_CoreFcn(core, lp_bufunpack)(app, buffer, &(u->userVector), status);
+
+   *u_ptr = u;
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -577,7 +728,9 @@ _braid_BaseSCoarsen(braid_Core              core,
 
    if ( verbose_adj ) printf("%d: SCOARSEN\n", myid);
 
-   cu = (braid_BaseVector) malloc(sizeof(braid_BaseVector));
+   cu = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
+   cu->bar     = NULL;
+   cu->lowprec = fu->lowprec;
 
    /* Call the users SCoarsen Function */
    _braid_CoreFcn(core, scoarsen)(app, fu->userVector, &(cu->userVector), status);
@@ -603,7 +756,9 @@ _braid_BaseSRefine(braid_Core                 core,
 
    if ( verbose_adj ) printf("%d: SREFINE\n", myid);
 
-   fu = (braid_BaseVector) malloc(sizeof(braid_BaseVector));
+   fu = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
+   fu->bar     = NULL;
+   fu->lowprec = cu->lowprec;
 
    /* Call the users SRefine */
    _braid_CoreFcn(core, srefine)(app, cu->userVector, &(fu->userVector), status);
@@ -613,6 +768,42 @@ _braid_BaseSRefine(braid_Core                 core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseConvertPrec(braid_Core         core,
+                       braid_App          app,
+                       braid_BaseVector   u,
+                       braid_Int          lowprec,
+                       braid_BaseVector  *v_ptr )
+{
+   braid_BaseVector v;
+   braid_Int        verbose_adj  = _braid_CoreElt(core, verbose_adj);
+   braid_Int        myid         = _braid_CoreElt(core, myid);
+
+   if ( verbose_adj ) printf("%d: CONVERTPREC\n", myid);
+
+   v = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
+   v->bar     = NULL;
+   v->lowprec = lowprec;
+
+   /* Call the users Demote or Promote */
+   _braid_VectorCount(core, 1);
+   if ( lowprec )
+   {
+      _braid_CoreFcn(core, lp_demote)(app, u->userVector, &(v->userVector));
+   }
+   else
+   {
+      _braid_CoreFcn(core, lp_promote)(app, u->userVector, &(v->userVector));
+   }
+
+   *v_ptr = v;
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -628,9 +819,12 @@ _braid_BaseSInit(braid_Core        core,
 
    if ( verbose_adj ) printf("%d: SINIT\n", myid);
 
-   u = (braid_BaseVector) malloc(sizeof(braid_BaseVector));
+   u = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
+   u->bar     = NULL;
+   u->lowprec = 0;
 
-   /* Call the users SInit */
+   /* Call the users SInit (the shell is freed with _braid_BaseFree) */
+   _braid_VectorCount(core, 1);
    _braid_CoreFcn(core, sinit)(app, t, &(u->userVector));
 
    *u_ptr = u;
@@ -654,9 +848,12 @@ _braid_BaseSClone(braid_Core        core,
 
    if ( verbose_adj ) printf("%d: SCLONE\n", myid);
 
-   v = (braid_BaseVector) malloc(sizeof(braid_BaseVector));
+   v = (braid_BaseVector) malloc(sizeof(struct _braid_BaseVector_struct));
+   v->bar     = NULL;
+   v->lowprec = u->lowprec;
 
    /* Call the users SClone */
+   _braid_VectorCount(core, 1);
    _braid_CoreFcn(core, sclone)(app, u->userVector, &(v->userVector));
 
    *v_ptr = v;
@@ -1016,6 +1213,7 @@ _braid_BaseTriResidual(braid_Core       core,
    if ( uright != NULL ) { user_uright = (uright->userVector); }
    if ( f != NULL )      { user_f      = (f->userVector); }
 
+   _braid_CallCount(core, _braid_CALL_TRIRESIDUAL);
    _braid_CoreFcn(core, triresidual)(app, user_uleft, user_uright, user_f, r->userVector,
                                      homogeneous, status);
 
@@ -1043,11 +1241,36 @@ _braid_BaseTriSolve(braid_Core       core,
    if ( uright != NULL ) { user_uright = (uright->userVector); }
    if ( f != NULL )      { user_f      = (f->userVector); }
 
+   _braid_CallCount(core, _braid_CALL_TRISOLVE);
    _braid_CoreFcn(core, trisolve)(app, user_uleft, user_uright, user_f, u->userVector,
                                   homogeneous, status);
 
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseTriLinearize(braid_Core       core,
+                        braid_App        app,
+                        braid_BaseVector uleft,
+                        braid_BaseVector uright,
+                        braid_BaseVector u,
+                        braid_TriStatus  status,
+                        void           **lin_ptr )
+{
+   braid_Vector user_uleft  = NULL;
+   braid_Vector user_uright = NULL;
+
+   if ( uleft != NULL )  { user_uleft  = (uleft->userVector); }
+   if ( uright != NULL ) { user_uright = (uright->userVector); }
+
+   _braid_CoreFcn(core, trilinearize)(app, user_uleft, user_uright, u->userVector,
+                                      status, lin_ptr);
+
+   return _braid_error_flag;
+}
+
 #endif
 
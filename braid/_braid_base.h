@@ -55,6 +55,39 @@ _braid_BaseStep(braid_Core       core,       /**< braid_Core structure */
                 braid_Int        level,      /**< current time grid level */ 
                 braid_StepStatus status );   /**< braid_Status structure (pointer to the core) */    
 
+/**
+ * This calls the user's StepBegin routine. 
+ * If (adjoint): nothing (not supported)
+ */
+braid_Int 
+_braid_BaseStepBegin(braid_Core       core,       /**< braid_Core structure */
+                     braid_App        app,        /**< user-defined _braid_App structure */
+                     braid_BaseVector ustop,      /**< input, *u* vector at *tstop* */
+                     braid_BaseVector fstop,      /**< input, right-hand-side at *tstop* */
+                     braid_BaseVector u,          /**< input/output, initially *u* vector at *tstart*, upon exit, in flight */
+                     braid_StepStatus status );   /**< braid_Status structure (pointer to the core) */
+
+/**
+ * This calls the user's StepPoll routine. 
+ * If (adjoint): nothing (not supported)
+ */
+braid_Int 
+_braid_BaseStepPoll(braid_Core       core,       /**< braid_Core structure */
+                    braid_App        app,        /**< user-defined _braid_App structure */
+                    braid_BaseVector u,          /**< vector with a step in flight */
+                    braid_StepStatus status,     /**< braid_Status structure (pointer to the core) */
+                    braid_Int       *done_ptr ); /**< output, 1 if the step can be finished */
+
+/**
+ * This calls the user's StepFinish routine. 
+ * If (adjoint): nothing (not supported)
+ */
+braid_Int 
+_braid_BaseStepFinish(braid_Core       core,       /**< braid_Core structure */
+                      braid_App        app,        /**< user-defined _braid_App structure */
+                      braid_BaseVector u,          /**< input/output, upon exit, *u* vector at *tstop* */
+                      braid_StepStatus status );   /**< braid_Status structure (pointer to the core) */
+
 
 /**
  * This initializes a braid_BaseVector and calls the user's init routine. 
@@ -112,6 +145,18 @@ _braid_BaseSpatialNorm(braid_Core        core,      /**< braid_Core structure */
                        braid_Real       *norm_ptr   /**< output, norm of braid_Vector (this is a spatial norm) */
                        );
 
+/**
+ * This calls the user's InnerProd routine. 
+ * If (adjoint): nothing
+ */ 
+braid_Int
+_braid_BaseInnerProd(braid_Core        core,      /**< braid_Core structure */
+                     braid_App         app,       /**< user-defined _braid_App structure */     
+                     braid_BaseVector  u,         /**< first vector */
+                     braid_BaseVector  v,         /**< second vector */
+                     braid_Real       *prod_ptr   /**< output, inner product of u and v (over space) */
+                     );
+
 /**
  * This calls the user's Access routine. 
  * If (adjoint): also record the action
@@ -159,6 +204,33 @@ _braid_BaseBufUnpack(braid_Core           core,      /**< braid_Core structure *
                      braid_BufferStatus   status     /**< can be querried for info about the message type */
                      );
 
+/**
+ * This calls the user's BufDescribe routine.  If *u_ptr is NULL, a new
+ * baseVector is allocated and the user allocates its userVector. 
+ * If (adjoint): nothing, in place messages are not supported
+ */
+braid_Int
+_braid_BaseBufDescribe(braid_Core           core,      /**< braid_Core structure */   
+                       braid_App            app,       /**< user-defined _braid_App structure */    
+                       braid_Int            level,     /**< level of the vector */ 
+                       braid_Real           t,         /**< time value of the vector */ 
+                       braid_BaseVector    *u_ptr,     /**< input/output, vector to describe, allocated if NULL */
+                       MPI_Datatype        *dtype_ptr  /**< output, committed datatype describing the vector */
+                       );
+
+/**
+ * This initializes a baseVector and calls the user's coarse-level precision
+ * BufUnpack routine (see @ref braid_SetCoarsePrecision). 
+ * If (adjoint): nothing, the coarse-level precision is not supported
+ */
+braid_Int
+_braid_BaseBufUnpackLowPrec(braid_Core           core,      /**< braid_Core structure */   
+                            braid_App            app,       /**< user-defined _braid_App structure */    
+                            void                *buffer,    /**< MPI Buffer to unpack and place in u_ptr */ 
+                            braid_BaseVector    *u_ptr,     /**< output, braid_Vector containing buffer's data */
+                            braid_BufferStatus   status     /**< can be querried for info about the message type */
+                            );
+
 /** 
  * If (adjoint): This calls the user's ObjectiveT routine, records the action, and 
  *               pushes to the state and bar tapes. 
@@ -221,6 +293,19 @@ _braid_BaseSRefine(braid_Core              core,      /**< braid_Core structure
                    braid_CoarsenRefStatus  status     /**< braid_Status structure (pointer to the core) */ 
                    );
 
+/**
+ * This initializes a baseVector and calls the user's Demote (lowprec = 1) or
+ * Promote (lowprec = 0) routine, converting u to the requested precision.
+ * If (adjoint): nothing, the coarse-level precision is not supported
+ */
+braid_Int
+_braid_BaseConvertPrec(braid_Core         core,      /**< braid_Core structure */
+                       braid_App          app,       /**< user-defined _braid_App structure */
+                       braid_BaseVector   u,         /**< braid_BaseVector to convert */
+                       braid_Int          lowprec,   /**< precision of the output vector */
+                       braid_BaseVector  *v_ptr      /**< output, converted vector */
+                       );
+
 /**
  * This initializes a shell baseVector and call's the user's SInit routine.
  * If (adjoint): nothing
@@ -371,4 +456,16 @@ _braid_BaseTriResidual(braid_Core       core,
                        braid_Int        level,
                        braid_TriStatus  status );
 
+/**
+ * Base TriLinearize routine
+ */ 
+braid_Int
+_braid_BaseTriLinearize(braid_Core       core,
+                        braid_App        app,
+                        braid_BaseVector uleft,
+                        braid_BaseVector uright,
+                        braid_BaseVector u,
+                        braid_TriStatus  status,
+                        void           **lin_ptr );
+
 #endif
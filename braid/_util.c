@@ -172,3 +172,151 @@ _braid_GetNEntries(braid_Real   *_array,
 }
 
 
+
+/*--------------------------------------------------------------------------
+ * Open a binary file for collective reading or writing
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+_braid_FileOpen(MPI_Comm      comm,
+                const char   *filename,
+                braid_Int     mode,
+                _braid_File  *fh_ptr)
+{
+#ifndef braid_SEQUENTIAL
+   int  amode;
+
+   amode = (mode == 0) ? MPI_MODE_RDONLY : MPI_MODE_WRONLY;
+   if (mode == 1)
+   {
+      amode |= MPI_MODE_CREATE;
+   }
+   if (MPI_File_open(comm, (char *) filename, amode, MPI_INFO_NULL, fh_ptr) != MPI_SUCCESS)
+   {
+      _braid_Error(braid_ERROR_GENERIC, "Unable to open file");
+      return braid_ERROR_GENERIC;
+   }
+   if (mode == 1)
+   {
+      /* Truncate the output of an earlier run */
+      MPI_File_set_size(*fh_ptr, 0);
+   }
+#else
+   const char  *fmode[3] = {"rb", "wb", "r+b"};
+#ifdef braid_THREADS
+   int          rank;
+
+   /* The ranks share the file system, so only rank 0 truncates the file */
+   MPI_Comm_rank(comm, &rank);
+   if ( (mode == 1) && (rank != 0) )
+   {
+      MPI_Barrier(comm);
+      mode = 2;
+   }
+#endif
+
+   *fh_ptr = fopen(filename, fmode[mode]);
+#ifdef braid_THREADS
+   if ( (mode == 1) && (rank == 0) )
+   {
+      MPI_Barrier(comm);
+   }
+#endif
+   if (*fh_ptr == NULL)
+   {
+      _braid_Error(braid_ERROR_GENERIC, "Unable to open file");
+      return braid_ERROR_GENERIC;
+   }
+#endif
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ * Write records to a binary file at a byte offset
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+_braid_FileWriteAt(_braid_File   fh,
+                   braid_Int     collective,
+                   int64_t       offset,
+                   void         *buffer,
+                   braid_Int     count,
+                   braid_Int     size)
+{
+#ifndef braid_SEQUENTIAL
+   MPI_Datatype  rtype;
+
+   /* Use a record type, so count*size may exceed the int range */
+   MPI_Type_contiguous(size, MPI_BYTE, &rtype);
+   MPI_Type_commit(&rtype);
+   if (collective)
+   {
+      MPI_File_write_at_all(fh, (MPI_Offset) offset, buffer, count, rtype, MPI_STATUS_IGNORE);
+   }
+   else
+   {
+      MPI_File_write_at(fh, (MPI_Offset) offset, buffer, count, rtype, MPI_STATUS_IGNORE);
+   }
+   MPI_Type_free(&rtype);
+#else
+   fseek(fh, (long) offset, SEEK_SET);
+   fwrite(buffer, size, count, fh);
+#endif
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ * Read records from a binary file at a byte offset
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+_braid_FileReadAt(_braid_File   fh,
+                  braid_Int     collective,
+                  int64_t       offset,
+                  void         *buffer,
+                  braid_Int     count,
+                  braid_Int     size)
+{
+#ifndef braid_SEQUENTIAL
+   MPI_Datatype  rtype;
+
+   MPI_Type_contiguous(size, MPI_BYTE, &rtype);
+   MPI_Type_commit(&rtype);
+   if (collective)
+   {
+      MPI_File_read_at_all(fh, (MPI_Offset) offset, buffer, count, rtype, MPI_STATUS_IGNORE);
+   }
+   else
+   {
+      MPI_File_read_at(fh, (MPI_Offset) offset, buffer, count, rtype, MPI_STATUS_IGNORE);
+   }
+   MPI_Type_free(&rtype);
+#else
+   fseek(fh, (long) offset, SEEK_SET);
+   if (fread(buffer, size, count, fh) != (size_t) count)
+   {
+      _braid_Error(braid_ERROR_GENERIC, "Unexpected end of file");
+   }
+#endif
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ * Close a binary file
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+_braid_FileClose(_braid_File  *fh_ptr)
+{
+#ifndef braid_SEQUENTIAL
+   MPI_File_close(fh_ptr);
+#else
+   fclose(*fh_ptr);
+   *fh_ptr = NULL;
+#endif
+
+   return _braid_error_flag;
+}
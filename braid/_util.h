@@ -33,6 +33,7 @@
 #ifndef braid_util_HEADER
 #define braid_util_HEADER
 
+#include <stdint.h>
 #include "_braid.h"
 
 /**
@@ -99,5 +100,56 @@ _braid_GetNEntries(braid_Real   *_array,
                    braid_Real   *array);
 
 
+/**
+ * Handle of the binary files written with @ref _braid_FileWriteAt, MPI-IO
+ * unless built with braid_SEQUENTIAL
+ **/
+#ifndef braid_SEQUENTIAL
+typedef MPI_File _braid_File;
+#else
+typedef FILE    *_braid_File;
+#endif
+
+/**
+ * Collectively open the binary file *filename* on *comm*.  The *mode* is
+ * 0 for reading, 1 for writing a new (truncated) file, and 2 for writing
+ * into an existing file.  Returns braid_ERROR_GENERIC if the file cannot
+ * be opened.
+ **/
+braid_Int
+_braid_FileOpen(MPI_Comm      comm,
+                const char   *filename,
+                braid_Int     mode,
+                _braid_File  *fh_ptr);
+
+/**
+ * Write *count* records of *size* bytes from *buffer* at byte *offset*.  If
+ * *collective* is set, all processors that opened the file must call this.
+ **/
+braid_Int
+_braid_FileWriteAt(_braid_File   fh,
+                   braid_Int     collective,
+                   int64_t       offset,
+                   void         *buffer,
+                   braid_Int     count,
+                   braid_Int     size);
+
+/**
+ * Read *count* records of *size* bytes at byte *offset* into *buffer*.  If
+ * *collective* is set, all processors that opened the file must call this.
+ **/
+braid_Int
+_braid_FileReadAt(_braid_File   fh,
+                  braid_Int     collective,
+                  int64_t       offset,
+                  void         *buffer,
+                  braid_Int     count,
+                  braid_Int     size);
+
+/**
+ * Collectively close a file opened with @ref _braid_FileOpen
+ **/
+braid_Int
+_braid_FileClose(_braid_File  *fh_ptr);
 
 #endif
\ No newline at end of file
@@ -21,9 +21,15 @@
  *
  ***********************************************************************EHEADER*/
 
+#include <string.h>
 #include "_braid.h"
 #include "_util.h"
 
+/* Solution file layout: a 64 byte header, then one fixed-size record per fine
+ * grid point, each holding (double t, int64 index, int64 size, data) */
+#define _braid_SOLUTION_HEADER  64
+#define _braid_SOLUTION_RECHEAD 24
+
 /*----------------------------------------------------------------------------
  * Access to XBraid on grid level
  *----------------------------------------------------------------------------*/
@@ -45,15 +51,35 @@ _braid_FAccess(braid_Core     core,
    braid_Int              ncpoints     = _braid_GridElt(grids[level], ncpoints);
    braid_Real             *ta          = _braid_GridElt(grids[level], ta);
    braid_Int              ilower       = _braid_GridElt(grids[level], ilower);
+   braid_Int              iupper       = _braid_GridElt(grids[level], iupper);
 
    braid_Real        rnorm;
    braid_BaseVector  u;
    braid_Int         interval, flo, fhi, fi, ci;
+   braid_Int         write_sol, recsize, bulk;
+   char             *solution = NULL;
+   braid_BaseVector *ubulk    = NULL;
 
    _braid_UCommInitF(core, level);
    
    _braid_GetRNorm(core, -1, &rnorm);
 
+   /* Collect the final fine grid solution for the solution file */
+   write_sol = (done && level == 0 && _braid_CoreElt(core, sol_filename) != NULL);
+   if (write_sol)
+   {
+      _braid_SolutionRecordSize(core, &recsize);
+      solution = _braid_CTAlloc(char, (size_t)(iupper-ilower+1)*recsize);
+   }
+
+   /* Collect copies of the fine grid vectors for the bulk access routine */
+   bulk = ( (_braid_CoreElt(core, access_bulk) != NULL) && (access_level >= 1) &&
+            (level == 0) && !_braid_CoreElt(core, adjoint) );
+   if (bulk)
+   {
+      ubulk = _braid_CTAlloc(braid_BaseVector, _braid_max(iupper-ilower+1, 1));
+   }
+
    /* Start from the right-most interval */
    for (interval = ncpoints; interval > -1; interval--)
    {
@@ -69,13 +95,23 @@ _braid_FAccess(braid_Core     core,
          _braid_Step(core, level, fi, NULL, u);
          _braid_USetVector(core, level, fi, u, 0);
 
-         if (access_level >= 1)
+         if (bulk)
+         {
+            _braid_BaseClone(core, app, u, &ubulk[fi-ilower]);
+         }
+         else if (access_level >= 1)
          {
             _braid_AccessStatusInit( ta[fi-ilower], fi, ichunk,  rnorm, iter, level, nrefine, gupper,
                                      done, 0, braid_ASCaller_FAccess, astatus);
             _braid_AccessVector(core, astatus, u);
          }
 
+         if (write_sol)
+         {
+            _braid_SolutionRecordPack(core, solution + (size_t)(fi-ilower)*recsize,
+                                      fi, ta[fi-ilower], u);
+         }
+
          /* If time-serial run: Evaluate the user's local objective function at F-points on finest grid */
          if ( _braid_CoreElt(core, adjoint) && 
               _braid_CoreElt(core, max_levels <=1) ) 
@@ -110,13 +146,23 @@ _braid_FAccess(braid_Core     core,
       {
          _braid_UGetVectorRef(core, level, ci, &u);
 
-         if ( access_level >= 1 )
+         if (bulk)
+         {
+            _braid_BaseClone(core, app, u, &ubulk[ci-ilower]);
+         }
+         else if ( access_level >= 1 )
          {
             _braid_AccessStatusInit( ta[ci-ilower], ci, ichunk, rnorm, iter, level, nrefine, gupper,
                                      done, 0, braid_ASCaller_FAccess, astatus);
             _braid_AccessVector(core, astatus, u);
          }
 
+         if (write_sol)
+         {
+            _braid_SolutionRecordPack(core, solution + (size_t)(ci-ilower)*recsize,
+                                      ci, ta[ci-ilower], u);
+         }
+
          /* If time-serial: Evaluate the user's local objective function at CPoints on finest grid */
          if ( _braid_CoreElt(core, adjoint)   && 
               _braid_CoreElt(core, max_levels <=1) ) 
@@ -142,6 +188,70 @@ _braid_FAccess(braid_Core     core,
    }
    _braid_UCommWait(core, level);
 
+   if (bulk)
+   {
+      _braid_AccessBulk(core, level, done, braid_ASCaller_FAccess, ubulk);
+      for (fi = ilower; fi <= iupper; fi++)
+      {
+         _braid_BaseFree(core, app, ubulk[fi-ilower]);
+      }
+      _braid_TFree(ubulk);
+   }
+
+   if (write_sol)
+   {
+      _braid_SolutionWrite(core, solution, recsize);
+      _braid_TFree(solution);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Bulk access to all local vectors on grid level
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_AccessBulk(braid_Core         core,
+                  braid_Int          level,
+                  braid_Int          done,
+                  braid_Int          calling_function,
+                  braid_BaseVector  *u)
+{
+   braid_App              app          = _braid_CoreElt(core, app);
+   _braid_Grid          **grids        = _braid_CoreElt(core, grids);
+   braid_AccessStatus     astatus      = (braid_AccessStatus)core;
+   braid_Int              iter         = _braid_CoreElt(core, niter);
+   braid_Int              ichunk       = _braid_CoreElt(core, ichunk);
+   braid_Int              nrefine      = _braid_CoreElt(core, nrefine);
+   braid_Int              gupper       = _braid_CoreElt(core, gupper);
+   braid_Real            *ta           = _braid_GridElt(grids[level], ta);
+   braid_Int              ilower       = _braid_GridElt(grids[level], ilower);
+   braid_Int              iupper       = _braid_GridElt(grids[level], iupper);
+   braid_Int              nvectors     = _braid_max(iupper-ilower+1, 0);
+
+   braid_Real             rnorm;
+   braid_Vector          *uvec;
+   braid_Int             *idx;
+   braid_Int              i;
+
+   _braid_GetRNorm(core, -1, &rnorm);
+
+   uvec = _braid_CTAlloc(braid_Vector, _braid_max(nvectors, 1));
+   idx  = _braid_CTAlloc(braid_Int, _braid_max(nvectors, 1));
+   for (i = 0; i < nvectors; i++)
+   {
+      uvec[i] = u[i]->userVector;
+      idx[i]  = ilower+i + ichunk*gupper;
+   }
+
+   _braid_AccessStatusInit(ta[0], ilower, ichunk, rnorm, iter, level, nrefine, gupper,
+                           done, 0, calling_function, astatus);
+   _braid_CoreElt(core, access_bulk)(app, nvectors, uvec, ta, idx, astatus);
+
+   _braid_TFree(uvec);
+   _braid_TFree(idx);
+
    return _braid_error_flag;
 }
 
@@ -163,7 +273,9 @@ _braid_TriAccess(braid_Core     core,
 
    braid_Real             rnorm;
    braid_BaseVector       u;
-   braid_Int              i;
+   braid_Int              i, write_sol, recsize;
+   char                  *solution = NULL;
+   braid_BaseVector      *ubulk;
 
    _braid_GetRNorm(core, -1, &rnorm);
 
@@ -174,7 +286,18 @@ _braid_TriAccess(braid_Core     core,
    _braid_StatusElt(astatus, wrapper_test)     = 0;
    _braid_StatusElt(astatus, calling_function) = braid_ASCaller_TriAccess;
 
-   if (access_level >= 1)
+   if ( (access_level >= 1) && (_braid_CoreElt(core, access_bulk) != NULL) && (level == 0) )
+   {
+      /* All points are stored, so hand out references */
+      ubulk = _braid_CTAlloc(braid_BaseVector, _braid_max(iupper-ilower+1, 1));
+      for (i = ilower; i <= iupper; i++)
+      {
+         _braid_UGetVectorRef(core, level, i, &ubulk[i-ilower]);
+      }
+      _braid_AccessBulk(core, level, done, braid_ASCaller_TriAccess, ubulk);
+      _braid_TFree(ubulk);
+   }
+   else if (access_level >= 1)
    {
       for (i = ilower; i <= iupper; i++)
       {
@@ -187,6 +310,133 @@ _braid_TriAccess(braid_Core     core,
       }
    }
 
+   /* Write the final fine grid solution to the solution file */
+   write_sol = (done && level == 0 && _braid_CoreElt(core, sol_filename) != NULL);
+   if (write_sol)
+   {
+      _braid_SolutionRecordSize(core, &recsize);
+      solution = _braid_CTAlloc(char, (size_t)(iupper-ilower+1)*recsize);
+      for (i = ilower; i <= iupper; i++)
+      {
+         _braid_UGetVectorRef(core, level, i, &u);
+         _braid_SolutionRecordPack(core, solution + (size_t)(i-ilower)*recsize,
+                                   i, ta[i-ilower], u);
+      }
+      _braid_SolutionWrite(core, solution, recsize);
+      _braid_TFree(solution);
+   }
+
+   return _braid_error_flag;
+}
+
+
+/*----------------------------------------------------------------------------
+ * Size of one record in the solution file
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_SolutionRecordSize(braid_Core   core,
+                          braid_Int   *recsize_ptr)
+{
+   braid_App           app     = _braid_CoreElt(core, app);
+   braid_BufferStatus  bstatus = (braid_BufferStatus)core;
+   braid_Int           size;
+
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_CoreFcn(core, bufsize)(app, &size, bstatus);
+
+   /* Keep the records 8 byte aligned */
+   size = 8*((size + 7)/8);
+   *recsize_ptr = _braid_SOLUTION_RECHEAD + size;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Pack one vector into a solution file record
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_SolutionRecordPack(braid_Core        core,
+                          void             *record,
+                          braid_Int         index,
+                          braid_Real        t,
+                          braid_BaseVector  u)
+{
+   braid_App           app     = _braid_CoreElt(core, app);
+   braid_BufferStatus  bstatus = (braid_BufferStatus)core;
+   braid_Int           ntime   = _braid_CoreElt(core, gupper);
+   braid_Int           ichunk  = _braid_CoreElt(core, ichunk);
+   char               *rec     = (char *) record;
+   braid_Int           size;
+   double              t64;
+   int64_t             index64, size64;
+
+   /* Call the user's BufPack directly, so nothing is recorded for the adjoint */
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_CoreFcn(core, bufsize)(app, &size, bstatus);
+   _braid_StatusElt(bstatus, size_buffer) = size;
+   _braid_CoreFcn(core, bufpack)(app, u->userVector, rec + _braid_SOLUTION_RECHEAD, bstatus);
+   size = _braid_StatusElt(bstatus, size_buffer);
+
+   /* Index over all chunks (the first point of a chunk is the last of the previous) */
+   t64     = (double) t;
+   index64 = (int64_t) ichunk*ntime + index;
+   size64  = (int64_t) size;
+   memcpy(rec,      &t64,     8);
+   memcpy(rec + 8,  &index64, 8);
+   memcpy(rec + 16, &size64,  8);
+
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Write the local solution records to the solution file
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_SolutionWrite(braid_Core   core,
+                     void        *buffer,
+                     braid_Int    recsize)
+{
+   MPI_Comm      comm     = _braid_CoreElt(core, comm);
+   braid_Int     myid     = _braid_CoreElt(core, myid);
+   char         *filename = _braid_CoreElt(core, sol_filename);
+   braid_Int     ntime    = _braid_CoreElt(core, gupper);
+   braid_Int     ichunk   = _braid_CoreElt(core, ichunk);
+   braid_Int     nchunks  = _braid_CoreElt(core, nchunks);
+   _braid_Grid **grids    = _braid_CoreElt(core, grids);
+   braid_Int     ilower   = _braid_GridElt(grids[0], ilower);
+   braid_Int     iupper   = _braid_GridElt(grids[0], iupper);
+   braid_Int     nlocal   = iupper - ilower + 1;
+
+   _braid_File   fh;
+   int64_t       header[_braid_SOLUTION_HEADER/8];
+   int64_t       offset;
+
+   /* Header: magic, version, number of records, record size, data size */
+   memset(header, 0, _braid_SOLUTION_HEADER);
+   memcpy(header, "XBRDSOL", 8);
+   header[1] = 1;
+   header[2] = (int64_t) nchunks*ntime + 1;
+   header[3] = (int64_t) recsize;
+   header[4] = (int64_t) recsize - _braid_SOLUTION_RECHEAD;
+
+   offset = _braid_SOLUTION_HEADER + ((int64_t) ichunk*ntime + ilower)*recsize;
+
+   /* The first chunk creates the file */
+   if (_braid_FileOpen(comm, filename, (ichunk == 0) ? 1 : 2, &fh))
+   {
+      return _braid_error_flag;
+   }
+   if (myid == 0)
+   {
+      _braid_FileWriteAt(fh, 0, 0, header, 1, _braid_SOLUTION_HEADER);
+   }
+
+   /* One collective write of the contiguous local records */
+   _braid_FileWriteAt(fh, 1, offset, buffer, nlocal, recsize);
+   _braid_FileClose(&fh);
+
+   return _braid_error_flag;
+}
@@ -0,0 +1,385 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory. Written by
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+#include <float.h>
+#include <math.h>
+#include "_braid.h"
+#include "_util.h"
+
+/* Anderson acceleration of the cycles. A cycle maps the vectors stored on
+ * level 0 (the C-points, or all points), x, to g(x).  With the residual
+ * f = g(x) - x of the last cycles and the differences dF, dG of f and g over
+ * the last kdim cycles, the next iterate is
+ *
+ *    x_new = g(x) - dG gamma,   gamma = argmin || f - dF gamma ||,
+ *
+ * where the least-squares problem is solved with a QR factorization of dF by
+ * Gram-Schmidt.  This is Anderson acceleration with a window of kdim cycles,
+ * the oldest difference being dropped once the window is full.  For an affine
+ * cycle (linear problem), and only until the window is full, the iterates are
+ * those of GMRES on the MGRIT-preconditioned system; after that it is not
+ * GMRES (neither full nor restarted).  A space-time vector is an array of the
+ * local stored vectors. */
+
+/*----------------------------------------------------------------------------
+ * Space-time inner products prods[j] = (X[j], y) for j < n, with one reduction
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_AndersonDot(braid_Core          core,
+                   braid_Int           n,
+                   braid_BaseVector  **X,
+                   braid_BaseVector   *y,
+                   braid_Real         *prods)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   MPI_Comm           comm     = _braid_CoreElt(core, comm);
+   _braid_Anderson   *anderson = _braid_CoreElt(core, anderson);
+   braid_Int          npoints  = _braid_AndersonElt(anderson, npoints);
+
+   braid_Real        *local;
+   braid_Real         prod;
+   braid_Int          j, p;
+
+   local = _braid_CTAlloc(braid_Real, n);
+   for (j = 0; j < n; j++)
+   {
+      for (p = 0; p < npoints; p++)
+      {
+         _braid_BaseInnerProd(core, app, X[j][p], y[p], &prod);
+         local[j] += prod;
+      }
+   }
+   MPI_Allreduce(local, prods, n, braid_MPI_REAL, MPI_SUM, comm);
+   _braid_TFree(local);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * y = alpha x + beta y for space-time vectors
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_AndersonSum(braid_Core         core,
+                   braid_Real         alpha,
+                   braid_BaseVector  *x,
+                   braid_Real         beta,
+                   braid_BaseVector  *y)
+{
+   braid_App          app     = _braid_CoreElt(core, app);
+   braid_Int          npoints = _braid_AndersonElt(_braid_CoreElt(core, anderson), npoints);
+   braid_Int          p;
+
+   for (p = 0; p < npoints; p++)
+   {
+      _braid_BaseSum(core, app, alpha, x[p], beta, y[p]);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Return a new space-time vector, a copy of x
+ *----------------------------------------------------------------------------*/
+
+static braid_BaseVector *
+_braid_AndersonClone(braid_Core         core,
+                     braid_BaseVector  *x)
+{
+   braid_App          app     = _braid_CoreElt(core, app);
+   braid_Int          npoints = _braid_AndersonElt(_braid_CoreElt(core, anderson), npoints);
+   braid_BaseVector  *y;
+   braid_Int          p;
+
+   y = _braid_CTAlloc(braid_BaseVector, npoints);
+   for (p = 0; p < npoints; p++)
+   {
+      _braid_BaseClone(core, app, x[p], &y[p]);
+   }
+
+   return y;
+}
+
+/*----------------------------------------------------------------------------
+ * Free the space-time vector x (if not NULL)
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_AndersonFree(braid_Core         core,
+                    braid_BaseVector  *x)
+{
+   braid_App          app     = _braid_CoreElt(core, app);
+   braid_Int          npoints = _braid_AndersonElt(_braid_CoreElt(core, anderson), npoints);
+   braid_Int          p;
+
+   if (x)
+   {
+      for (p = 0; p < npoints; p++)
+      {
+         _braid_BaseFree(core, app, x[p]);
+      }
+      _braid_TFree(x);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Drop column j of dF and dG
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_AndersonDrop(braid_Core  core,
+                    braid_Int   j)
+{
+   _braid_Anderson    *anderson = _braid_CoreElt(core, anderson);
+   braid_BaseVector  **dF       = _braid_AndersonElt(anderson, dF);
+   braid_BaseVector  **dG       = _braid_AndersonElt(anderson, dG);
+   braid_Int           ncols    = _braid_AndersonElt(anderson, ncols);
+   braid_Int           k;
+
+   _braid_AndersonFree(core, dF[j]);
+   _braid_AndersonFree(core, dG[j]);
+   for (k = j; k < ncols-1; k++)
+   {
+      dF[k] = dF[k+1];
+      dG[k] = dG[k+1];
+   }
+   dF[ncols-1] = NULL;
+   dG[ncols-1] = NULL;
+   _braid_AndersonElt(anderson, ncols) = ncols-1;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Gather the vectors stored on level 0 in u (as references)
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_AndersonGetU(braid_Core         core,
+                    braid_BaseVector  *u)
+{
+   _braid_Anderson    *anderson = _braid_CoreElt(core, anderson);
+   braid_Int           npoints  = _braid_AndersonElt(anderson, npoints);
+   braid_Int          *index    = _braid_AndersonElt(anderson, index);
+   braid_Int           p;
+
+   for (p = 0; p < npoints; p++)
+   {
+      _braid_UGetVectorRef(core, 0, index[p], &u[p]);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Replace the result of the last cycle (the vectors stored on level 0) with
+ * the Anderson-accelerated iterate. The first call only saves the iterate.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_AndersonUpdate(braid_Core  core)
+{
+   braid_Int           kdim     = _braid_CoreElt(core, anderson_dim);
+   braid_Int           ortho    = _braid_CoreElt(core, anderson_ortho);
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   braid_Int           ilower   = _braid_GridElt(grids[0], ilower);
+   braid_Int           iupper   = _braid_GridElt(grids[0], iupper);
+   _braid_Anderson    *anderson = _braid_CoreElt(core, anderson);
+
+   braid_BaseVector  **dF, **dG, **Q;
+   braid_BaseVector   *u, *f, *x;
+   braid_Real         *R, *h, *gamma, *fnorms;
+   braid_BaseVector    v;
+   braid_Int           npoints, ncols, nr, i, j, k, pass, npass;
+
+   if (anderson == NULL)
+   {
+      /* Save the initial iterate */
+      anderson = _braid_CTAlloc(_braid_Anderson, 1);
+      _braid_CoreElt(core, anderson) = anderson;
+      _braid_AndersonElt(anderson, index) = _braid_CTAlloc(braid_Int, _braid_max(iupper-ilower+1, 1));
+      npoints = 0;
+      for (i = ilower; i <= iupper; i++)
+      {
+         _braid_UGetVectorRef(core, 0, i, &v);
+         if (v != NULL)
+         {
+            _braid_AndersonElt(anderson, index)[npoints++] = i;
+         }
+      }
+      _braid_AndersonElt(anderson, npoints) = npoints;
+      _braid_AndersonElt(anderson, dF)  = _braid_CTAlloc(braid_BaseVector *, kdim);
+      _braid_AndersonElt(anderson, dG)  = _braid_CTAlloc(braid_BaseVector *, kdim);
+      u = _braid_CTAlloc(braid_BaseVector, npoints);
+      _braid_AndersonGetU(core, u);
+      _braid_AndersonElt(anderson, x) = _braid_AndersonClone(core, u);
+      _braid_TFree(u);
+
+      return _braid_error_flag;
+   }
+
+   npoints = _braid_AndersonElt(anderson, npoints);
+   dF      = _braid_AndersonElt(anderson, dF);
+   dG      = _braid_AndersonElt(anderson, dG);
+   x       = _braid_AndersonElt(anderson, x);
+
+   /* Residual of the cycle f = g - x, with g the result of the cycle */
+   u = _braid_CTAlloc(braid_BaseVector, npoints);
+   _braid_AndersonGetU(core, u);
+   f = _braid_AndersonClone(core, u);
+   _braid_AndersonSum(core, -1.0, x, 1.0, f);
+
+   /* Append the differences to the last cycle, dropping the oldest */
+   if (_braid_AndersonElt(anderson, f) != NULL)
+   {
+      if (_braid_AndersonElt(anderson, ncols) == kdim)
+      {
+         _braid_AndersonDrop(core, 0);
+      }
+      ncols = _braid_AndersonElt(anderson, ncols);
+      dF[ncols] = _braid_AndersonElt(anderson, f);
+      dG[ncols] = _braid_AndersonElt(anderson, g);
+      _braid_AndersonSum(core, 1.0, f, -1.0, dF[ncols]);
+      _braid_AndersonSum(core, 1.0, u, -1.0, dG[ncols]);
+      _braid_AndersonElt(anderson, ncols) = ncols+1;
+   }
+   _braid_AndersonElt(anderson, f) = f;
+   _braid_AndersonElt(anderson, g) = _braid_AndersonClone(core, u);
+
+   /* QR factorization of dF by Gram-Schmidt: modified (0), classical (1), or
+    * classical with reorthogonalization (2).  Nearly dependent columns are
+    * dropped. */
+   ncols  = _braid_AndersonElt(anderson, ncols);
+   nr     = _braid_max(ncols, 1);
+   Q      = _braid_CTAlloc(braid_BaseVector *, nr);
+   R      = _braid_CTAlloc(braid_Real, nr*nr);
+   h      = _braid_CTAlloc(braid_Real, nr);
+   fnorms = _braid_CTAlloc(braid_Real, 1);
+   npass  = (ortho == 2) ? 2 : 1;
+   for (j = 0; j < ncols; j++)
+   {
+      Q[j] = _braid_AndersonClone(core, dF[j]);
+      _braid_AndersonDot(core, 1, &Q[j], Q[j], fnorms);
+      for (pass = 0; pass < npass; pass++)
+      {
+         if (ortho == 0)
+         {
+            for (k = 0; k < j; k++)
+            {
+               _braid_AndersonDot(core, 1, &Q[k], Q[j], &h[k]);
+               _braid_AndersonSum(core, -h[k], Q[k], 1.0, Q[j]);
+               R[k*nr+j] += h[k];
+            }
+         }
+         else if (j > 0)
+         {
+            _braid_AndersonDot(core, j, Q, Q[j], h);
+            for (k = 0; k < j; k++)
+            {
+               _braid_AndersonSum(core, -h[k], Q[k], 1.0, Q[j]);
+               R[k*nr+j] += h[k];
+            }
+         }
+      }
+      _braid_AndersonDot(core, 1, &Q[j], Q[j], &R[j*nr+j]);
+      R[j*nr+j] = sqrt(R[j*nr+j]);
+      if ( R[j*nr+j] <= sqrt(DBL_EPSILON)*sqrt(fnorms[0]) )
+      {
+         /* Drop the column and redo this one */
+         _braid_AndersonFree(core, Q[j]);
+         _braid_AndersonDrop(core, j);
+         for (k = 0; k <= j; k++)
+         {
+            R[k*nr+j] = 0.0;
+         }
+         ncols--;
+         j--;
+         continue;
+      }
+      _braid_AndersonSum(core, 0.0, Q[j], 1.0/R[j*nr+j], Q[j]);
+   }
+
+   /* gamma = R^{-1} Q^T f, then x = g - dG gamma */
+   if (ncols > 0)
+   {
+      gamma = _braid_CTAlloc(braid_Real, ncols);
+      _braid_AndersonDot(core, ncols, Q, f, h);
+      for (j = ncols-1; j >= 0; j--)
+      {
+         gamma[j] = h[j];
+         for (k = j+1; k < ncols; k++)
+         {
+            gamma[j] -= R[j*nr+k]*gamma[k];
+         }
+         gamma[j] /= R[j*nr+j];
+      }
+      for (j = 0; j < ncols; j++)
+      {
+         _braid_AndersonSum(core, -gamma[j], dG[j], 1.0, u);
+         _braid_AndersonFree(core, Q[j]);
+      }
+      _braid_TFree(gamma);
+   }
+   _braid_AndersonSum(core, 1.0, u, 0.0, x);
+
+   _braid_TFree(Q);
+   _braid_TFree(R);
+   _braid_TFree(h);
+   _braid_TFree(fnorms);
+   _braid_TFree(u);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Free the Anderson acceleration data
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_AndersonDestroy(braid_Core  core)
+{
+   _braid_Anderson  *anderson = _braid_CoreElt(core, anderson);
+   braid_Int         j;
+
+   if (anderson)
+   {
+      for (j = 0; j < _braid_AndersonElt(anderson, ncols); j++)
+      {
+         _braid_AndersonFree(core, _braid_AndersonElt(anderson, dF)[j]);
+         _braid_AndersonFree(core, _braid_AndersonElt(anderson, dG)[j]);
+      }
+      _braid_AndersonFree(core, _braid_AndersonElt(anderson, x));
+      _braid_AndersonFree(core, _braid_AndersonElt(anderson, f));
+      _braid_AndersonFree(core, _braid_AndersonElt(anderson, g));
+      _braid_TFree(_braid_AndersonElt(anderson, dF));
+      _braid_TFree(_braid_AndersonElt(anderson, dG));
+      _braid_TFree(_braid_AndersonElt(anderson, index));
+      _braid_TFree(anderson);
+      _braid_CoreElt(core, anderson) = NULL;
+   }
+
+   return _braid_error_flag;
+}
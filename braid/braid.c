@@ -26,6 +26,7 @@
  *
  */
 
+#include <string.h>
 #include "_braid.h"
 #include "_util.h"
 
@@ -55,10 +56,17 @@ braid_Drive(braid_Core  core)
    braid_Real     dt_chunk;
    braid_Real     localtime, globaltime;
    braid_Int      level, ilower, iupper, i;
+   const char    *bench_filename;
 
    /* Check for non-supported features */
    _braid_FeatureCheck(core);
 
+   /* Set up the shared-memory exchange with time neighbors */
+   if (_braid_CoreElt(core, shmcomm))
+   {
+      _braid_ShmCommInit(core);
+   }
+
    /* Some initial output */
    if (myid == 0 )
    {
@@ -87,6 +95,14 @@ braid_Drive(braid_Core  core)
    _braid_CoreElt(core, gupper)   = _braid_CoreElt(core, ntime);
    dt_chunk = (tstop0 - tstart0 ) / nchunks;
 
+   /* Count the user calls, vectors and allocations of this call, including
+    * the setup below */
+   _braid_TFree(_braid_CoreElt(core, ncalls));
+   _braid_CoreElt(core, ncalls)        = _braid_CTAlloc(braid_Real, _braid_NCALLS);
+   _braid_CoreElt(core, nvectors_peak) = _braid_CoreElt(core, nvectors);
+   _braid_CoreElt(core, alloc_bytes0)  = _braid_alloc_bytes;
+   _braid_CoreElt(core, alloc_count0)  = _braid_alloc_count;
+
    /* Allocate and initialize grids */
    if ( !warm_restart )
    {
@@ -115,6 +131,11 @@ braid_Drive(braid_Core  core)
       /* Set initial values */
       _braid_InitGuess(core, 0);
    }
+   else if (_braid_CoreElt(core, reuse) != 1)
+   {
+      /* Start from init again, or keep the FAS right-hand sides */
+      _braid_WarmRestart(core);
+   }
 
    /* Initialize sensitivity computation */
    if ( adjoint )
@@ -149,6 +170,15 @@ braid_Drive(braid_Core  core)
     * initialize the grid and adjoint again. */
    _braid_CoreElt(core, warm_restart) = 1;
 
+   /* Allocate the phase timers and communication counters (max_levels may
+    * change between calls) */
+   _braid_TFree(_braid_CoreElt(core, phase_times));
+   _braid_TFree(_braid_CoreElt(core, comm_volume));
+   _braid_CoreElt(core, phase_times) =
+      _braid_CTAlloc(braid_Real, _braid_CoreElt(core, max_levels)*_braid_NPHASES);
+   _braid_CoreElt(core, comm_volume) =
+      _braid_CTAlloc(braid_Real, _braid_CoreElt(core, max_levels)*2);
+
    /* Start timer */
    localtime = MPI_Wtime();
 
@@ -169,6 +199,16 @@ braid_Drive(braid_Core  core)
                        _braid_CoreElt(core,ntime));
       }
 
+      /* Time the phases of each chunk separately */
+      for (i = 0; i < _braid_CoreElt(core, max_levels)*_braid_NPHASES; i++)
+      {
+         _braid_CoreElt(core, phase_times)[i] = 0.0;
+      }
+      for (i = 0; i < _braid_CoreElt(core, max_levels)*2; i++)
+      {
+         _braid_CoreElt(core, comm_volume)[i] = 0.0;
+      }
+
       /* Initialize the chunk */
       if ( ichunk > 0 )
       {
@@ -211,6 +251,17 @@ braid_Drive(braid_Core  core)
       {
          braid_PrintStats(core);
       }
+
+      /* Append a benchmark record for this run */
+      bench_filename = _braid_CoreElt(core, bench_filename);
+      if (bench_filename == NULL)
+      {
+         bench_filename = getenv("BRAID_BENCH_FILE");
+      }
+      if (bench_filename != NULL)
+      {
+         _braid_WriteBenchRecord(core, bench_filename);
+      }
    }
 
    return _braid_error_flag;
@@ -302,8 +353,20 @@ braid_Init(MPI_Comm               comm_world,
    _braid_CoreElt(core, scoarsen)        = NULL;
    _braid_CoreElt(core, srefine)         = NULL;
    _braid_CoreElt(core, tgrid)           = NULL;
+   _braid_CoreElt(core, bufcompress)     = NULL;
+   _braid_CoreElt(core, bufdecompress)   = NULL;
+   _braid_CoreElt(core, bufdescribe)     = NULL;
+   _braid_CoreElt(core, lp_demote)       = NULL;
+   _braid_CoreElt(core, lp_promote)      = NULL;
+   _braid_CoreElt(core, lp_step)         = NULL;
+   _braid_CoreElt(core, lp_clone)        = NULL;
+   _braid_CoreElt(core, lp_free)         = NULL;
+   _braid_CoreElt(core, lp_sum)          = NULL;
+   _braid_CoreElt(core, lp_bufpack)      = NULL;
+   _braid_CoreElt(core, lp_bufunpack)    = NULL;
 
    _braid_CoreElt(core, access_level)    = access_level;
+   _braid_CoreElt(core, access_bulk)     = NULL;           /* access one point at a time */
    _braid_CoreElt(core, tnorm)           = tnorm;
    _braid_CoreElt(core, print_level)     = print_level;
    _braid_CoreElt(core, io_level)        = io_level;
@@ -313,6 +376,8 @@ braid_Init(MPI_Comm               comm_world,
    _braid_CoreElt(core, tol)             = tol;
    _braid_CoreElt(core, rtol)            = rtol;
    _braid_CoreElt(core, warm_restart)    = warm_restart;
+   _braid_CoreElt(core, reuse)           = 1;             /* Warm restarts start from the previous solution */
+   _braid_CoreElt(core, reuse_tau)       = 0;
 
    _braid_CoreElt(core, nrels)           = NULL; /* Set with SetMaxLevels() below */
    _braid_CoreElt(core, nrdefault)       = nrdefault;
@@ -325,8 +390,42 @@ braid_Init(MPI_Comm               comm_world,
    _braid_CoreElt(core, fmg)             = fmg;
    _braid_CoreElt(core, nfmg)            = nfmg;
    _braid_CoreElt(core, nfmg_Vcyc)       = nfmg_Vcyc;
+   _braid_CoreElt(core, nested_vcyc)     = 0;            /* No nested iteration startup */
+
+   _braid_CoreElt(core, compress_level)   = -1;           /* No message compression */
+   _braid_CoreElt(core, compress_rfactor) = 1.0e+02;
+   _braid_CoreElt(core, prec_level)       = 0;            /* One precision on all levels */
+   _braid_CoreElt(core, delta_rank)       = 0;            /* No Delta correction */
+   _braid_CoreElt(core, innerprod)        = NULL;
+   _braid_CoreElt(core, anderson_dim)     = 0;            /* No Anderson acceleration */
+   _braid_CoreElt(core, anderson_ortho)   = 0;            /* Modified Gram-Schmidt */
+   _braid_CoreElt(core, step_begin)       = NULL;         /* Synchronous steps */
+   _braid_CoreElt(core, step_poll)        = NULL;
+   _braid_CoreElt(core, step_finish)      = NULL;
+
+   _braid_CoreElt(core, shmcomm)         = 0;             /* Only MPI messages */
+   _braid_CoreElt(core, shm_active)      = 0;
+   _braid_CoreElt(core, shm_left)        = -1;
+   _braid_CoreElt(core, shm_right)       = -1;
+   _braid_CoreElt(core, shm_recv_slot)   = NULL;
+   _braid_CoreElt(core, shm_send_slot)   = NULL;
+   _braid_CoreElt(core, shm_recvs)       = NULL;
+
+   _braid_CoreElt(core, sol_filename)    = NULL;          /* No solution file */
+   _braid_CoreElt(core, bench_filename)  = NULL;          /* No benchmark file */
+   _braid_CoreElt(core, phase_times)     = NULL;
+   _braid_CoreElt(core, comm_volume)     = NULL;
+   _braid_CoreElt(core, ncalls)          = NULL;
+   _braid_CoreElt(core, nvectors)        = 0;
+   _braid_CoreElt(core, nvectors_peak)   = 0;
+   _braid_CoreElt(core, alloc_bytes0)    = 0.0;
+   _braid_CoreElt(core, alloc_count0)    = 0.0;
 
    _braid_CoreElt(core, storage)         = -1;            /* only store C-points */
+   _braid_CoreElt(core, memory_budget)   = 0.0;           /* no memory budget */
+   _braid_CoreElt(core, level_memory)    = NULL;
+   _braid_CoreElt(core, compress_storage) = 0;            /* no compressed storage */
+   _braid_CoreElt(core, storage_ratio)   = 0.0;
    _braid_CoreElt(core, useshell)         = 0;
 
    _braid_CoreElt(core, gupper)          = ntime;
@@ -344,6 +443,11 @@ braid_Init(MPI_Comm               comm_world,
 
    _braid_CoreElt(core, skip)            = skip;
 
+   _braid_CoreElt(core, frozen_tol)      = 0.0;  /* Frozen regions off by default */
+   _braid_CoreElt(core, frozen_index)    = 0;
+   _braid_CoreElt(core, frozen_rnorm)    = 0.0;
+   _braid_CoreElt(core, frozen_full_rnorm) = 0.0;
+
    _braid_CoreElt(core, adjoint)               = adjoint;
    _braid_CoreElt(core, record)                = record;
    _braid_CoreElt(core, obj_only)              = obj_only;
@@ -365,6 +469,8 @@ braid_Init(MPI_Comm               comm_world,
    _braid_CoreElt(core, full_rnorm_res)      = NULL;
    _braid_CoreElt(core, full_rnorm0)         = braid_INVALID_RNORM;
    _braid_CoreElt(core, full_rnorms)         = NULL; /* Set with SetMaxIter() below */
+   _braid_CoreElt(core, full_rnorm_freq)     = 1;
+   _braid_CoreElt(core, full_tnorm_a)        = NULL;
    _braid_CoreElt(core, old_fine_tolx)       = -1.0;
    _braid_CoreElt(core, tight_fine_tolx)     = 1;
 
@@ -472,6 +578,8 @@ braid_InitTriMGRIT(MPI_Comm               comm_world,
    _braid_CoreElt(core, trimgrit)    = 1;
    _braid_CoreElt(core, triresidual) = triresidual;
    _braid_CoreElt(core, trisolve)    = trisolve;
+   _braid_CoreElt(core, newton_lag)  = 1;
+   _braid_CoreElt(core, newton_clag) = 1;
 
    /* These are the only values currently supported for TriMGRIT */
    _braid_CoreElt(core, nchunks)  = 1;
@@ -488,6 +596,38 @@ braid_InitTriMGRIT(MPI_Comm               comm_world,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetTriNewton(braid_Core               core,
+                   braid_PtFcnTriLinearize  linearize,
+                   braid_PtFcnTriLinFree    linfree,
+                   braid_Int                start,
+                   braid_Int                lag,
+                   braid_Int                clag)
+{
+   _braid_CoreElt(core, trilinearize) = linearize;
+   _braid_CoreElt(core, trilinfree)   = linfree;
+   _braid_CoreElt(core, newton_start) = start;
+   _braid_CoreElt(core, newton_lag)   = _braid_max(lag, 1);
+   _braid_CoreElt(core, newton_clag)  = _braid_max(clag, 1);
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetTriDirect(braid_Core  core,
+                   braid_Int   direct)
+{
+   _braid_CoreElt(core, tridirect) = direct;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -507,6 +647,13 @@ braid_Destroy(braid_Core  core)
       _braid_TFree(_braid_CoreElt(core, cfactors));
       _braid_TFree(_braid_CoreElt(core, rfactors));
       _braid_TFree(_braid_CoreElt(core, tnorm_a));
+      _braid_TFree(_braid_CoreElt(core, full_tnorm_a));
+      _braid_TFree(_braid_CoreElt(core, level_memory));
+      _braid_TFree(_braid_CoreElt(core, sol_filename));
+      _braid_TFree(_braid_CoreElt(core, bench_filename));
+      _braid_TFree(_braid_CoreElt(core, phase_times));
+      _braid_TFree(_braid_CoreElt(core, comm_volume));
+      _braid_TFree(_braid_CoreElt(core, ncalls));
 
       /* Destroy the optimization structure */
       _braid_CoreElt(core, record) = 0;
@@ -532,6 +679,8 @@ braid_Destroy(braid_Core  core)
 
       _braid_TFree(grids);
 
+      _braid_ShmCommDestroy(core);
+
       _braid_TFree(core);
    }
 
@@ -573,6 +722,10 @@ braid_PrintStats(braid_Core  core)
    braid_Int     access_level  = _braid_CoreElt(core, access_level);
    braid_Int     print_level   = _braid_CoreElt(core, print_level);
    braid_Int     skip          = _braid_CoreElt(core, skip);
+   braid_Real    frozen_tol    = _braid_CoreElt(core, frozen_tol);
+   braid_Int     frozen_index  = _braid_CoreElt(core, frozen_index);
+   braid_Int     compress      = _braid_CoreElt(core, compress_level);
+   braid_Int     prec_level    = _braid_CoreElt(core, prec_level);
    braid_Real    globaltime    = _braid_CoreElt(core, globaltime);
    braid_PtFcnResidual fullres = _braid_CoreElt(core, full_rnorm_res);
    _braid_Grid **grids         = _braid_CoreElt(core, grids);
@@ -604,6 +757,43 @@ braid_PrintStats(braid_Core  core)
       _braid_printf("\n");
       _braid_printf("  use seq soln?         = %d\n", seq_soln);
       _braid_printf("  storage               = %d\n", storage);
+      if (_braid_CoreElt(core, memory_budget) > 0.0)
+      {
+         _braid_printf("  memory budget         = %1.2e bytes\n", _braid_CoreElt(core, memory_budget));
+      }
+      if (_braid_CoreElt(core, compress_storage) > 0)
+      {
+         _braid_printf("  compress storage      = %d\n", _braid_CoreElt(core, compress_storage));
+      }
+      if (compress > -1)
+      {
+         _braid_printf("  compress comm level   = %d\n", compress);
+      }
+      if (prec_level > 0)
+      {
+         _braid_printf("  coarse prec level     = %d\n", prec_level);
+      }
+      if (_braid_CoreElt(core, delta_rank) > 0)
+      {
+         _braid_printf("  Delta correction rank = %d\n", _braid_CoreElt(core, delta_rank));
+      }
+      if (_braid_CoreElt(core, step_begin) != NULL)
+      {
+         _braid_printf("  async steps           = 1\n");
+      }
+      if (_braid_CoreElt(core, tridirect))
+      {
+         _braid_printf("  direct coarse solve   = 1\n");
+      }
+      if (_braid_CoreElt(core, anderson_dim) > 0)
+      {
+         _braid_printf("  Anderson dim (ortho)  = %d (%d)\n",
+                       _braid_CoreElt(core, anderson_dim), _braid_CoreElt(core, anderson_ortho));
+      }
+      if (_braid_CoreElt(core, shmcomm))
+      {
+         _braid_printf("  shared-memory comm    = %d\n", _braid_CoreElt(core, shmcomm));
+      }
       _braid_printf("\n");
 
       _braid_printf("  max iterations        = %d\n", max_iter);
@@ -642,6 +832,10 @@ braid_PrintStats(braid_Core  core)
       {
          _braid_GetFullRNorm(core, -1, &rnorm);
          _braid_printf("  Global res 2-norm     = %e\n", rnorm);
+         if (_braid_CoreElt(core, full_rnorm_freq) > 1)
+         {
+            _braid_printf("  full res frequency    = %d\n", _braid_CoreElt(core, full_rnorm_freq));
+         }
       }
 
       _braid_printf("\n");
@@ -658,12 +852,25 @@ braid_PrintStats(braid_Core  core)
             _braid_printf("  fmg-cycles for all iteratons\n");
          }
       }
+      if (_braid_CoreElt(core, nested_vcyc) > 0)
+      {
+         _braid_printf("  V-cycles / nested lvl = %d\n", _braid_CoreElt(core, nested_vcyc));
+      }
       _braid_printf("  access_level          = %d\n", access_level);
+      if (_braid_CoreElt(core, access_bulk) != NULL)
+      {
+         _braid_printf("  bulk access           = 1\n");
+      }
       _braid_printf("  print_level           = %d\n\n", print_level);
       _braid_printf("  max number of levels  = %d\n", max_levels);
       _braid_printf("  min coarse            = %d\n", min_coarse);
       _braid_printf("  number of levels      = %d\n", nlevels);
       _braid_printf("  skip down cycle       = %d\n", skip);
+      if (frozen_tol > 0.0)
+      {
+         _braid_printf("  frozen region tol     = %1.2e\n", frozen_tol);
+         _braid_printf("  frozen time-pts       = %d\n", frozen_index);
+      }
       _braid_printf("  number of refinements = %d\n", nrefine);
       _braid_printf("\n");
       _braid_printf("  level   time-pts   cfactor   nrelax\n");
@@ -677,6 +884,26 @@ braid_PrintStats(braid_Core  core)
       _braid_printf("  % 5d  % 8d  \n",
                     level, _braid_GridElt(grids[level], gupper) );
       _braid_printf("\n");
+      if (_braid_CoreElt(core, level_memory) != NULL)
+      {
+         braid_Real  *level_memory = _braid_CoreElt(core, level_memory);
+
+         _braid_printf("  level   stored    peak memory (bytes/proc)\n");
+         for (level = 0; level < nlevels; level++)
+         {
+            _braid_printf("  % 5d   %-6s    %1.2e\n", level,
+                          ((storage < 0) || (level < storage)) ? "C-pts" :
+                          ( ((level == 0) && _braid_CoreElt(core, compress_storage)) ? "zip-F" : "all" ),
+                          level_memory[level]);
+         }
+         _braid_printf("\n");
+      }
+      if (_braid_CoreElt(core, storage_ratio) > 0.0)
+      {
+         _braid_printf("  F-point storage compression ratio = %1.2f\n",
+                       _braid_CoreElt(core, storage_ratio));
+         _braid_printf("\n");
+      }
       _braid_printf("  wall time = %f\n", globaltime);
       _braid_printf("\n");
    }
@@ -813,6 +1040,18 @@ braid_SetAccessLevel(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetAccessBulk(braid_Core             core,
+                    braid_PtFcnAccessBulk  access_bulk)
+{
+   _braid_CoreElt(core, access_bulk) = access_bulk;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1008,6 +1247,18 @@ braid_SetNFMGVcyc(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetNestedIter(braid_Core  core,
+                    braid_Int   nested_vcyc)
+{
+   _braid_CoreElt(core, nested_vcyc) = nested_vcyc;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1032,6 +1283,30 @@ braid_SetStorage(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetMemoryBudget(braid_Core  core,
+                      braid_Real  budget)
+{
+   _braid_CoreElt(core, memory_budget) = budget;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetCompressStorage(braid_Core  core,
+                         braid_Int   compress)
+{
+   _braid_CoreElt(core, compress_storage) = compress;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1044,6 +1319,18 @@ braid_SetTemporalNorm(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetFrozenRegion(braid_Core  core,
+                      braid_Real  frozen_tol)
+{
+   _braid_CoreElt(core, frozen_tol) = frozen_tol;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1068,6 +1355,22 @@ braid_SetFullRNormRes(braid_Core          core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetFullRNormFreq(braid_Core  core,
+                       braid_Int   freq)
+{
+   if (freq < 1)
+   {
+      freq = 1;
+   }
+   _braid_CoreElt(core, full_rnorm_freq) = freq;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1122,6 +1425,202 @@ braid_SetShell(braid_Core          core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetCompressComm(braid_Core  core,
+                      braid_Int   level,
+                      braid_Real  rfactor)
+{
+   _braid_CoreElt(core, compress_level)   = level;
+   _braid_CoreElt(core, compress_rfactor) = rfactor;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetCompressCommFcns(braid_Core                core,
+                          braid_PtFcnBufCompress    bufcompress,
+                          braid_PtFcnBufDecompress  bufdecompress)
+{
+   _braid_CoreElt(core, bufcompress)   = bufcompress;
+   _braid_CoreElt(core, bufdecompress) = bufdecompress;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetShmComm(braid_Core  core,
+                 braid_Int   shmcomm)
+{
+   _braid_CoreElt(core, shmcomm) = shmcomm;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetWriteSolution(braid_Core   core,
+                       const char  *filename)
+{
+   _braid_TFree(_braid_CoreElt(core, sol_filename));
+   if (filename != NULL)
+   {
+      _braid_CoreElt(core, sol_filename) = _braid_CTAlloc(char, strlen(filename)+1);
+      strcpy(_braid_CoreElt(core, sol_filename), filename);
+   }
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetBenchFile(braid_Core   core,
+                   const char  *filename)
+{
+   _braid_TFree(_braid_CoreElt(core, bench_filename));
+   if (filename != NULL)
+   {
+      _braid_CoreElt(core, bench_filename) = _braid_CTAlloc(char, strlen(filename)+1);
+      strcpy(_braid_CoreElt(core, bench_filename), filename);
+   }
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetReuseSolution(braid_Core  core,
+                       braid_Int   reuse)
+{
+   _braid_CoreElt(core, reuse) = reuse;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_WriteCheckpoint(braid_Core   core,
+                      const char  *filename)
+{
+   _braid_WriteCheckpoint(core, filename);
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_ReadCheckpoint(braid_Core   core,
+                     const char  *filename)
+{
+   _braid_ReadCheckpoint(core, filename);
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetBufDescribe(braid_Core              core,
+                     braid_PtFcnBufDescribe  bufdescribe)
+{
+   _braid_CoreElt(core, bufdescribe) = bufdescribe;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetCoarsePrecision(braid_Core              core,
+                         braid_Int               level,
+                         braid_PtFcnPrecConvert  demote,
+                         braid_PtFcnPrecConvert  promote,
+                         braid_PtFcnStep         step,
+                         braid_PtFcnClone        clone,
+                         braid_PtFcnFree         free,
+                         braid_PtFcnSum          sum,
+                         braid_PtFcnBufPack      bufpack,
+                         braid_PtFcnBufUnpack    bufunpack)
+{
+   _braid_CoreElt(core, prec_level)   = level;
+   _braid_CoreElt(core, lp_demote)    = demote;
+   _braid_CoreElt(core, lp_promote)   = promote;
+   _braid_CoreElt(core, lp_step)      = step;
+   _braid_CoreElt(core, lp_clone)     = clone;
+   _braid_CoreElt(core, lp_free)      = free;
+   _braid_CoreElt(core, lp_sum)       = sum;
+   _braid_CoreElt(core, lp_bufpack)   = bufpack;
+   _braid_CoreElt(core, lp_bufunpack) = bufunpack;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetDeltaCorrection(braid_Core            core,
+                         braid_Int             rank,
+                         braid_PtFcnInnerProd  innerprod)
+{
+   _braid_CoreElt(core, delta_rank) = rank;
+   _braid_CoreElt(core, innerprod)  = innerprod;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetAnderson(braid_Core            core,
+                  braid_Int             kdim,
+                  braid_Int             ortho,
+                  braid_PtFcnInnerProd  innerprod)
+{
+   _braid_CoreElt(core, anderson_dim)   = kdim;
+   _braid_CoreElt(core, anderson_ortho) = ortho;
+   _braid_CoreElt(core, innerprod)    = innerprod;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetStepAsync(braid_Core             core,
+                   braid_PtFcnStepBegin   begin,
+                   braid_PtFcnStepPoll    poll,
+                   braid_PtFcnStepFinish  finish)
+{
+   _braid_CoreElt(core, step_begin)  = begin;
+   _braid_CoreElt(core, step_poll)   = poll;
+   _braid_CoreElt(core, step_finish) = finish;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1455,7 +1954,7 @@ braid_GetMyID(braid_Core core,
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
-static unsigned long int _braid_rand_next = 1;
+static _braid_ThreadLocal unsigned long int _braid_rand_next = 1;
 braid_Int
 braid_Rand(void)
 {
@@ -214,6 +214,24 @@ typedef braid_Int
                      braid_AccessStatus  status            /**< can be querried for info like the current XBraid Iteration */
                      );
 
+/**
+ * Gives user access to all local vectors on the finest grid in one call
+ * (optional), instead of one call to *access* per time point.  The vectors *u*,
+ * time values *t* and indices *idx* are ordered by time, from the first to the
+ * last local time point.  The vectors are only valid during the call.  XBraid
+ * calls this on every processor, even if it holds no time points, so it may
+ * do collective I/O.  The status refers to the first local time point.  Set
+ * with @ref braid_SetAccessBulk.
+ **/
+typedef braid_Int
+(*braid_PtFcnAccessBulk)(braid_App           app,       /**< user-defined _braid_App structure */
+                         braid_Int           nvectors,  /**< number of local time points */
+                         braid_Vector       *u,         /**< vectors to be accessed */
+                         braid_Real         *t,         /**< time values of the vectors */
+                         braid_Int          *idx,       /**< time indices of the vectors */
+                         braid_AccessStatus  status     /**< can be querried for info like the current XBraid Iteration */
+                         );
+
 /**
  * This routine tells XBraid message sizes by computing an upper bound in bytes
  * for an arbitrary braid_Vector.  This size must be an upper bound for what
@@ -339,6 +357,119 @@ typedef braid_Int
                        braid_Int        *iupper     /**< upper time index value for this processor */
                        );
 
+/**
+ * Compress a packed message (optional).  On input, *buffer* holds the *size*
+ * bytes written by BufPack.  Write the compressed message to *cbuffer*, which
+ * has room for *size* bytes, and return its length in *csize_ptr*.  The
+ * compression error may be as large as *tol*, the current (absolute) stopping
+ * tolerance.  Returning a *csize_ptr* of 0, or of *size* or more, sends the
+ * message uncompressed.  Set with @ref braid_SetCompressCommFcns.
+ **/
+typedef braid_Int
+(*braid_PtFcnBufCompress)(braid_App    app,        /**< user-defined _braid_App structure */
+                          void        *buffer,     /**< packed message */
+                          braid_Int    size,       /**< size of the packed message in bytes */
+                          braid_Real   tol,        /**< allowed compression error */
+                          void        *cbuffer,    /**< output, compressed message */
+                          braid_Int   *csize_ptr   /**< output, size of the compressed message in bytes */
+                          );
+
+/**
+ * Decompress a message produced by @ref braid_PtFcnBufCompress (optional).
+ * Expand the *csize* bytes of *cbuffer* into the *size* bytes of *buffer*,
+ * which are then handed to BufUnpack.
+ **/
+typedef braid_Int
+(*braid_PtFcnBufDecompress)(braid_App    app,      /**< user-defined _braid_App structure */
+                            void        *cbuffer,  /**< compressed message */
+                            braid_Int    csize,    /**< size of the compressed message in bytes */
+                            void        *buffer,   /**< output, packed message */
+                            braid_Int    size      /**< size of the packed message in bytes */
+                            );
+
+/**
+ * Describe the data of a vector as an MPI datatype (optional), so that
+ * XBraid sends and receives it in place instead of using BufPack and
+ * BufUnpack.  Return in *dtype_ptr* a committed datatype with absolute
+ * addresses, i.e., relative to MPI_BOTTOM (see MPI_Get_address and
+ * MPI_Type_create_hindexed).  XBraid frees the datatype when the message
+ * completes.  If *u_ptr* is NULL on input, first allocate a vector for time
+ * value *t* on *level* to receive into.  Set with @ref braid_SetBufDescribe.
+ **/
+typedef braid_Int
+(*braid_PtFcnBufDescribe)(braid_App      app,        /**< user-defined _braid_App structure */
+                          braid_Int      level,      /**< XBraid level of the vector */
+                          braid_Real     t,          /**< time value of the vector */
+                          braid_Vector  *u_ptr,      /**< input/output, vector to describe, allocate if NULL */
+                          MPI_Datatype  *dtype_ptr   /**< output, committed datatype describing the vector */
+                          );
+
+/**
+ * Convert vector *u* between the fine-level and the coarse-level (e.g.,
+ * single) precision (optional).  Allocate the converted copy in *v_ptr*, and
+ * leave *u* unchanged.  Set with @ref braid_SetCoarsePrecision.
+ **/
+typedef braid_Int
+(*braid_PtFcnPrecConvert)(braid_App      app,     /**< user-defined _braid_App structure */
+                          braid_Vector   u,       /**< vector to convert */
+                          braid_Vector  *v_ptr    /**< output, converted copy of u */
+                          );
+
+/**
+ * Compute the inner product of *u* and *v* over space (optional), e.g., the
+ * Euclidean one.  It must be consistent with *sum*, i.e., bilinear, and
+ * global across the spatial communicator.  Set with @ref
+ * braid_SetDeltaCorrection or @ref braid_SetAnderson.
+ **/
+typedef braid_Int
+(*braid_PtFcnInnerProd)(braid_App      app,        /**< user-defined _braid_App structure */
+                        braid_Vector   u,          /**< first vector */
+                        braid_Vector   v,          /**< second vector */
+                        braid_Real    *prod_ptr    /**< output, inner product of u and v */
+                        );
+
+/**
+ * Begin the time step of @ref braid_PtFcnStep without waiting for it to
+ * complete (optional), e.g., start the spatial solve and return while its MPI
+ * communication is in flight.  The arguments are those of *step*.  XBraid
+ * completes the step with @ref braid_PtFcnStepFinish before it reads *u*, and
+ * in the meantime it may begin steps on other vectors, so keep the state of
+ * the step (requests, work vectors) with *u*.  The status is set up again for
+ * each call, so it may be queried in all three routines.  Set with @ref
+ * braid_SetStepAsync.
+ **/
+typedef braid_Int
+(*braid_PtFcnStepBegin)(braid_App        app,     /**< user-defined _braid_App structure */
+                        braid_Vector     ustop,   /**< input, u vector at *tstop* */
+                        braid_Vector     fstop,   /**< input, right-hand-side at *tstop* */
+                        braid_Vector     u,       /**< input/output, initially u vector at *tstart*, upon exit, in flight */
+                        braid_StepStatus status   /**< query this struct for info about u (e.g., tstart and tstop) */
+                        );
+
+/**
+ * Test whether the step begun on *u* with @ref braid_PtFcnStepBegin can be
+ * completed without waiting (optional), e.g., with MPI_Testall, and make
+ * progress on it.  Return the answer in *done_ptr*.
+ **/
+typedef braid_Int
+(*braid_PtFcnStepPoll)(braid_App        app,       /**< user-defined _braid_App structure */
+                       braid_Vector     u,         /**< vector with a step in flight */
+                       braid_StepStatus status,    /**< query this struct for info about u (e.g., tstart and tstop) */
+                       braid_Int       *done_ptr   /**< output, 1 if the step can be finished, 0 otherwise */
+                       );
+
+/**
+ * Complete the step begun on *u* with @ref braid_PtFcnStepBegin, waiting as
+ * needed, and leave the result in *u*.  Refinement requests (@ref
+ * braid_StepStatusSetRFactor, @ref braid_StepStatusSetRSpace) are only
+ * honored here.
+ **/
+typedef braid_Int
+(*braid_PtFcnStepFinish)(braid_App        app,     /**< user-defined _braid_App structure */
+                         braid_Vector     u,       /**< input/output, upon exit, u vector at *tstop* */
+                         braid_StepStatus status   /**< query this struct for info about u (e.g., tstart and tstop) */
+                         );
+
 /** @}*/
 
 /*--------------------------------------------------------------------------
@@ -489,6 +620,31 @@ typedef braid_Int
                        braid_TriStatus status       /**< query this struct for info */ 
    );
 
+/**
+ * This routine linearizes A at time point 'idx' about the current vectors
+ * (optional), e.g., it assembles and factors the Jacobian of the Newton step
+ * done by TriSolve.  On input, *lin_ptr* holds the previous linearization of
+ * this point (NULL the first time), which may be updated in place or replaced.
+ * TriSolve gets the linearization with @ref braid_TriStatusGetLinearization.
+ * Set with @ref braid_SetTriNewton.
+ **/
+typedef braid_Int
+(*braid_PtFcnTriLinearize)(braid_App       app,         /**< user-defined _braid_App structure */
+                           braid_Vector    uleft,       /**< input: vector at idx-1 */
+                           braid_Vector    uright,      /**< input: vector at idx+1 */
+                           braid_Vector    u,           /**< input: vector at idx */
+                           braid_TriStatus status,      /**< query this struct for info */
+                           void          **lin_ptr      /**< input/output, linearization at idx */
+   );
+
+/**
+ * This routine frees a linearization created by @ref braid_PtFcnTriLinearize.
+ **/
+typedef braid_Int
+(*braid_PtFcnTriLinFree)(braid_App   app,             /**< user-defined _braid_App structure */
+                         void       *lin              /**< linearization to free */
+   );
+
 /** @}*/
 
 /*--------------------------------------------------------------------------
@@ -690,6 +846,26 @@ braid_SetNFMGVcyc(braid_Core  core,         /**< braid_Core (_braid_Core) struct
                   braid_Int   nfmg_Vcyc     /**< number of V-cycles to do each FMG level */
                   );
 
+/**
+ * Build the initial guess on the fine grid by nested iteration.  Before the
+ * first iteration, XBraid solves on the coarsest temporal grid (sequential
+ * time stepping), interpolates that solution to the next finer level and does
+ * *nested_vcyc* V-cycles there (with that level as the finest), and so on up
+ * to level 0.  The coarse problems are the rediscretized ones (no FAS
+ * right-hand side), and their initial guesses are injected from the fine
+ * grid.  The iterations on level 0 then start from this initial guess, so
+ * that the first residual norm reflects its quality.
+ *
+ * This replaces the skipped first down cycle (see @ref braid_SetSkip), and
+ * can be combined with FMG.  It is not used with the adjoint or with a
+ * sequential initial guess (@ref braid_SetSeqSoln).  A value of 0 turns this
+ * off (default).
+ **/
+braid_Int
+braid_SetNestedIter(braid_Core  core,        /**< braid_Core (_braid_Core) struct*/
+                    braid_Int   nested_vcyc  /**< number of V-cycles to do at each coarse level */
+                    );
+
 
 /**
  * Sets the storage properties of the code.
@@ -702,6 +878,48 @@ braid_SetStorage(braid_Core  core,          /**< braid_Core (_braid_Core) struct
                  braid_Int   storage        /**< storage property */
                 );
 
+/**
+ * Set a budget for the vector memory of each processor, in bytes.  When the
+ * grid hierarchy is built, XBraid estimates the memory of every level from the
+ * user's buffer size (see [braid_PtFcnBufSize](@ref braid_PtFcnBufSize)) and
+ * selects the storage (see @ref braid_SetStorage) that stores F-points on as
+ * many levels as fit in the budget, coarsest levels first.  If compressed
+ * storage was requested (see @ref braid_SetCompressStorage), full storage with
+ * the fine-grid F-points compressed is tried before giving up full storage on
+ * level 0, and compression is turned off when it is not needed.  If even
+ * C-point storage does not fit, C-point storage is used.  This overrides
+ * @ref braid_SetStorage, and is not used with shell vectors, the adjoint or
+ * TriMGRIT.  The selected storage and the estimated peak memory per level are
+ * shown by @ref braid_PrintStats.  A value of 0 turns this off (default).
+ **/
+braid_Int
+braid_SetMemoryBudget(braid_Core  core,     /**< braid_Core (_braid_Core) struct*/
+                      braid_Real  budget    /**< memory budget per processor in bytes */
+                      );
+
+/**
+ * Store the F-point vectors on the fine grid compressed.  This needs F-points
+ * stored on all levels (*storage* = 0, see @ref braid_SetStorage), or a memory
+ * budget (see @ref braid_SetMemoryBudget) that decides if it is needed.  These
+ * vectors only serve as initial guesses for the implicit solves (ustop), so
+ * they are stored lossy: each vector is packed with BufPack and its
+ * braid_Reals are quantized, with a 2-norm error below the absolute stopping
+ * tolerance (see @ref braid_SetAbsTol and @ref braid_SetRelTol).  With a
+ * relative tolerance, vectors are stored uncompressed until the first residual
+ * is known.  If a codec was set with @ref braid_SetCompressCommFcns, it is
+ * called with the same tolerance instead.
+ *  0 : Default, no compression
+ *  1 : Compress the F-point vectors on the fine grid
+ *
+ * The C-points and the last time point are never compressed.  This is not
+ * supported with shell vectors, the adjoint, Anderson acceleration or TriMGRIT.
+ * The compression ratio is shown by @ref braid_PrintStats.
+ **/
+braid_Int
+braid_SetCompressStorage(braid_Core  core,     /**< braid_Core (_braid_Core) struct*/
+                         braid_Int   compress  /**< 1 compresses the stored F-points, 0 is off */
+                         );
+
 /** 
  * Sets XBraid temporal norm.
  *
@@ -726,6 +944,29 @@ braid_SetTemporalNorm(braid_Core  core,   /**< braid_Core (_braid_Core) struct*/
                       braid_Int   tnorm   /**< choice of temporal norm*/
                       );
 
+/**
+ * Turn on frozen regions.  MGRIT converges from left to right in time, so after
+ * a few iterations the leading C-points on the finest grid no longer change.
+ * After each residual computation on level 0, XBraid freezes the longest run
+ * of leading C-points whose combined residual norm (in the temporal norm) is
+ * below *frozen_tol* times the stopping tolerance (scaled by the initial
+ * residual if a relative tolerance is used).  Frozen points are skipped by
+ * relaxation, restriction, the coarse-grid residual and interpolation on every
+ * level, including the serial solve on the coarsest grid, so ranks holding
+ * only frozen points do (almost) no work.  Frozen points do not change, so
+ * their residual is fixed: it is kept from the iteration they froze in and
+ * added to the residual norm of each later iteration.  Since it is below
+ * *frozen_tol* times the tolerance, the halting check can still be met.
+ *
+ * A value of 0 turns this off (default).  A value well below 1, e.g., 1e-2,
+ * is recommended, since the frozen points are not revisited.  Frozen regions
+ * are not used with temporal refinement, the adjoint or Anderson acceleration.
+ **/
+braid_Int
+braid_SetFrozenRegion(braid_Core  core,        /**< braid_Core (_braid_Core) struct*/
+                      braid_Real  frozen_tol   /**< fraction of the stopping tolerance */
+                      );
+
 /**
  * Set user-defined residual routine.
  **/
@@ -742,6 +983,21 @@ braid_SetFullRNormRes(braid_Core          core,     /**< braid_Core (_braid_Core
                       braid_PtFcnResidual residual  /**< function pointer to residual routine */
                       );
 
+/**
+ * Evaluate the full residual norm (see @ref braid_SetFullRNormRes) only every
+ * *freq* iterations.  The full residual is computed inside the fine-grid
+ * F-relaxation of the restriction, so it costs no extra Step calls, but each
+ * evaluation still calls the user's residual routine at every time point.
+ * Iterations in between have no full residual norm, so the halting check is
+ * only done every *freq* iterations.  The final full residual norm is always
+ * computed.  The frequency is ignored when frozen regions are used (see
+ * @ref braid_SetFrozenRegion).  Default is 1 (every iteration).
+ **/
+braid_Int
+braid_SetFullRNormFreq(braid_Core  core,     /**< braid_Core (_braid_Core) struct*/
+                       braid_Int   freq      /**< compute the full residual norm every freq iterations */
+                       );
+
 /**
  * Set user-defined time points on finest grid
  **/
@@ -832,6 +1088,19 @@ braid_SetAccessLevel(braid_Core  core,          /**< braid_Core (_braid_Core) st
                      braid_Int   access_level   /**< desired access_level */
                      );
 
+/**
+ * Set a bulk access routine, which replaces the calls to the user's access
+ * routine on the finest grid when XBraid is finished (access level 1) and
+ * after every iteration (access level 2).  The calls on coarse levels (access
+ * level 3) still go to the access routine.  With MGRIT, this holds a copy of
+ * every local vector on the finest grid during the call.  Not used with the
+ * adjoint.
+ **/
+braid_Int
+braid_SetAccessBulk(braid_Core             core,         /**< braid_Core (_braid_Core) struct*/
+                    braid_PtFcnAccessBulk  access_bulk   /**< bulk access routine */
+                    );
+
 /**
  * Split MPI commworld into *comm_x* and *comm_t*, the 
  * spatial and temporal communicators.  The total number of processors
@@ -860,6 +1129,281 @@ braid_SetShell(braid_Core          core,
                braid_PtFcnSFree    sfree
                );
 
+/**
+ * Turn on lossy compression of the vectors sent between time neighbors on
+ * levels >= *level*.  By default, the packed message is treated as an array
+ * of braid_Real values and truncated to single precision, which halves the
+ * message size.  This requires that BufPack writes a flat array of
+ * braid_Reals; otherwise, set a codec with @ref braid_SetCompressCommFcns.
+ *
+ * Compression is only used while the residual norm is larger than *rfactor*
+ * times the stopping tolerance.  Closer to convergence, XBraid falls back to
+ * full precision, so that the fixed point of the FAS iteration is kept.  It
+ * also falls back once the residual is within *rfactor* of the single
+ * precision error floor (FLT_EPSILON times the spatial norm of the sent
+ * vector), and for the rest of the run once the residual stops decreasing, so
+ * that a tolerance below the floor is still reached.  Pass a negative *level*
+ * to turn compression off (default).  TriMGRIT messages and load balancing
+ * messages are never compressed.
+ **/
+braid_Int
+braid_SetCompressComm(braid_Core  core,      /**< braid_Core (_braid_Core) struct*/
+                      braid_Int   level,     /**< compress messages on this level and coarser, -1 is off */
+                      braid_Real  rfactor    /**< compress while rnorm > rfactor*tol */
+                      );
+
+/**
+ * Set a user-defined codec for @ref braid_SetCompressComm, e.g., an
+ * error-bounded compressor.  This replaces the default single precision
+ * truncation.
+ **/
+braid_Int
+braid_SetCompressCommFcns(braid_Core                core,           /**< braid_Core (_braid_Core) struct*/
+                          braid_PtFcnBufCompress    bufcompress,    /**< compress a packed message */
+                          braid_PtFcnBufDecompress  bufdecompress   /**< decompress a message */
+                          );
+
+/**
+ * Exchange the vectors with time neighbors on the same node through an MPI-3
+ * shared-memory window, instead of MPI_Isend/MPI_Irecv (*shmcomm* = 1).  Each
+ * rank holds one message slot that its left neighbor copies the packed vector
+ * into, and the receiver unpacks it directly from there, so no MPI call is made
+ * for these messages.  A send that finds the slot still full goes out with MPI
+ * instead, so sends never wait for the receiver.  No threads are used, and any
+ * MPI thread level works.  Ranks on other nodes still use MPI.  This is off by
+ * default (*shmcomm* = 0), and must be set the same on all processors.
+ **/
+braid_Int
+braid_SetShmComm(braid_Core  core,      /**< braid_Core (_braid_Core) struct*/
+                 braid_Int   shmcomm    /**< boolean, use shared memory with same-node neighbors */
+                 );
+
+/**
+ * Write the final fine grid solution to the binary file *filename* with
+ * collective MPI-IO, as an alternative to writing one text file per
+ * processor or time step from *access*.  This happens after XBraid is
+ * finished, independent of the access level.  The file has a 64 byte header
+ * (the string "XBRDSOL", then int64 values version, number of records, record
+ * size and data size), followed by one record per time point in index order.
+ * Each record holds the time (double), the time index (int64), the size
+ * returned by BufPack (int64) and the BufPack data, padded to the data size.
+ * With time chunks, the index runs over all chunks.  The script
+ * misc/user_utils/read_solution.py maps the file into a numpy array.
+ **/
+braid_Int
+braid_SetWriteSolution(braid_Core   core,       /**< braid_Core (_braid_Core) struct*/
+                       const char  *filename    /**< solution file name, NULL turns this off */
+                       );
+
+/**
+ * Append a one-line JSON record of each run to *filename* at the end of
+ * braid_Drive().  The record holds the problem size (ntime, nprocs, nlevels,
+ * cfactor), the iterations, the final residual norm and tolerance, whether the
+ * run converged, the wall time and, under "phases", the wall time of relax,
+ * restrict, interp, coarse, access and anderson on each level (max over
+ * processors).  If this is not set, the environment variable BRAID_BENCH_FILE
+ * is used, which is how the benchmark harness in bench/ collects its data
+ * without changes to the drivers.
+ **/
+braid_Int
+braid_SetBenchFile(braid_Core   core,       /**< braid_Core (_braid_Core) struct*/
+                   const char  *filename    /**< benchmark file name, NULL uses BRAID_BENCH_FILE */
+                   );
+
+/**
+ * Control how a second or later call to braid_Drive() on the same core (a
+ * warm restart, e.g., in an optimization loop) starts.
+ *
+ * - *reuse=1* (default): the solution of the previous call is the initial
+ *   guess, as warm restarts have always done, so a nearby problem (e.g.,
+ *   after a small design update in the app) needs only a few iterations.
+ *   Nothing else is changed, so the initial condition is not set again.
+ * - *reuse=0*: each call starts from *init* as the first one did, which gives
+ *   iteration counts that do not depend on the previous call.
+ * - *reuse=2*: as 1, and the FAS right-hand sides (tau corrections) of the
+ *   coarse levels from the last cycle of the previous call are kept.  The
+ *   first cycle skips the down cycle and starts on the coarsest level with
+ *   them, as with @ref braid_SetSkip, but with the kept right-hand sides
+ *   instead of none.  For an unchanged app and a converged previous call this
+ *   is a fixed point.  When the app data change, the coarse levels propagate
+ *   with the new data, so the first cycle corrects for the change at the cost
+ *   of an up cycle only.  This is meant for runs that skip the first down
+ *   cycle (the default), where *reuse=1* starts the coarse levels with no
+ *   right-hand side and so loses most of the warm start.  With
+ *   braid_SetSkip(core, 0), *reuse=1* usually needs one cycle less per call,
+ *   since the first cycle here has no residual to check.  This keeps one
+ *   extra vector per point on each coarse level between calls.  Not
+ *   supported with the adjoint, TriMGRIT, time refinement or time chunks.
+ **/
+braid_Int
+braid_SetReuseSolution(braid_Core  core,         /**< braid_Core (_braid_Core) struct*/
+                       braid_Int   reuse         /**< 0 init, 1 previous solution, 2 previous solution and FAS right-hand sides */
+                       );
+
+/**
+ * Write the current XBraid state to the checkpoint file *filename* with
+ * collective MPI-IO, so a long run can be resumed with
+ * @ref braid_ReadCheckpoint.  Call this after braid_Drive(), e.g., after each
+ * call of an optimization loop or after a few iterations (see
+ * @ref braid_SetMaxIter).  The file holds the stored vectors of all grid
+ * levels (packed with BufPack), the time values, the adjoint vectors and the
+ * residual norm history.  With TriMGRIT, the Newton linearizations
+ * (@ref braid_SetTriNewton) and the direct solver factors
+ * (@ref braid_SetTriDirect) are not written, since the linearizations have no
+ * BufPack.  They are rebuilt at the restored iterate in the first cycle, so a
+ * continued Newton-TriMGRIT run with a lag (see @ref braid_SetTriNewton) can
+ * differ from an uninterrupted one.  Checkpoints are not supported with shell
+ * vectors or time chunks.
+ **/
+braid_Int
+braid_WriteCheckpoint(braid_Core   core,       /**< braid_Core (_braid_Core) struct*/
+                      const char  *filename    /**< checkpoint file name */
+                      );
+
+/**
+ * Read the checkpoint file *filename* written by @ref braid_WriteCheckpoint
+ * and continue from it in the next braid_Drive(), instead of starting from
+ * the user's initial guess.  Call this after all braid_Set*() routines and
+ * before braid_Drive().  The number of processors may differ from the run
+ * that wrote the checkpoint, since vectors are stored by global time index.
+ * The options (e.g., storage, coarsening factors, max levels) should be the
+ * same; coarse levels that no longer match are set up from the fine grid as
+ * in the first cycle.  BufSize must return the same size.
+ **/
+braid_Int
+braid_ReadCheckpoint(braid_Core   core,       /**< braid_Core (_braid_Core) struct*/
+                     const char  *filename    /**< checkpoint file name */
+                     );
+
+/**
+ * Send and receive the vectors exchanged between time neighbors in place,
+ * through MPI datatypes returned by *bufdescribe*.  This removes the copy
+ * through BufUnpack on the receiving side.  The sending side sends from a
+ * clone of the vector, because XBraid may change the vector while the send
+ * is in progress, so there Clone replaces BufPack.  BufSize, BufPack and
+ * BufUnpack are still used for load balancing and TriMGRIT messages.
+ * Message compression (@ref braid_SetCompressComm) does not apply to these
+ * messages, and in place messages are not used with the adjoint.
+ **/
+braid_Int
+braid_SetBufDescribe(braid_Core              core,         /**< braid_Core (_braid_Core) struct*/
+                     braid_PtFcnBufDescribe  bufdescribe   /**< describe a vector as an MPI datatype */
+                     );
+
+/**
+ * Store the vectors on levels >= *level* in a lower (coarse-level) precision,
+ * e.g., single precision.  The coarse-grid correction only has to be accurate
+ * to the discretization error of the coarse propagator, so the coarse levels
+ * can use half the memory and bandwidth of the fine level.
+ *
+ * XBraid calls *demote* when restricting to *level*, and *promote* when
+ * interpolating back to *level*-1.  On levels >= *level*, the routines *step*,
+ * *clone*, *free*, *sum*, *bufpack* and *bufunpack* replace the ones given to
+ * @ref braid_Init.  The BufSize from @ref braid_Init must be large enough for
+ * both precisions.  SCoarsen and SRefine are always called with fine-level
+ * precision vectors.  The round-off of the coarse-level precision limits the
+ * accuracy of the coarse-grid correction, so the stopping tolerance should be
+ * well above it.  Access on coarse levels (*access_level* 3) receives the
+ * low precision vectors.  Pass *level* = 0 to turn this off (default).  Not
+ * supported with the adjoint, TriMGRIT, shell vectors, time refinement or
+ * @ref braid_SetResidual.
+ **/
+braid_Int
+braid_SetCoarsePrecision(braid_Core              core,        /**< braid_Core (_braid_Core) struct*/
+                         braid_Int               level,       /**< first level stored in the coarse-level precision, 0 is off */
+                         braid_PtFcnPrecConvert  demote,      /**< convert a fine-level vector to the coarse-level precision */
+                         braid_PtFcnPrecConvert  promote,     /**< convert a coarse-level vector to the fine-level precision */
+                         braid_PtFcnStep         step,        /**< Step for coarse-level precision vectors */
+                         braid_PtFcnClone        clone,       /**< Clone for coarse-level precision vectors */
+                         braid_PtFcnFree         free,        /**< Free for coarse-level precision vectors */
+                         braid_PtFcnSum          sum,         /**< Sum for coarse-level precision vectors */
+                         braid_PtFcnBufPack      bufpack,     /**< BufPack for coarse-level precision vectors */
+                         braid_PtFcnBufUnpack    bufunpack    /**< BufUnpack for coarse-level precision vectors */
+                         );
+
+/**
+ * Add a low-rank Delta correction to the coarse-grid propagators, which
+ * restores fast convergence for advection-dominated (hyperbolic) problems
+ * where plain coarse time stepping does not approximate the fine propagator
+ * well enough.  For each coarse time step, XBraid builds an orthonormal basis
+ * *V* of the Krylov space of the fine propagator over that step (Arnoldi,
+ * started from the current solution), and stores *W*, the difference of the
+ * fine and coarse propagators applied to *V*.  The coarse step then becomes
+ *
+ *   Phi_c(u) + W V^T u
+ *
+ * which propagates the leading *rank* modes as the fine grid does.  The
+ * propagators are linearized about the solution by finite differences, so
+ * this is exact for linear (affine) problems only.
+ *
+ * The basis of a coarse time step is built the first time the step is
+ * restricted to (at the cost of about *rank*+2 extra fine-level sweeps over
+ * the step), and then reused in all later iterations and warm restarts.  It
+ * takes 2 *rank* vectors per coarse time step.  A coarse step whose fine
+ * interval is split between processors is not corrected.  Pass *rank* = 0 to
+ * turn this off (default).  Not supported with the adjoint, TriMGRIT, shell
+ * vectors, spatial coarsening, coarse-level precision or @ref
+ * braid_SetResidual.
+ **/
+braid_Int
+braid_SetDeltaCorrection(braid_Core            core,        /**< braid_Core (_braid_Core) struct*/
+                         braid_Int             rank,        /**< rank of the Delta correction, 0 is off */
+                         braid_PtFcnInnerProd  innerprod    /**< inner product of two vectors */
+                         );
+
+/**
+ * Accelerate the MGRIT or TriMGRIT cycles with Anderson acceleration.  Each
+ * cycle maps the vectors stored on level 0, *x*, to *g(x)*.  Instead of taking
+ * *g(x)* as the next iterate, XBraid takes the combination of the results of
+ * the last *kdim* cycles that minimizes the space-time residual norm
+ * ||g - x||, in the inner product *innerprod* summed over time.  The window of
+ * *kdim* cycles slides, dropping the oldest cycle, so this also applies to the
+ * nonlinear (FAS) cycles.  For a linear problem it matches GMRES
+ * preconditioned by the cycle only until the window is full; after that it is
+ * neither full nor restarted GMRES.  An outer (F)GMRES with MGRIT as the
+ * preconditioner is not provided, since it needs the space-time operator
+ * applied to arbitrary vectors and a cycle with a level-0 right-hand side,
+ * which the FAS cycles do not give.  Each iteration costs one cycle plus
+ * O(*kdim*^2) vector operations per stored point.  The least-squares problem
+ * is solved with a QR factorization by Gram-Schmidt: modified (*ortho* = 0,
+ * default), classical (*ortho* = 1) with one reduction per column, or
+ * classical with reorthogonalization (*ortho* = 2).  This stores 2 *kdim* + 3
+ * extra vectors per stored point of level 0, so it is cheapest with the
+ * default storage (C-points only).  Pass *kdim* = 0 to turn this off
+ * (default).  Not supported with the adjoint, shell vectors, time refinement
+ * or time chunks.
+ **/
+braid_Int
+braid_SetAnderson(braid_Core            core,        /**< braid_Core (_braid_Core) struct*/
+                  braid_Int             kdim,        /**< number of cycles kept, 0 is off */
+                  braid_Int             ortho,       /**< Gram-Schmidt variant: 0 modified, 1 classical, 2 classical twice */
+                  braid_PtFcnInnerProd  innerprod    /**< inner product of two vectors */
+                  );
+
+/**
+ * Take the time steps of F- and C-relaxation asynchronously, to hide the
+ * latency of spatial communication in the user's step.  Instead of calling
+ * *step* on one interval at a time, XBraid begins a step on each of its
+ * independent F-intervals, then polls (if *poll* is given) and finishes them,
+ * and begins the next step of an interval as soon as its last one finished.
+ * This overlaps the spatial communication of up to one step per interval with
+ * each other, and with the time-direction receive of the first interval,
+ * which joins once its message has arrived.  Without *poll*, the steps in
+ * flight are finished in order.  With *poll*, the order in which steps begin
+ * depends on timing, so the steps of different intervals must not share MPI
+ * messages that match by order only (e.g., use a tag per time step).  The
+ * other steps (interpolation, restriction, residuals) still use *step*, which
+ * must compute the same thing.  Not supported
+ * with the adjoint, TriMGRIT, shell vectors, coarse-level precision or @ref
+ * braid_SetDeltaCorrection.
+ **/
+braid_Int
+braid_SetStepAsync(braid_Core             core,     /**< braid_Core (_braid_Core) struct*/
+                   braid_PtFcnStepBegin   begin,    /**< begin a step */
+                   braid_PtFcnStepPoll    poll,     /**< test a step for completion, may be NULL */
+                   braid_PtFcnStepFinish  finish    /**< complete a step */
+                   );
+
 /**
  * After Drive() finishes, this returns the number of iterations taken.
  **/
@@ -1126,6 +1670,53 @@ braid_InitTriMGRIT(MPI_Comm               comm_world,
                    braid_Core            *core_ptr
    );
 
+/**
+ * Reuse linearizations in the TriSolve routine (Newton-TriMGRIT).  Instead of
+ * linearizing A anew in every call, TriSolve takes a Newton step with the
+ * linearization returned by @ref braid_TriStatusGetLinearization, which
+ * XBraid builds with *linearize* the first time a point is solved after the
+ * linearization of its level has expired.  A linearization expires after
+ * *lag* iterations on the finest level, and after *clag* iterations on the
+ * coarse levels, where cheaper chord steps usually suffice.  With *lag* = 1,
+ * each point is linearized once per iteration, instead of once per solve
+ * (relaxation sweeps and interpolation).  Far from the solution, e.g., from a
+ * random initial guess, these chord steps may diverge, so before iteration
+ * *start* every solve is linearized anew (a full Newton step).  The residual
+ * is always that of TriResidual, so the solution is the same, only the
+ * convergence rate may change.
+ **/
+braid_Int
+braid_SetTriNewton(braid_Core               core,       /**< braid_Core (_braid_Core) struct*/
+                   braid_PtFcnTriLinearize  linearize,  /**< linearize A at a time point */
+                   braid_PtFcnTriLinFree    linfree,    /**< free a linearization */
+                   braid_Int                start,      /**< first iteration that reuses linearizations */
+                   braid_Int                lag,        /**< iterations a fine-level linearization is kept */
+                   braid_Int                clag        /**< iterations a coarse-level linearization is kept */
+   );
+
+/**
+ * Solve the coarsest TriMGRIT level directly (*direct* = 1), instead of with
+ * FCF-relaxation.  With max levels = 1, this solves the whole problem in one
+ * iteration: the residual norm is computed after the solve and XBraid stops,
+ * which gives an exact time-parallel baseline.  The solver assumes that
+ * TriResidual is affine in (uleft, u, uright), as for linear optimal-control
+ * problems, and probes its N x N blocks by adding unit vectors to the current
+ * iterate, so it is meant for moderate spatial sizes N.  The vectors are
+ * converted to arrays with BufPack and BufUnpack, so they must pack as N
+ * braid_Reals (without spatial parallelism).  The blocks are factored once
+ * per level with a partitioned block Thomas algorithm, where process 0 solves
+ * the reduced system that couples the first and last points of each process.
+ * Each later solve costs one TriResidual and O(N^2) work per point, plus a
+ * gather and broadcast of 2N values per process.  With Newton-TriMGRIT (see
+ * @ref braid_SetTriNewton), the blocks are finite-difference Jacobians at the
+ * current iterate, probed and factored again in each new linearization epoch,
+ * and each solve is a Newton step.
+ **/
+braid_Int
+braid_SetTriDirect(braid_Core  core,       /**< braid_Core (_braid_Core) struct*/
+                   braid_Int   direct      /**< solve the coarsest level directly (1) or not (0) */
+   );
+
 /** @}*/
 
 #ifdef __cplusplus
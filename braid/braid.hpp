@@ -22,6 +22,10 @@
 #ifndef braid_hpp_HEADER
 #define braid_hpp_HEADER
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "_braid.h"
 #include "braid.h"
 #include "braid_test.h"
@@ -153,6 +157,19 @@ public:
       Clone(cu_, fu_ptr);
       return 0;
    }
+
+   // This function may be optionally defined by the user, if the Delta
+   // correction is desired.  To turn it on, use core.SetDeltaCorrection(rank)
+   /// @see braid_PtFcnInnerProd.
+   virtual braid_Int InnerProd(braid_Vector  u_,
+                               braid_Vector  v_,
+                               braid_Real   *prod_ptr)
+   {
+      fprintf(stderr, "Braid C++ Wrapper Warning: turn off the Delta correction "
+                      "until InnerProd has been user implemented\n");
+      *prod_ptr = 0.0;
+      return 0;
+   }
 };
 
 
@@ -414,22 +431,26 @@ static braid_Int _BraidAppRefine(braid_App               _app,
 }
 
 
-// Wrapper for BRAID's core object
-class BraidCore
+static braid_Int _BraidAppInnerProd(braid_App     _app,
+                                    braid_Vector  _u,
+                                    braid_Vector  _v,
+                                    braid_Real   *prod_ptr)
 {
-private:
+   BraidApp *app = (BraidApp*)_app;
+   return app -> InnerProd(_u, _v, prod_ptr);
+}
+
+
+// Wrapper for BRAID's core object, holding the options common to BraidCore
+// and BraidCoreT.  The derived classes call braid_Init.
+class BraidCoreBase
+{
+protected:
    braid_Core core;
 
-public:
-   BraidCore(MPI_Comm comm_world, BraidApp *app)
-   {
-      braid_Init(comm_world,
-                 app->comm_t, app->tstart, app->tstop, app->ntime, (braid_App)app,
-                 _BraidAppStep, _BraidAppInit, _BraidAppClone, _BraidAppFree,
-                 _BraidAppSum, _BraidAppSpatialNorm, _BraidAppAccess,
-                 _BraidAppBufSize, _BraidAppBufPack, _BraidAppBufUnpack, &core);
-   }
+   BraidCoreBase() : core(NULL) { }
 
+public:
    void SetMaxLevels(braid_Int max_levels) { braid_SetMaxLevels(core, max_levels); }
    
    void SetSkip(braid_Int skip) { braid_SetSkip(core, skip); }
@@ -467,14 +488,6 @@ public:
     //}
    }
 
-   void SetSpatialCoarsenAndRefine()
-   {
-      braid_SetSpatialCoarsen(core, _BraidAppCoarsen);
-      braid_SetSpatialRefine(core, _BraidAppRefine);
-   }
-
-   void SetResidual() { braid_SetResidual(core, _BraidAppResidual); }
-
    void SetMaxIter(braid_Int max_iter) { braid_SetMaxIter(core, max_iter); }
 
    void SetPrintLevel(braid_Int print_level) { braid_SetPrintLevel(core, print_level); }
@@ -507,7 +520,324 @@ public:
 
    void Drive() { braid_Drive(core); }
 
-   ~BraidCore() { braid_Destroy(core); }
+   virtual ~BraidCoreBase() { if (core) braid_Destroy(core); }
+};
+
+// Wrapper for BRAID's core object, with the callbacks going to the virtual
+// methods of a BraidApp
+class BraidCore : public BraidCoreBase
+{
+public:
+   BraidCore(MPI_Comm comm_world, BraidApp *app)
+   {
+      braid_Init(comm_world,
+                 app->comm_t, app->tstart, app->tstop, app->ntime, (braid_App)app,
+                 _BraidAppStep, _BraidAppInit, _BraidAppClone, _BraidAppFree,
+                 _BraidAppSum, _BraidAppSpatialNorm, _BraidAppAccess,
+                 _BraidAppBufSize, _BraidAppBufPack, _BraidAppBufUnpack, &core);
+   }
+
+   void SetSpatialCoarsenAndRefine()
+   {
+      braid_SetSpatialCoarsen(core, _BraidAppCoarsen);
+      braid_SetSpatialRefine(core, _BraidAppRefine);
+   }
+
+   void SetResidual() { braid_SetResidual(core, _BraidAppResidual); }
+
+   void SetDeltaCorrection(braid_Int rank) { braid_SetDeltaCorrection(core, rank, _BraidAppInnerProd); }
+};
+
+// Default allocation policy of BraidCoreT: every vector is allocated with new
+// (through App::Clone for clones) and freed with delete.
+template <class Vec>
+class BraidVectorNew
+{
+public:
+   Vec *New(Vec &&u) { return new Vec(std::move(u)); }
+
+   template <class App>
+   Vec *Clone(App &app, const Vec &u) { return new Vec(app.Clone(u)); }
+
+   void Free(Vec *u) { delete u; }
+};
+
+// Pooled allocation policy of BraidCoreT: Free keeps the vector on a free list,
+// and Clone copy-assigns into a recycled vector when one is available, so the
+// clone/free churn of relaxation and interpolation reuses storage instead of
+// allocating it.  Vec must be copy-assignable, and the assignment should reuse
+// the storage of a vector of the same shape (as std::vector does).  The free
+// list keeps at most max_free vectors (SetMaxFree), and Free deletes the ones
+// above that, so a burst of frees (e.g., a coarse grid or a refinement going
+// away) does not pin its peak memory for the rest of the run.  Handle is an
+// owning pointer that returns its vector to the pool, for temporaries in the
+// App.
+template <class Vec>
+class BraidVectorPool
+{
+private:
+   std::vector<Vec*> free_list;
+   size_t            max_free;
+
+public:
+   struct Recycler
+   {
+      BraidVectorPool *pool;
+      void operator()(Vec *u) const { pool->Free(u); }
+   };
+   typedef std::unique_ptr<Vec, Recycler> Handle;
+
+   BraidVectorPool() : max_free(16) { }
+   BraidVectorPool(const BraidVectorPool &) = delete;
+   BraidVectorPool &operator=(const BraidVectorPool &) = delete;
+
+   Vec *New(Vec &&u) { return new Vec(std::move(u)); }
+
+   template <class App>
+   Vec *Clone(App &app, const Vec &u)
+   {
+      if (free_list.empty())
+      {
+         return new Vec(app.Clone(u));
+      }
+      Vec *v = free_list.back();
+      free_list.pop_back();
+      *v = u;
+      return v;
+   }
+
+   template <class App>
+   Handle CloneHandle(App &app, const Vec &u)
+   {
+      Recycler recycler = { this };
+      return Handle(Clone(app, u), recycler);
+   }
+
+   void Free(Vec *u)
+   {
+      if (free_list.size() < max_free)
+      {
+         free_list.push_back(u);
+      }
+      else
+      {
+         delete u;
+      }
+   }
+
+   /// Keep at most max_free vectors on the free list (default 16), 0 disables
+   /// the recycling
+   void SetMaxFree(size_t max_free_) { max_free = max_free_; Trim(max_free); }
+
+   /// Delete free vectors until at most n are left
+   void Trim(size_t n = 0)
+   {
+      while (free_list.size() > n)
+      {
+         delete free_list.back();
+         free_list.pop_back();
+      }
+   }
+
+   /// Number of vectors waiting on the free list
+   size_t NumFree() const { return free_list.size(); }
+
+   ~BraidVectorPool() { Trim(); }
+};
+
+// Wrapper for BRAID's core object with the App and vector types fixed at
+// compile time.  There is no BraidApp base class and no virtual dispatch: the
+// callbacks passed to braid_Init are instantiated for App and Vec, and call
+// their (non-virtual, inlinable) members directly.  A braid_Vector is a Vec*,
+// allocated and freed by the Alloc policy (BraidVectorNew or BraidVectorPool),
+// and with the default policy Vec may be a move-only RAII type.  App must
+// provide
+//
+//   braid_Int  Step(Vec &u, Vec *ustop, Vec *fstop, BraidStepStatus &status);
+//   Vec        Init(braid_Real t);
+//   Vec        Clone(const Vec &u);
+//   braid_Int  Sum(braid_Real alpha, const Vec &x, braid_Real beta, Vec &y);
+//   braid_Real SpatialNorm(const Vec &u);
+//   braid_Int  Access(const Vec &u, BraidAccessStatus &astatus);
+//
+// and the public members comm_t, tstart, tstop and ntime, as BraidApp does.
+// Vec must provide the message buffer functions
+//
+//   static braid_Int BufSize(App &app, BraidBufferStatus &bstatus);
+//   braid_Int        BufPack(void *buffer, BraidBufferStatus &bstatus) const;
+//   static Vec       BufUnpack(App &app, void *buffer, BraidBufferStatus &bstatus);
+//
+// Optional features instantiate their callbacks only when set, so App needs
+// Residual(const Vec &ustop, Vec &r, BraidStepStatus &), Coarsen and Refine
+// (const Vec &, BraidCoarsenRefStatus &, returning the new Vec) or
+// InnerProd(const Vec &, const Vec &) only if the matching Set function is
+// called.
+template <class App, class Vec, class Alloc = BraidVectorNew<Vec> >
+class BraidCoreT : public BraidCoreBase
+{
+private:
+   // The braid_App handed to the callbacks
+   struct Context
+   {
+      App   *app;
+      Alloc  alloc;
+   };
+   Context ctx;
+
+   static App *A(braid_App app) { return static_cast<Context*>((void*)app)->app; }
+   static Alloc &M(braid_App app) { return static_cast<Context*>((void*)app)->alloc; }
+   static Vec *V(braid_Vector u) { return reinterpret_cast<Vec*>(u); }
+   static braid_Vector B(Vec *u) { return reinterpret_cast<braid_Vector>(u); }
+
+   static braid_Int StepFcn(braid_App        app,
+                            braid_Vector     ustop,
+                            braid_Vector     fstop,
+                            braid_Vector     u,
+                            braid_StepStatus status)
+   {
+      BraidStepStatus pstatus(status);
+      return A(app)->Step(*V(u), V(ustop), V(fstop), pstatus);
+   }
+
+   static braid_Int ResidualFcn(braid_App        app,
+                                braid_Vector     ustop,
+                                braid_Vector     r,
+                                braid_StepStatus status)
+   {
+      BraidStepStatus pstatus(status);
+      return A(app)->Residual(*V(ustop), *V(r), pstatus);
+   }
+
+   static braid_Int InitFcn(braid_App     app,
+                            braid_Real    t,
+                            braid_Vector *u_ptr)
+   {
+      *u_ptr = B(M(app).New(A(app)->Init(t)));
+      return 0;
+   }
+
+   static braid_Int CloneFcn(braid_App     app,
+                             braid_Vector  u,
+                             braid_Vector *v_ptr)
+   {
+      *v_ptr = B(M(app).Clone(*A(app), *V(u)));
+      return 0;
+   }
+
+   static braid_Int FreeFcn(braid_App    app,
+                            braid_Vector u)
+   {
+      M(app).Free(V(u));
+      return 0;
+   }
+
+   static braid_Int SumFcn(braid_App    app,
+                           braid_Real   alpha,
+                           braid_Vector x,
+                           braid_Real   beta,
+                           braid_Vector y)
+   {
+      return A(app)->Sum(alpha, *V(x), beta, *V(y));
+   }
+
+   static braid_Int SpatialNormFcn(braid_App     app,
+                                   braid_Vector  u,
+                                   braid_Real   *norm_ptr)
+   {
+      *norm_ptr = A(app)->SpatialNorm(*V(u));
+      return 0;
+   }
+
+   static braid_Int InnerProdFcn(braid_App     app,
+                                 braid_Vector  u,
+                                 braid_Vector  v,
+                                 braid_Real   *prod_ptr)
+   {
+      *prod_ptr = A(app)->InnerProd(*V(u), *V(v));
+      return 0;
+   }
+
+   static braid_Int AccessFcn(braid_App          app,
+                              braid_Vector       u,
+                              braid_AccessStatus status)
+   {
+      BraidAccessStatus astatus(status);
+      return A(app)->Access(*V(u), astatus);
+   }
+
+   static braid_Int BufSizeFcn(braid_App          app,
+                               braid_Int         *size_ptr,
+                               braid_BufferStatus status)
+   {
+      BraidBufferStatus bstatus(status);
+      *size_ptr = Vec::BufSize(*A(app), bstatus);
+      return 0;
+   }
+
+   static braid_Int BufPackFcn(braid_App          app,
+                               braid_Vector       u,
+                               void              *buffer,
+                               braid_BufferStatus status)
+   {
+      BraidBufferStatus bstatus(status);
+      return V(u)->BufPack(buffer, bstatus);
+   }
+
+   static braid_Int BufUnpackFcn(braid_App          app,
+                                 void              *buffer,
+                                 braid_Vector      *u_ptr,
+                                 braid_BufferStatus status)
+   {
+      BraidBufferStatus bstatus(status);
+      *u_ptr = B(M(app).New(Vec::BufUnpack(*A(app), buffer, bstatus)));
+      return 0;
+   }
+
+   static braid_Int CoarsenFcn(braid_App              app,
+                               braid_Vector           fu,
+                               braid_Vector          *cu_ptr,
+                               braid_CoarsenRefStatus status)
+   {
+      BraidCoarsenRefStatus cstatus(status);
+      *cu_ptr = B(M(app).New(A(app)->Coarsen(*V(fu), cstatus)));
+      return 0;
+   }
+
+   static braid_Int RefineFcn(braid_App              app,
+                              braid_Vector           cu,
+                              braid_Vector          *fu_ptr,
+                              braid_CoarsenRefStatus status)
+   {
+      BraidCoarsenRefStatus cstatus(status);
+      *fu_ptr = B(M(app).New(A(app)->Refine(*V(cu), cstatus)));
+      return 0;
+   }
+
+public:
+   BraidCoreT(MPI_Comm comm_world, App *app)
+   {
+      ctx.app = app;
+      braid_Init(comm_world,
+                 app->comm_t, app->tstart, app->tstop, app->ntime, (braid_App)(void*)&ctx,
+                 StepFcn, InitFcn, CloneFcn, FreeFcn, SumFcn, SpatialNormFcn,
+                 AccessFcn, BufSizeFcn, BufPackFcn, BufUnpackFcn, &core);
+   }
+
+   /// The allocation policy, e.g., the BraidVectorPool for App temporaries
+   Alloc &GetAllocator() { return ctx.alloc; }
+
+   void SetSpatialCoarsenAndRefine()
+   {
+      braid_SetSpatialCoarsen(core, CoarsenFcn);
+      braid_SetSpatialRefine(core, RefineFcn);
+   }
+
+   void SetResidual() { braid_SetResidual(core, ResidualFcn); }
+
+   void SetDeltaCorrection(braid_Int rank) { braid_SetDeltaCorrection(core, rank, InnerProdFcn); }
+
+   // Destroy the core while the allocator still exists
+   ~BraidCoreT() { braid_Destroy(core); core = NULL; }
 };
 
 
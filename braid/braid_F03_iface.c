@@ -0,0 +1,211 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory. Written by
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+
+/** \file braid_F03_iface.c
+ * \brief Vector routines for the Fortran 2003 interface (braid_mod.f90).
+ *
+ * With the ISO_C_BINDING module braid_mod, XBraid owns the vectors: each one
+ * is a contiguous array of doubles, and the user's Fortran step, init and
+ * access routines get assumed-shape views of it.  This file defines that
+ * vector and the routines that work on it (clone, free, sum, norm and the
+ * buffer routines), so that the Fortran user only writes the time stepper.
+ *
+ * This is kept apart from braid_F90_iface.c, which references the
+ * user-written F90 routines.
+ */
+
+#include <string.h>
+#include <math.h>
+#include "braid.h"
+#include "_braid.h"
+
+/*--------------------------------------------------------------------------
+ * The vector, interoperable with type(braid_vector_f03) in braid_mod.f90.
+ * The values follow the structure in the same allocation.
+ *--------------------------------------------------------------------------*/
+
+typedef struct
+{
+   braid_Int    nvalues;
+   braid_Real  *values;
+
+} _braid_F03Vector;
+
+/*--------------------------------------------------------------------------
+ * Allocate a vector of nvalues (uninitialized) values
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_F03VectorCreate(braid_Int      nvalues,
+                      braid_Vector  *u_ptr)
+{
+   _braid_F03Vector *u;
+
+   u = (_braid_F03Vector *) malloc(sizeof(_braid_F03Vector) + nvalues*sizeof(braid_Real));
+   u->nvalues = nvalues;
+   u->values  = (braid_Real *) (u + 1);
+   *u_ptr = (braid_Vector) u;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ * braid_PtFcnClone, braid_PtFcnFree, braid_PtFcnSum, braid_PtFcnSpatialNorm
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_F03Clone(braid_App      app,
+               braid_Vector   u,
+               braid_Vector  *v_ptr)
+{
+   _braid_F03Vector *uu = (_braid_F03Vector *) u;
+
+   braid_F03VectorCreate(uu->nvalues, v_ptr);
+   memcpy(((_braid_F03Vector *) *v_ptr)->values, uu->values, uu->nvalues*sizeof(braid_Real));
+
+   return _braid_error_flag;
+}
+
+braid_Int
+braid_F03Free(braid_App     app,
+              braid_Vector  u)
+{
+   free(u);
+
+   return _braid_error_flag;
+}
+
+braid_Int
+braid_F03Sum(braid_App     app,
+             braid_Real    alpha,
+             braid_Vector  x,
+             braid_Real    beta,
+             braid_Vector  y)
+{
+   braid_Real  *xv = ((_braid_F03Vector *) x)->values;
+   braid_Real  *yv = ((_braid_F03Vector *) y)->values;
+   braid_Int    n  = ((_braid_F03Vector *) y)->nvalues;
+   braid_Int    i;
+
+   for (i = 0; i < n; i++)
+   {
+      yv[i] = alpha*xv[i] + beta*yv[i];
+   }
+
+   return _braid_error_flag;
+}
+
+braid_Int
+braid_F03SpatialNorm(braid_App      app,
+                     braid_Vector   u,
+                     braid_Real    *norm_ptr)
+{
+   braid_Real  *uv = ((_braid_F03Vector *) u)->values;
+   braid_Int    n  = ((_braid_F03Vector *) u)->nvalues;
+   braid_Real   dot = 0.0;
+   braid_Int    i;
+
+   for (i = 0; i < n; i++)
+   {
+      dot += uv[i]*uv[i];
+   }
+   *norm_ptr = sqrt(dot);
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ * braid_PtFcnBufPack, braid_PtFcnBufUnpack.  The buffer holds the number of
+ * values, then the values, so the size is (nvalues+1)*sizeof(braid_Real).
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_F03BufPack(braid_App           app,
+                 braid_Vector        u,
+                 void               *buffer,
+                 braid_BufferStatus  bstatus)
+{
+   _braid_F03Vector *uu  = (_braid_F03Vector *) u;
+   braid_Real       *buf = (braid_Real *) buffer;
+
+   buf[0] = (braid_Real) uu->nvalues;
+   memcpy(&buf[1], uu->values, uu->nvalues*sizeof(braid_Real));
+   braid_BufferStatusSetSize(bstatus, (uu->nvalues+1)*sizeof(braid_Real));
+
+   return _braid_error_flag;
+}
+
+braid_Int
+braid_F03BufUnpack(braid_App           app,
+                   void               *buffer,
+                   braid_Vector       *u_ptr,
+                   braid_BufferStatus  bstatus)
+{
+   braid_Real  *buf     = (braid_Real *) buffer;
+   braid_Int    nvalues = (braid_Int) buf[0];
+
+   braid_F03VectorCreate(nvalues, u_ptr);
+   memcpy(((_braid_F03Vector *) *u_ptr)->values, &buf[1], nvalues*sizeof(braid_Real));
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ * braid_Init with the routines above.  The communicators are Fortran
+ * handles.  The step, init, access and bufsize routines are the bind(C)
+ * routines of braid_mod, so braid calls them without a C wrapper.
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_F03Init(braid_Int              fcomm_world,
+              braid_Int              fcomm,
+              braid_Real             tstart,
+              braid_Real             tstop,
+              braid_Int              ntime,
+              braid_App              app,
+              braid_PtFcnStep        step,
+              braid_PtFcnInit        init,
+              braid_PtFcnAccess      access,
+              braid_PtFcnBufSize     bufsize,
+              braid_Core            *core_ptr)
+{
+   return braid_Init(MPI_Comm_f2c(fcomm_world), MPI_Comm_f2c(fcomm), tstart, tstop, ntime, app,
+                     step, init, braid_F03Clone, braid_F03Free, braid_F03Sum,
+                     braid_F03SpatialNorm, access, bufsize, braid_F03BufPack,
+                     braid_F03BufUnpack, core_ptr);
+}
+
+/*--------------------------------------------------------------------------
+ * braid_Destroy, returning the app that was given to braid_F03Init, so that
+ * braid_mod can free it
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_F03Destroy(braid_Core   core,
+                 braid_App   *app_ptr)
+{
+   *app_ptr = _braid_CoreElt(core, app);
+
+   return braid_Destroy(core);
+}
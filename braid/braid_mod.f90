@@ -0,0 +1,399 @@
+!BHEADER**********************************************************************
+! Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+! Produced at the Lawrence Livermore National Laboratory. Written by
+! Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+! Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+!
+! This file is part of XBraid. For support, post issues to the XBraid Github page.
+!
+! This program is free software; you can redistribute it and/or modify it under
+! the terms of the GNU General Public License (as published by the Free Software
+! Foundation) version 2.1 dated February 1999.
+!
+! This program is distributed in the hope that it will be useful, but WITHOUT ANY
+! WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+! PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+! License for more details.
+!
+! You should have received a copy of the GNU Lesser General Public License along
+! with this program; if not, write to the Free Software Foundation, Inc., 59
+! Temple Place, Suite 330, Boston, MA 02111-1307 USA
+!
+!EHEADER**********************************************************************
+
+!
+! Fortran 2003 (ISO_C_BINDING) interface to XBraid with flat-array vectors.
+!
+! XBraid owns the vectors, each a contiguous array of nvalues doubles, and the
+! user's routines see them as assumed-shape arrays.  The user writes only
+!
+!    step(app, tstart, tstop, u, status)    advance u(:) from tstart to tstop
+!    init(app, t, u)                        set u(:) at time t
+!    access(app, t, u, status)              look at u(:) at time t (optional)
+!
+! where app is the c_ptr given to braid_init_f03 (e.g., c_loc of the user's
+! data).  Clone, sum, norm (2-norm) and the MPI buffers are done by XBraid in
+! braid_F03_iface.c.  Unlike braid_F90_iface.c, the routines are not called
+! through name-mangled wrappers, and the XBraid setters below are the C
+! functions themselves.
+!
+! Compile this file with the user's code (it is not part of libbraid.a):
+!
+!    mpif90 -c braid_mod.f90
+!    mpif90 my_code.f90 braid_mod.o libbraid.a
+!
+! See examples/ex-01-f03.f90.
+!
+
+module braid_mod
+
+   use iso_c_binding
+   implicit none
+   private
+
+   public :: braid_init_f03, braid_destroy_f03
+   public :: braid_step_f03, braid_init_vec_f03, braid_access_f03
+
+   ! The XBraid functions that are called directly
+   public :: braid_Drive, braid_PrintStats
+   public :: braid_SetMaxLevels, braid_SetMinCoarse, braid_SetCFactor, braid_SetNRelax
+   public :: braid_SetAbsTol, braid_SetRelTol, braid_SetMaxIter, braid_SetPrintLevel
+   public :: braid_SetAccessLevel, braid_SetSkip, braid_SetFMG, braid_SetSeqSoln
+   public :: braid_GetNumIter, braid_GetRNorms
+   public :: braid_StepStatusGetLevel, braid_StepStatusGetIter, braid_StepStatusGetTIndex
+   public :: braid_AccessStatusGetLevel, braid_AccessStatusGetIter
+   public :: braid_AccessStatusGetTIndex, braid_AccessStatusGetDone
+
+   ! The user-written routines
+   abstract interface
+      subroutine braid_step_f03(app, tstart, tstop, u, status)
+         import :: c_ptr, c_double
+         type(c_ptr),    intent(in)    :: app
+         real(c_double), intent(in)    :: tstart, tstop
+         real(c_double), intent(inout) :: u(:)
+         type(c_ptr),    intent(in)    :: status
+      end subroutine braid_step_f03
+
+      subroutine braid_init_vec_f03(app, t, u)
+         import :: c_ptr, c_double
+         type(c_ptr),    intent(in)    :: app
+         real(c_double), intent(in)    :: t
+         real(c_double), intent(out)   :: u(:)
+      end subroutine braid_init_vec_f03
+
+      subroutine braid_access_f03(app, t, u, status)
+         import :: c_ptr, c_double
+         type(c_ptr),    intent(in)    :: app
+         real(c_double), intent(in)    :: t
+         real(c_double), intent(in)    :: u(:)
+         type(c_ptr),    intent(in)    :: status
+      end subroutine braid_access_f03
+   end interface
+
+   ! Same layout as _braid_F03Vector in braid_F03_iface.c
+   type, bind(C) :: braid_vector_f03
+      integer(c_int) :: nvalues
+      type(c_ptr)    :: values
+   end type braid_vector_f03
+
+   ! The app that XBraid sees
+   type :: braid_app_f03
+      type(c_ptr)    :: app
+      integer(c_int) :: nvalues
+      procedure(braid_step_f03),     pointer, nopass :: step   => null()
+      procedure(braid_init_vec_f03), pointer, nopass :: init   => null()
+      procedure(braid_access_f03),   pointer, nopass :: access => null()
+   end type braid_app_f03
+
+   interface
+      integer(c_int) function braid_F03Init(fcomm_world, fcomm, tstart, tstop, ntime, app, &
+            step, init, access, bufsize, core) bind(C, name="braid_F03Init")
+         import :: c_int, c_double, c_ptr, c_funptr
+         integer(c_int), value :: fcomm_world, fcomm, ntime
+         real(c_double), value :: tstart, tstop
+         type(c_ptr),    value :: app
+         type(c_funptr), value :: step, init, access, bufsize
+         type(c_ptr)           :: core
+      end function braid_F03Init
+
+      integer(c_int) function braid_F03Destroy(core, app) bind(C, name="braid_F03Destroy")
+         import :: c_int, c_ptr
+         type(c_ptr), value :: core
+         type(c_ptr)        :: app
+      end function braid_F03Destroy
+
+      integer(c_int) function braid_F03VectorCreate(nvalues, u) bind(C, name="braid_F03VectorCreate")
+         import :: c_int, c_ptr
+         integer(c_int), value :: nvalues
+         type(c_ptr)           :: u
+      end function braid_F03VectorCreate
+
+      subroutine braid_StepStatusGetTstartTstop(status, tstart, tstop) &
+            bind(C, name="braid_StepStatusGetTstartTstop")
+         import :: c_ptr, c_double
+         type(c_ptr), value :: status
+         real(c_double)     :: tstart, tstop
+      end subroutine braid_StepStatusGetTstartTstop
+
+      subroutine braid_AccessStatusGetT(status, t) bind(C, name="braid_AccessStatusGetT")
+         import :: c_ptr, c_double
+         type(c_ptr), value :: status
+         real(c_double)     :: t
+      end subroutine braid_AccessStatusGetT
+
+      ! XBraid functions, see braid.h and braid_status.h
+      subroutine braid_Drive(core) bind(C, name="braid_Drive")
+         import :: c_ptr
+         type(c_ptr), value :: core
+      end subroutine braid_Drive
+
+      subroutine braid_PrintStats(core) bind(C, name="braid_PrintStats")
+         import :: c_ptr
+         type(c_ptr), value :: core
+      end subroutine braid_PrintStats
+
+      subroutine braid_SetMaxLevels(core, max_levels) bind(C, name="braid_SetMaxLevels")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: max_levels
+      end subroutine braid_SetMaxLevels
+
+      subroutine braid_SetMinCoarse(core, min_coarse) bind(C, name="braid_SetMinCoarse")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: min_coarse
+      end subroutine braid_SetMinCoarse
+
+      subroutine braid_SetCFactor(core, level, cfactor) bind(C, name="braid_SetCFactor")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: level, cfactor
+      end subroutine braid_SetCFactor
+
+      subroutine braid_SetNRelax(core, level, nrelax) bind(C, name="braid_SetNRelax")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: level, nrelax
+      end subroutine braid_SetNRelax
+
+      subroutine braid_SetAbsTol(core, atol) bind(C, name="braid_SetAbsTol")
+         import :: c_ptr, c_double
+         type(c_ptr),    value :: core
+         real(c_double), value :: atol
+      end subroutine braid_SetAbsTol
+
+      subroutine braid_SetRelTol(core, rtol) bind(C, name="braid_SetRelTol")
+         import :: c_ptr, c_double
+         type(c_ptr),    value :: core
+         real(c_double), value :: rtol
+      end subroutine braid_SetRelTol
+
+      subroutine braid_SetMaxIter(core, max_iter) bind(C, name="braid_SetMaxIter")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: max_iter
+      end subroutine braid_SetMaxIter
+
+      subroutine braid_SetPrintLevel(core, print_level) bind(C, name="braid_SetPrintLevel")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: print_level
+      end subroutine braid_SetPrintLevel
+
+      subroutine braid_SetAccessLevel(core, access_level) bind(C, name="braid_SetAccessLevel")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: access_level
+      end subroutine braid_SetAccessLevel
+
+      subroutine braid_SetSkip(core, skip) bind(C, name="braid_SetSkip")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: skip
+      end subroutine braid_SetSkip
+
+      subroutine braid_SetFMG(core) bind(C, name="braid_SetFMG")
+         import :: c_ptr
+         type(c_ptr), value :: core
+      end subroutine braid_SetFMG
+
+      subroutine braid_SetSeqSoln(core, seq_soln) bind(C, name="braid_SetSeqSoln")
+         import :: c_ptr, c_int
+         type(c_ptr),    value :: core
+         integer(c_int), value :: seq_soln
+      end subroutine braid_SetSeqSoln
+
+      subroutine braid_GetNumIter(core, niter) bind(C, name="braid_GetNumIter")
+         import :: c_ptr, c_int
+         type(c_ptr), value :: core
+         integer(c_int)     :: niter
+      end subroutine braid_GetNumIter
+
+      subroutine braid_GetRNorms(core, nrequest, rnorms) bind(C, name="braid_GetRNorms")
+         import :: c_ptr, c_int, c_double
+         type(c_ptr), value :: core
+         integer(c_int)     :: nrequest
+         real(c_double)     :: rnorms(*)
+      end subroutine braid_GetRNorms
+
+      subroutine braid_StepStatusGetLevel(status, level) bind(C, name="braid_StepStatusGetLevel")
+         import :: c_ptr, c_int
+         type(c_ptr), value :: status
+         integer(c_int)     :: level
+      end subroutine braid_StepStatusGetLevel
+
+      subroutine braid_StepStatusGetIter(status, iter) bind(C, name="braid_StepStatusGetIter")
+         import :: c_ptr, c_int
+         type(c_ptr), value :: status
+         integer(c_int)     :: iter
+      end subroutine braid_StepStatusGetIter
+
+      subroutine braid_StepStatusGetTIndex(status, tindex) bind(C, name="braid_StepStatusGetTIndex")
+         import :: c_ptr, c_int
+         type(c_ptr), value :: status
+         integer(c_int)     :: tindex
+      end subroutine braid_StepStatusGetTIndex
+
+      subroutine braid_AccessStatusGetLevel(status, level) bind(C, name="braid_AccessStatusGetLevel")
+         import :: c_ptr, c_int
+         type(c_ptr), value :: status
+         integer(c_int)     :: level
+      end subroutine braid_AccessStatusGetLevel
+
+      subroutine braid_AccessStatusGetIter(status, iter) bind(C, name="braid_AccessStatusGetIter")
+         import :: c_ptr, c_int
+         type(c_ptr), value :: status
+         integer(c_int)     :: iter
+      end subroutine braid_AccessStatusGetIter
+
+      subroutine braid_AccessStatusGetTIndex(status, tindex) bind(C, name="braid_AccessStatusGetTIndex")
+         import :: c_ptr, c_int
+         type(c_ptr), value :: status
+         integer(c_int)     :: tindex
+      end subroutine braid_AccessStatusGetTIndex
+
+      subroutine braid_AccessStatusGetDone(status, done) bind(C, name="braid_AccessStatusGetDone")
+         import :: c_ptr, c_int
+         type(c_ptr), value :: status
+         integer(c_int)     :: done
+      end subroutine braid_AccessStatusGetDone
+   end interface
+
+contains
+
+   !-----------------------------------------------------------------------
+   ! Create the XBraid core.  comm_world and comm are Fortran MPI
+   ! communicators, nvalues is the length of each vector.
+   !-----------------------------------------------------------------------
+   subroutine braid_init_f03(comm_world, comm, tstart, tstop, ntime, app, nvalues, &
+         step, init, access, core)
+      integer,        intent(in)  :: comm_world, comm, ntime, nvalues
+      real(c_double), intent(in)  :: tstart, tstop
+      type(c_ptr),    intent(in)  :: app
+      procedure(braid_step_f03)                :: step
+      procedure(braid_init_vec_f03)            :: init
+      procedure(braid_access_f03),    optional :: access
+      type(c_ptr),    intent(out) :: core
+
+      type(braid_app_f03), pointer :: fapp
+      integer(c_int)               :: ierr
+
+      allocate(fapp)
+      fapp%app     =  app
+      fapp%nvalues =  nvalues
+      fapp%step    => step
+      fapp%init    => init
+      if (present(access)) then
+         fapp%access => access
+      end if
+
+      ierr = braid_F03Init(int(comm_world, c_int), int(comm, c_int), tstart, tstop, &
+            int(ntime, c_int), c_loc(fapp), c_funloc(braid_step_c), c_funloc(braid_init_c), &
+            c_funloc(braid_access_c), c_funloc(braid_bufsize_c), core)
+   end subroutine braid_init_f03
+
+   !-----------------------------------------------------------------------
+   ! Destroy the XBraid core
+   !-----------------------------------------------------------------------
+   subroutine braid_destroy_f03(core)
+      type(c_ptr), intent(inout) :: core
+
+      type(braid_app_f03), pointer :: fapp
+      type(c_ptr)                  :: app
+      integer(c_int)               :: ierr
+
+      ierr = braid_F03Destroy(core, app)
+      call c_f_pointer(app, fapp)
+      deallocate(fapp)
+      core = c_null_ptr
+   end subroutine braid_destroy_f03
+
+   !-----------------------------------------------------------------------
+   ! The routines that XBraid calls (braid_PtFcnStep, braid_PtFcnInit,
+   ! braid_PtFcnAccess and braid_PtFcnBufSize).  They map the vector onto
+   ! an array and call the user's routine.
+   !-----------------------------------------------------------------------
+   function braid_values(u) result(values)
+      type(c_ptr), intent(in)  :: u
+      real(c_double), pointer  :: values(:)
+
+      type(braid_vector_f03), pointer :: vec
+
+      call c_f_pointer(u, vec)
+      call c_f_pointer(vec%values, values, [vec%nvalues])
+   end function braid_values
+
+   integer(c_int) function braid_step_c(app, ustop, fstop, u, status) bind(C)
+      type(c_ptr), value :: app, ustop, fstop, u, status
+
+      type(braid_app_f03), pointer :: fapp
+      real(c_double),      pointer :: uv(:)
+      real(c_double)               :: tstart, tstop
+
+      call c_f_pointer(app, fapp)
+      call braid_StepStatusGetTstartTstop(status, tstart, tstop)
+      uv => braid_values(u)
+      call fapp%step(fapp%app, tstart, tstop, uv, status)
+      braid_step_c = 0
+   end function braid_step_c
+
+   integer(c_int) function braid_init_c(app, t, u_ptr) bind(C)
+      type(c_ptr),    value :: app
+      real(c_double), value :: t
+      type(c_ptr)           :: u_ptr
+
+      type(braid_app_f03), pointer :: fapp
+      real(c_double),      pointer :: uv(:)
+
+      call c_f_pointer(app, fapp)
+      braid_init_c = braid_F03VectorCreate(fapp%nvalues, u_ptr)
+      uv => braid_values(u_ptr)
+      call fapp%init(fapp%app, t, uv)
+   end function braid_init_c
+
+   integer(c_int) function braid_access_c(app, u, status) bind(C)
+      type(c_ptr), value :: app, u, status
+
+      type(braid_app_f03), pointer :: fapp
+      real(c_double)               :: t
+
+      call c_f_pointer(app, fapp)
+      if (associated(fapp%access)) then
+         call braid_AccessStatusGetT(status, t)
+         call fapp%access(fapp%app, t, braid_values(u), status)
+      end if
+      braid_access_c = 0
+   end function braid_access_c
+
+   integer(c_int) function braid_bufsize_c(app, size_ptr, bstatus) bind(C)
+      type(c_ptr), value :: app, bstatus
+      integer(c_int)     :: size_ptr
+
+      type(braid_app_f03), pointer :: fapp
+
+      call c_f_pointer(app, fapp)
+      size_ptr = (fapp%nvalues + 1) * int(c_sizeof(0.0_c_double), c_int)
+      braid_bufsize_c = 0
+   end function braid_bufsize_c
+
+end module braid_mod
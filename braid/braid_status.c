@@ -365,6 +365,15 @@ braid_StatusGetTriT(braid_Status status,
    return _braid_error_flag;
 }
 
+braid_Int
+braid_StatusGetLinearization(braid_Status   status,
+                             void         **lin_ptr
+   )
+{
+   *lin_ptr = _braid_StatusElt(status, tri_lin);
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  * AccessStatus Routines
  *--------------------------------------------------------------------------*/
@@ -568,3 +577,10 @@ ACCESSOR_FUNCTION_SET1(Tri, TightFineTolx, Real)
 ACCESSOR_FUNCTION_SET1(Tri, RFactor,       Real)
 ACCESSOR_FUNCTION_SET1(Tri, RSpace,        Real)
 
+braid_Int
+braid_TriStatusGetLinearization(braid_TriStatus   status,
+                                void            **lin_ptr)
+{
+   return braid_StatusGetLinearization((braid_Status)status, lin_ptr);
+}
+
@@ -435,6 +435,16 @@ braid_StatusGetTriT(braid_Status status,
                     braid_Real  *tnext_ptr
    );
 
+/**
+ * Return the linearization of the current time point, built by the user's
+ * TriLinearize routine (see @ref braid_SetTriNewton).  NULL outside of
+ * TriSolve, or without Newton-TriMGRIT.
+ **/
+braid_Int
+braid_StatusGetLinearization(braid_Status   status,      /**< structure containing current simulation info */
+                             void         **lin_ptr      /**< output, linearization of the current time point */
+   );
+
 /** @}*/
 
 
@@ -551,6 +561,10 @@ ACCESSOR_HEADER_SET1(Tri, TightFineTolx, Real)
 ACCESSOR_HEADER_SET1(Tri, RFactor,       Real)
 ACCESSOR_HEADER_SET1(Tri, RSpace,        Real)
 
+braid_Int
+braid_TriStatusGetLinearization(braid_TriStatus   status,
+                                void            **lin_ptr);
+
 /** @}*/
 
 
@@ -0,0 +1,476 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC. 
+ * Produced at the Lawrence Livermore National Laboratory. Written by 
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin 
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ * 
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+#include <string.h>
+#include "_braid.h"
+#include "_util.h"
+
+/* Checkpoint file layout: a 64 byte header, the global size of each level,
+ * the residual norm history, then one section per level with a fixed-size
+ * record for each time point.  A record holds the time value and one slot per
+ * vector (u and the adjoint on level 0, u, v and f on coarse levels).  Each
+ * slot is an (int32 size, int32 lowprec) pair followed by the BufPack data,
+ * where size -1 marks a vector that is not stored.  Records are addressed by
+ * global index, so a checkpoint can be read on any number of processors.
+ *
+ * TriMGRIT uses the same layout.  It stores every point of level 0, and its
+ * coarse levels are cleaned at the end of each cycle, so they are written as
+ * empty slots.  The ghost layers of ua are refreshed by the first relaxation.
+ * The Newton linearizations (la) are app objects without a BufPack, and the
+ * direct solver factors are derived data, so neither is written.  After a
+ * read they are rebuilt at the restored iterate in the first cycle. */
+#define _braid_CHECKPOINT_HEADER  64
+#define _braid_CHECKPOINT_SLOT    8
+#define _braid_CheckpointNSlots(level)  ( (level) == 0 ? 2 : 3 )
+
+/*----------------------------------------------------------------------------
+ * Check for features that checkpoints do not support
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CheckpointCheck(braid_Core  core)
+{
+   if ( _braid_CoreElt(core, useshell) || (_braid_CoreElt(core, nchunks) > 1) )
+   {
+      _braid_Error(braid_ERROR_GENERIC,
+                   "Checkpoints are not supported with shell vectors or time chunks");
+      return braid_ERROR_GENERIC;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Pack vector u (possibly NULL) into a checkpoint slot
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CheckpointPack(braid_Core        core,
+                      void             *slot,
+                      braid_BaseVector  u)
+{
+   braid_App           app     = _braid_CoreElt(core, app);
+   braid_BufferStatus  bstatus = (braid_BufferStatus)core;
+   char               *data    = (char *) slot + _braid_CHECKPOINT_SLOT;
+   int32_t             head[2] = {-1, 0};
+   braid_Int           size;
+
+   if (u != NULL)
+   {
+      /* Call the user's BufPack directly, so nothing is recorded for the adjoint */
+      _braid_BufferStatusInit(0, 0, bstatus);
+      _braid_CoreFcn(core, bufsize)(app, &size, bstatus);
+      _braid_StatusElt(bstatus, size_buffer) = size;
+      _braid_CorePrecFcn(core, u, bufpack)(app, u->userVector, data, bstatus);
+      head[0] = (int32_t) _braid_StatusElt(bstatus, size_buffer);
+      head[1] = (int32_t) u->lowprec;
+   }
+   memcpy(slot, head, _braid_CHECKPOINT_SLOT);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Unpack a checkpoint slot into a vector for grid level (NULL if empty)
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CheckpointUnpack(braid_Core         core,
+                        braid_Int          level,
+                        void              *slot,
+                        braid_BaseVector  *u_ptr)
+{
+   braid_App           app     = _braid_CoreElt(core, app);
+   braid_BufferStatus  bstatus = (braid_BufferStatus)core;
+   char               *data    = (char *) slot + _braid_CHECKPOINT_SLOT;
+   int32_t             head[2];
+   braid_BaseVector    u, v;
+
+   memcpy(head, slot, _braid_CHECKPOINT_SLOT);
+   if (head[0] < 0)
+   {
+      *u_ptr = NULL;
+      return _braid_error_flag;
+   }
+
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_StatusElt(bstatus, size_buffer) = head[0];
+   if (head[1])
+   {
+      _braid_BaseBufUnpackLowPrec(core, app, data, &u, bstatus);
+   }
+   else
+   {
+      _braid_BaseBufUnpack(core, app, data, &u, bstatus);
+   }
+
+   /* Convert if the precision of this level changed since the checkpoint */
+   if (u->lowprec != _braid_IsLowPrec(core, level))
+   {
+      _braid_BaseConvertPrec(core, app, u, !(u->lowprec), &v);
+      _braid_BaseFree(core, app, u);
+      u = v;
+   }
+
+   *u_ptr = u;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Write the state of all grid levels to a checkpoint file
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_WriteCheckpoint(braid_Core   core,
+                       const char  *filename)
+{
+   MPI_Comm            comm     = _braid_CoreElt(core, comm);
+   braid_Int           myid     = _braid_CoreElt(core, myid);
+   braid_App           app      = _braid_CoreElt(core, app);
+   braid_BufferStatus  bstatus  = (braid_BufferStatus)core;
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   braid_Int           nlevels  = _braid_CoreElt(core, nlevels);
+   braid_Int           niter    = _braid_CoreElt(core, niter);
+   braid_Int           adjoint  = _braid_CoreElt(core, adjoint);
+   braid_Real         *rnorms   = _braid_CoreElt(core, rnorms);
+
+   _braid_File         fh;
+   int64_t             header[_braid_CHECKPOINT_HEADER/8];
+   int64_t            *gsizes;
+   double             *norms;
+   int64_t             offset;
+   char               *buffer, *rec;
+   double              t64;
+   braid_BaseVector    u, *va, *fa;
+   braid_Real         *ta;
+   braid_Int           datasize, recsize, slotsize, nslots;
+   braid_Int           level, ilower, iupper, i, iu, sflag;
+   struct _braid_BaseVector_struct  w;
+
+   if (!_braid_CoreElt(core, warm_restart))
+   {
+      _braid_Error(braid_ERROR_GENERIC, "Nothing to checkpoint before braid_Drive()");
+      return _braid_error_flag;
+   }
+   if (_braid_CheckpointCheck(core))
+   {
+      return _braid_error_flag;
+   }
+
+   /* All vectors are packed into slots of the same size */
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_CoreFcn(core, bufsize)(app, &datasize, bstatus);
+   datasize = 8*((datasize + 7)/8);
+   slotsize = _braid_CHECKPOINT_SLOT + datasize;
+
+   /* Header: magic, version, fine grid size, number of levels, data size,
+    * iterations, refinements, adjoint */
+   memset(header, 0, _braid_CHECKPOINT_HEADER);
+   memcpy(header, "XBRDCKP", 8);
+   header[1] = 1;
+   header[2] = (int64_t) _braid_CoreElt(core, gupper);
+   header[3] = (int64_t) nlevels;
+   header[4] = (int64_t) datasize;
+   header[5] = (int64_t) niter;
+   header[6] = (int64_t) _braid_CoreElt(core, nrefine);
+   header[7] = (int64_t) adjoint;
+
+   gsizes = _braid_CTAlloc(int64_t, nlevels);
+   for (level = 0; level < nlevels; level++)
+   {
+      gsizes[level] = (int64_t) _braid_GridElt(grids[level], gupper);
+   }
+   norms = _braid_CTAlloc(double, niter+2);
+   norms[0] = (double) _braid_CoreElt(core, rnorm0);
+   for (i = 0; i <= niter; i++)
+   {
+      norms[i+1] = (double) rnorms[i];
+   }
+
+   if (_braid_FileOpen(comm, filename, 1, &fh))
+   {
+      _braid_TFree(gsizes);
+      _braid_TFree(norms);
+      return _braid_error_flag;
+   }
+   if (myid == 0)
+   {
+      _braid_FileWriteAt(fh, 0, 0, header, 1, _braid_CHECKPOINT_HEADER);
+      _braid_FileWriteAt(fh, 0, _braid_CHECKPOINT_HEADER, gsizes, nlevels, 8);
+      _braid_FileWriteAt(fh, 0, _braid_CHECKPOINT_HEADER + 8*nlevels, norms, niter+2, 8);
+   }
+   offset = _braid_CHECKPOINT_HEADER + 8*nlevels + 8*(niter+2);
+
+   /* One collective write per level of the contiguous local records */
+   for (level = 0; level < nlevels; level++)
+   {
+      ilower  = _braid_GridElt(grids[level], ilower);
+      iupper  = _braid_GridElt(grids[level], iupper);
+      ta      = _braid_GridElt(grids[level], ta);
+      va      = _braid_GridElt(grids[level], va);
+      fa      = _braid_GridElt(grids[level], fa);
+      nslots  = _braid_CheckpointNSlots(level);
+      recsize = 8 + nslots*slotsize;
+
+      buffer = _braid_CTAlloc(char, (size_t)(iupper-ilower+1)*recsize);
+      for (i = ilower; i <= iupper; i++)
+      {
+         rec = buffer + (size_t)(i-ilower)*recsize;
+         t64 = (double) ta[i-ilower];
+         memcpy(rec, &t64, 8);
+
+         _braid_UGetIndex(core, level, i, &iu, &sflag);
+         u = NULL;
+         if (iu > -1)
+         {
+            /* Decompresses a compressed F-point */
+            _braid_UGetVectorRef(core, level, i, &u);
+         }
+         _braid_CheckpointPack(core, rec + 8, u);
+
+         if (level == 0)
+         {
+            /* Adjoint vectors are stored at the same points as u */
+            u = NULL;
+            if (adjoint && (iu > -1))
+            {
+               w.userVector = _braid_CoreElt(core, optim)->adjoints[iu];
+               w.bar        = NULL;
+               w.lowprec    = 0;
+               u = &w;
+            }
+            _braid_CheckpointPack(core, rec + 8 + slotsize, u);
+         }
+         else
+         {
+            _braid_CheckpointPack(core, rec + 8 + slotsize, va[i-ilower]);
+            _braid_CheckpointPack(core, rec + 8 + 2*slotsize, fa[i-ilower]);
+         }
+      }
+      _braid_FileWriteAt(fh, 1, offset + (int64_t) ilower*recsize, buffer,
+                         iupper-ilower+1, recsize);
+      _braid_TFree(buffer);
+
+      offset += (gsizes[level] + 1)*recsize;
+   }
+
+   _braid_FileClose(&fh);
+   _braid_TFree(gsizes);
+   _braid_TFree(norms);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Build the grid hierarchy from a checkpoint file
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ReadCheckpoint(braid_Core   core,
+                      const char  *filename)
+{
+   MPI_Comm            comm     = _braid_CoreElt(core, comm);
+   braid_App           app      = _braid_CoreElt(core, app);
+   braid_BufferStatus  bstatus  = (braid_BufferStatus)core;
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   braid_Int           max_iter = _braid_CoreElt(core, max_iter);
+   braid_Int           adjoint  = _braid_CoreElt(core, adjoint);
+   braid_Int           record   = _braid_CoreElt(core, record);
+   braid_Real         *rnorms   = _braid_CoreElt(core, rnorms);
+
+   _braid_File         fh;
+   _braid_Grid        *grid;
+   int64_t             header[_braid_CHECKPOINT_HEADER/8];
+   int64_t            *gsizes;
+   double             *norms;
+   int64_t             offset;
+   char               *buffer, *buffer0, *rec;
+   double              t64;
+   braid_BaseVector    u, *va, *fa;
+   braid_Vector        adj;
+   braid_Real         *ta;
+   braid_Int           datasize, recsize, slotsize, nslots, nlevels, niter;
+   braid_Int           level, ilower, iupper, i, iu, sflag;
+
+   if (_braid_CoreElt(core, warm_restart))
+   {
+      _braid_Error(braid_ERROR_GENERIC, "Checkpoints must be read before braid_Drive()");
+      return _braid_error_flag;
+   }
+   if (_braid_CheckpointCheck(core))
+   {
+      return _braid_error_flag;
+   }
+
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_CoreFcn(core, bufsize)(app, &datasize, bstatus);
+   datasize = 8*((datasize + 7)/8);
+   slotsize = _braid_CHECKPOINT_SLOT + datasize;
+
+   if (_braid_FileOpen(comm, filename, 0, &fh))
+   {
+      return _braid_error_flag;
+   }
+   _braid_FileReadAt(fh, 1, 0, header, 1, _braid_CHECKPOINT_HEADER);
+   if ( (memcmp(header, "XBRDCKP", 8) != 0) || (header[4] != datasize) )
+   {
+      _braid_Error(braid_ERROR_GENERIC, "Not a checkpoint file for this BufSize");
+      _braid_FileClose(&fh);
+      return _braid_error_flag;
+   }
+   nlevels = (braid_Int) header[3];
+   niter   = (braid_Int) header[5];
+
+   gsizes = _braid_CTAlloc(int64_t, nlevels);
+   norms  = _braid_CTAlloc(double, niter+2);
+   _braid_FileReadAt(fh, 1, _braid_CHECKPOINT_HEADER, gsizes, nlevels, 8);
+   _braid_FileReadAt(fh, 1, _braid_CHECKPOINT_HEADER + 8*nlevels, norms, niter+2, 8);
+   offset = _braid_CHECKPOINT_HEADER + 8*nlevels + 8*(niter+2);
+
+   /* Restore the fine grid size and the residual norm history */
+   _braid_CoreElt(core, ntime)   = (braid_Int) header[2];
+   _braid_CoreElt(core, gupper)  = (braid_Int) header[2];
+   _braid_CoreElt(core, nrefine) = (braid_Int) header[6];
+   _braid_CoreElt(core, rnorm0)  = (braid_Real) norms[0];
+   niter = _braid_min(niter, max_iter);
+   for (i = 0; i <= niter; i++)
+   {
+      rnorms[i] = (braid_Real) norms[i+1];
+   }
+   _braid_CoreElt(core, niter) = niter;
+
+   /* Create the fine grid with the time values in the checkpoint, then the
+    * grid hierarchy on top of it */
+   _braid_GetDistribution(core, &ilower, &iupper);
+   _braid_GridInit(core, 0, ilower, iupper, &grid);
+   ta      = _braid_GridElt(grid, ta);
+   recsize = 8 + _braid_CheckpointNSlots(0)*slotsize;
+   buffer0 = _braid_CTAlloc(char, (size_t)(iupper-ilower+1)*recsize);
+   _braid_FileReadAt(fh, 1, offset + (int64_t) ilower*recsize, buffer0,
+                     iupper-ilower+1, recsize);
+   for (i = ilower; i <= iupper; i++)
+   {
+      memcpy(&t64, buffer0 + (size_t)(i-ilower)*recsize, 8);
+      ta[i-ilower] = (braid_Real) t64;
+   }
+   _braid_InitHierarchy(core, grid, 0);
+
+   /* Nothing read here goes to the adjoint tape */
+   _braid_CoreElt(core, record) = 0;
+
+   /* Coarse levels are only read while they match the checkpoint, else
+    * they are set up from level 0 in the first cycle as usual */
+   nlevels = _braid_min(nlevels, _braid_CoreElt(core, nlevels));
+   for (level = 0; level < nlevels; level++)
+   {
+      ilower  = _braid_GridElt(grids[level], ilower);
+      iupper  = _braid_GridElt(grids[level], iupper);
+      ta      = _braid_GridElt(grids[level], ta);
+      va      = _braid_GridElt(grids[level], va);
+      fa      = _braid_GridElt(grids[level], fa);
+      nslots  = _braid_CheckpointNSlots(level);
+      recsize = 8 + nslots*slotsize;
+
+      if (level == 0)
+      {
+         buffer = buffer0;
+      }
+      else
+      {
+         if (gsizes[level] != _braid_GridElt(grids[level], gupper))
+         {
+            break;
+         }
+         buffer = _braid_CTAlloc(char, (size_t)(iupper-ilower+1)*recsize);
+         _braid_FileReadAt(fh, 1, offset + (int64_t) ilower*recsize, buffer,
+                           iupper-ilower+1, recsize);
+      }
+
+      for (i = ilower; i <= iupper; i++)
+      {
+         rec = buffer + (size_t)(i-ilower)*recsize;
+
+         _braid_UGetIndex(core, level, i, &iu, &sflag);
+         _braid_CheckpointUnpack(core, level, rec + 8, &u);
+         if (iu > -1)
+         {
+            if ( (u == NULL) && (level == 0) )
+            {
+               /* Not in the checkpoint (other storage setting) */
+               _braid_BaseInit(core, app, ta[i-ilower], &u);
+            }
+            _braid_USetVectorRef(core, level, i, u);
+         }
+         else if (u != NULL)
+         {
+            _braid_BaseFree(core, app, u);
+         }
+
+         if (level > 0)
+         {
+            _braid_CheckpointUnpack(core, level, rec + 8 + slotsize, &va[i-ilower]);
+            _braid_CheckpointUnpack(core, level, rec + 8 + 2*slotsize, &fa[i-ilower]);
+         }
+      }
+
+      if (level > 0)
+      {
+         _braid_TFree(buffer);
+      }
+      offset += (gsizes[level] + 1)*recsize;
+   }
+
+   /* Initialize the adjoint variables, then restore them */
+   if (adjoint)
+   {
+      _braid_InitAdjointVars(core, grids[0]);
+      ilower  = _braid_GridElt(grids[0], ilower);
+      iupper  = _braid_GridElt(grids[0], iupper);
+      recsize = 8 + _braid_CheckpointNSlots(0)*slotsize;
+      for (i = ilower; i <= iupper; i++)
+      {
+         rec = buffer0 + (size_t)(i-ilower)*recsize + 8 + slotsize;
+         _braid_UGetIndex(core, 0, i, &iu, &sflag);
+         if ( (iu > -1) && (*((int32_t *) rec) > -1) )
+         {
+            _braid_BufferStatusInit(0, 0, bstatus);
+            _braid_CoreFcn(core, bufunpack)(app, rec + _braid_CHECKPOINT_SLOT, &adj, bstatus);
+            _braid_CoreFcn(core, free)(app, _braid_CoreElt(core, optim)->adjoints[iu]);
+            _braid_CoreElt(core, optim)->adjoints[iu] = adj;
+         }
+      }
+   }
+
+   _braid_CoreElt(core, record) = record;
+
+   /* Let braid_Drive() continue from here */
+   _braid_CoreElt(core, warm_restart) = 1;
+
+   _braid_FileClose(&fh);
+   _braid_TFree(buffer0);
+   _braid_TFree(gsizes);
+   _braid_TFree(norms);
+
+   return _braid_error_flag;
+}
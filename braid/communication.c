@@ -21,6 +21,8 @@
  *
  ***********************************************************************EHEADER*/
 
+#include <float.h>
+#include <sched.h>
 #include "_braid.h"
 #include "_util.h"
 
@@ -36,11 +38,16 @@ _braid_CommRecvInit(braid_Core           core,
 {
    MPI_Comm            comm = _braid_CoreElt(core, comm);
    braid_App           app  = _braid_CoreElt(core, app);
+   _braid_Grid       **grids  = _braid_CoreElt(core, grids);
+   braid_Int           ilower = _braid_GridElt(grids[level], ilower);
+   braid_Real         *ta     = _braid_GridElt(grids[level], ta);
    _braid_CommHandle  *handle = NULL;
-   void               *buffer;
+   void               *buffer = NULL;
+   braid_BaseVector    vector = NULL;
+   MPI_Datatype        dtype;
    MPI_Request        *requests;
    MPI_Status         *status;
-   braid_Int           proc, size, num_requests;
+   braid_Int           proc, size, num_requests, shm = 0;
    braid_BufferStatus bstatus = (braid_BufferStatus)core;
 
    _braid_GetProc(core, level, index, &proc);
@@ -48,15 +55,36 @@ _braid_CommRecvInit(braid_Core           core,
    {
       handle = _braid_TAlloc(_braid_CommHandle, 1);
 
-      /* Allocate buffer through user routine */
-      _braid_BufferStatusInit( 0, 0, bstatus );
-      _braid_BaseBufSize(core, app,  &size, bstatus);
-      buffer = malloc(size);
-
       num_requests = 1;
       requests = _braid_CTAlloc(MPI_Request, num_requests);
       status   = _braid_CTAlloc(MPI_Status, num_requests);
-      MPI_Irecv(buffer, size, MPI_BYTE, proc, 0, comm, &requests[0]);
+
+      if (_braid_CommInPlace(core))
+      {
+         /* Receive directly into a new vector allocated by the user */
+         _braid_BaseBufDescribe(core, app, level, ta[index-ilower], &vector, &dtype);
+         MPI_Irecv(MPI_BOTTOM, 1, dtype, proc, 0, comm, &requests[0]);
+         _braid_CommHandleElt(handle, dtype) = dtype;
+      }
+      else
+      {
+         /* Allocate buffer through user routine, plus room for the header */
+         _braid_BufferStatusInit( 0, 0, bstatus );
+         _braid_BaseBufSize(core, app,  &size, bstatus);
+         size += _braid_CommHeaderSize(core);
+         buffer = malloc(size);
+
+         if (proc == _braid_CoreElt(core, shm_left))
+         {
+            /* Time neighbor on this node, receive through shared memory */
+            num_requests = 0;
+            shm = 1;
+         }
+         else
+         {
+            MPI_Irecv(buffer, size, MPI_BYTE, proc, 0, comm, &requests[0]);
+         }
+      }
 
       _braid_CommHandleElt(handle, request_type) = 1; /* recv type = 1 */
       _braid_CommHandleElt(handle, num_requests) = num_requests;
@@ -64,6 +92,16 @@ _braid_CommRecvInit(braid_Core           core,
       _braid_CommHandleElt(handle, status)       = status;
       _braid_CommHandleElt(handle, buffer)       = buffer;
       _braid_CommHandleElt(handle, vector_ptr)   = vector_ptr;
+      _braid_CommHandleElt(handle, level)        = level;
+      _braid_CommHandleElt(handle, vector)       = vector;
+      _braid_CommHandleElt(handle, shm)          = 0;
+
+      if (shm)
+      {
+         _braid_ShmCommPost(core, handle);
+      }
+
+      _braid_CommCount(core, level, size);
    }
 
    *handle_ptr = handle;
@@ -83,11 +121,16 @@ _braid_CommSendInit(braid_Core           core,
 {
    MPI_Comm            comm = _braid_CoreElt(core, comm);
    braid_App           app  = _braid_CoreElt(core, app);
+   _braid_Grid       **grids  = _braid_CoreElt(core, grids);
+   braid_Int           ilower = _braid_GridElt(grids[level], ilower);
+   braid_Real         *ta     = _braid_GridElt(grids[level], ta);
    _braid_CommHandle  *handle = NULL;
-   void               *buffer;
+   void               *buffer = NULL;
+   braid_BaseVector    svector = NULL;
+   MPI_Datatype        dtype;
    MPI_Request        *requests;
    MPI_Status         *status;
-   braid_Int           proc, size, num_requests;
+   braid_Int           proc, size, hsize, num_requests, shm = 0;
    braid_BufferStatus  bstatus   = (braid_BufferStatus)core;
 
 
@@ -96,29 +139,68 @@ _braid_CommSendInit(braid_Core           core,
    {
       handle = _braid_TAlloc(_braid_CommHandle, 1);
 
-      /* Allocate buffer through user routine */
-      _braid_BufferStatusInit( 0, 0, bstatus );
-      _braid_BaseBufSize(core, app,  &size, bstatus);
-      buffer = malloc(size);
-
-      /* Store the receiver rank in the status */
-      _braid_StatusElt(bstatus, send_recv_rank) = proc;
-
-      /* Note that bufpack may return a size smaller than bufsize */
-      _braid_StatusElt(bstatus, size_buffer) = size;
-      _braid_BaseBufPack(core, app,  vector, buffer, bstatus);
-      size = _braid_StatusElt( bstatus, size_buffer );
-
       num_requests = 1;
       requests = _braid_CTAlloc(MPI_Request, num_requests);
       status   = _braid_CTAlloc(MPI_Status, num_requests);
-      MPI_Isend(buffer, size, MPI_BYTE, proc, 0, comm, &requests[0]);
+
+      if (_braid_CommInPlace(core))
+      {
+         /* Send from a private copy, because XBraid may change or free the
+          * vector before the send completes */
+         _braid_BaseClone(core, app, vector, &svector);
+         _braid_BaseBufDescribe(core, app, level, ta[index-ilower], &svector, &dtype);
+         MPI_Isend(MPI_BOTTOM, 1, dtype, proc, 0, comm, &requests[0]);
+         _braid_CommHandleElt(handle, dtype) = dtype;
+         MPI_Type_size(dtype, &size);
+      }
+      else
+      {
+         /* Allocate buffer through user routine, plus room for the header */
+         _braid_BufferStatusInit( 0, 0, bstatus );
+         _braid_BaseBufSize(core, app,  &size, bstatus);
+         hsize  = _braid_CommHeaderSize(core);
+         buffer = malloc(hsize + size);
+
+         /* Store the receiver rank in the status */
+         _braid_StatusElt(bstatus, send_recv_rank) = proc;
+
+         /* Note that bufpack may return a size smaller than bufsize */
+         _braid_StatusElt(bstatus, size_buffer) = size;
+         _braid_BaseBufPack(core, app,  vector, (char *)buffer + hsize, bstatus);
+         size = _braid_StatusElt( bstatus, size_buffer );
+
+         /* Compress the message, if requested */
+         if (hsize > 0)
+         {
+            _braid_CommCompress(core, level, vector, buffer, &size);
+         }
+
+         if (proc == _braid_CoreElt(core, shm_right))
+         {
+            /* Time neighbor on this node, send through shared memory */
+            num_requests = 0;
+            shm = 1;
+         }
+         else
+         {
+            MPI_Isend(buffer, size, MPI_BYTE, proc, 0, comm, &requests[0]);
+         }
+      }
 
       _braid_CommHandleElt(handle, request_type) = 0; /* send type = 0 */
       _braid_CommHandleElt(handle, num_requests) = num_requests;
       _braid_CommHandleElt(handle, requests)     = requests;
       _braid_CommHandleElt(handle, status)       = status;
       _braid_CommHandleElt(handle, buffer)       = buffer;
+      _braid_CommHandleElt(handle, level)        = level;
+      _braid_CommHandleElt(handle, vector)       = svector;
+      _braid_CommHandleElt(handle, size)         = size;
+      _braid_CommHandleElt(handle, shm)          = 0;
+
+      if (shm)
+      {
+         _braid_ShmCommPost(core, handle);
+      }
    }
 
    *handle_ptr = handle;
@@ -126,6 +208,477 @@ _braid_CommSendInit(braid_Core           core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Compression is active on 'level' while the residual is above rfactor*tol.
+ * The last available residual norm is used, and every message carries its own
+ * codec in the header, so the sender and receiver never need to agree.
+ *
+ * A lossy codec puts a floor under the residual: the single precision values
+ * are off by up to FLT_EPSILON times the vector, so the iteration stalls near
+ * FLT_EPSILON*|u| if tol is below that.  Messages are therefore sent in full
+ * precision once the residual is within rfactor of this floor, and for the
+ * rest of the run once the residual stops decreasing (conv factor above
+ * _braid_COMM_STALL), which also covers user codecs.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommCompress(braid_Core        core,
+                    braid_Int         level,
+                    braid_BaseVector  vector,
+                    void             *buffer,
+                    braid_Int        *size_ptr)
+{
+   braid_App                 app            = _braid_CoreElt(core, app);
+   braid_Int                 compress_level = _braid_CoreElt(core, compress_level);
+   braid_Real                rfactor        = _braid_CoreElt(core, compress_rfactor);
+   braid_Real                tol            = _braid_CoreElt(core, tol);
+   braid_Int                 rtol           = _braid_CoreElt(core, rtol);
+   braid_Real                rnorm0         = _braid_CoreElt(core, rnorm0);
+   braid_Real               *rnorms         = _braid_CoreElt(core, rnorms);
+   braid_Int                 niter          = _braid_CoreElt(core, niter);
+   braid_PtFcnBufCompress    bufcompress    = _braid_CoreElt(core, bufcompress);
+   braid_Int                 hsize          = _braid_CommHeaderSize(core);
+   braid_Int                 size           = *size_ptr;
+   braid_Int                *header         = (braid_Int *) buffer;
+   void                     *message        = (char *)buffer + hsize;
+
+   braid_Int                 codec, csize, i, n;
+   braid_Real                rnorm, unorm, *dbuf;
+   float                    *fbuf;
+   void                     *cbuffer;
+
+   codec = _braid_COMM_RAW;
+   csize = size;
+
+   if (level >= compress_level)
+   {
+      /* Use the latest residual norm, and compress if none is available yet */
+      _braid_GetRNorm(core, -1, &rnorm);
+      if (rnorm == braid_INVALID_RNORM)
+      {
+         _braid_GetRNorm(core, -2, &rnorm);
+      }
+      if (rtol)
+      {
+         tol *= rnorm0;
+      }
+      if ( (rnorm == braid_INVALID_RNORM) || (rtol && (rnorm0 == braid_INVALID_RNORM)) ||
+           (rnorm > rfactor*tol) )
+      {
+         codec = _braid_COMM_FLOAT;
+         if (_braid_IsLowPrec(core, level))
+         {
+            /* Already packed in the coarse-level precision */
+            codec = _braid_COMM_RAW;
+         }
+         if (bufcompress != NULL)
+         {
+            codec = _braid_COMM_USER;
+         }
+      }
+
+      /* Full precision near the error floor of single precision */
+      if ( (codec == _braid_COMM_FLOAT) && (rnorm != braid_INVALID_RNORM) )
+      {
+         _braid_BaseSpatialNorm(core, app, vector, &unorm);
+         if (rnorm <= rfactor*FLT_EPSILON*unorm)
+         {
+            codec = _braid_COMM_RAW;
+         }
+      }
+
+      /* Full precision for the rest of the run, once the residual stalled */
+      for (i = 2; (i <= niter) && (codec != _braid_COMM_RAW); i++)
+      {
+         if ( (rnorms[i-1] != braid_INVALID_RNORM) && (rnorms[i] != braid_INVALID_RNORM) &&
+              (rnorms[i] > _braid_COMM_STALL*rnorms[i-1]) )
+         {
+            codec = _braid_COMM_RAW;
+         }
+      }
+   }
+
+   if (codec == _braid_COMM_FLOAT)
+   {
+      /* Truncate to single precision, unless a value does not fit */
+      n    = size / sizeof(braid_Real);
+      dbuf = (braid_Real *) message;
+      if ( (size % sizeof(braid_Real)) != 0 )
+      {
+         codec = _braid_COMM_RAW;
+      }
+      for (i = 0; (i < n) && (codec == _braid_COMM_FLOAT); i++)
+      {
+         if ( !(fabs(dbuf[i]) <= FLT_MAX) )
+         {
+            codec = _braid_COMM_RAW;
+         }
+      }
+      if (codec == _braid_COMM_FLOAT)
+      {
+         csize = n*sizeof(float);
+         fbuf  = (float *) malloc(csize);
+         for (i = 0; i < n; i++)
+         {
+            fbuf[i] = (float) dbuf[i];
+         }
+         memcpy(message, fbuf, csize);
+         free(fbuf);
+      }
+   }
+   else if (codec == _braid_COMM_USER)
+   {
+      cbuffer = malloc(size);
+      csize   = 0;
+      bufcompress(app, message, size, tol, cbuffer, &csize);
+      if ( (csize > 0) && (csize < size) )
+      {
+         memcpy(message, cbuffer, csize);
+      }
+      else
+      {
+         codec = _braid_COMM_RAW;
+         csize = size;
+      }
+      free(cbuffer);
+   }
+
+   header[0] = codec;
+   header[1] = size;
+   header[2] = csize;
+   *size_ptr = hsize + csize;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommDecompress(braid_Core   core,
+                      void        *buffer,
+                      void       **message_ptr)
+{
+   braid_App                 app            = _braid_CoreElt(core, app);
+   braid_PtFcnBufDecompress  bufdecompress  = _braid_CoreElt(core, bufdecompress);
+   braid_Int                 hsize          = _braid_CommHeaderSize(core);
+   braid_Int                *header         = (braid_Int *) buffer;
+   braid_Int                 codec          = header[0];
+   braid_Int                 size           = header[1];
+   braid_Int                 csize          = header[2];
+   void                     *message        = (char *)buffer + hsize;
+
+   braid_Int                 i, n;
+   braid_Real               *dbuf;
+   float                    *fbuf;
+   void                     *cbuffer;
+
+   if (codec == _braid_COMM_FLOAT)
+   {
+      n    = size / sizeof(braid_Real);
+      dbuf = (braid_Real *) message;
+      fbuf = (float *) malloc(csize);
+      memcpy(fbuf, message, csize);
+      for (i = 0; i < n; i++)
+      {
+         dbuf[i] = (braid_Real) fbuf[i];
+      }
+      free(fbuf);
+   }
+   else if (codec == _braid_COMM_USER)
+   {
+      /* Decompress from a copy, back into the receive buffer */
+      cbuffer = malloc(csize);
+      memcpy(cbuffer, message, csize);
+      bufdecompress(app, cbuffer, csize, message, size);
+      free(cbuffer);
+   }
+
+   *message_ptr = message;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Each rank with a same-node left neighbor owns one message slot in the shared
+ * window.  A slot starts with a header of two braid_Reals, holding a full flag,
+ * the message size and the message number, followed by the message.  The flag
+ * is only set by the writer (left neighbor) and only cleared by the reader
+ * (slot owner), with atomic release/acquire accesses, so the message is
+ * complete before the slot is marked full, and read before it is marked empty.
+ *
+ * All work is done by the main thread.  A send is written into the slot right
+ * away if it is empty, and otherwise goes out with MPI_Isend on tag 6 (not used
+ * by other XBraid messages), so sends never wait for the receiver.  The
+ * receiver takes its messages in order, from the slot or from MPI, matching
+ * them by message number.  The oldest receive is unpacked directly from the
+ * slot in _braid_CommWait, and the slot is released after.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmCommInit(braid_Core  core)
+{
+#ifndef braid_SEQUENTIAL
+   MPI_Comm            comm    = _braid_CoreElt(core, comm);
+   braid_Int           myid    = _braid_CoreElt(core, myid);
+   braid_App           app     = _braid_CoreElt(core, app);
+   braid_BufferStatus  bstatus = (braid_BufferStatus)core;
+   braid_Int           hsize   = 2*sizeof(braid_Real);
+
+   MPI_Comm            shm_comm;
+   MPI_Group           group, shm_group;
+   MPI_Win             win;
+   MPI_Aint            wsize, rsize;
+   braid_Int           nprocs, size, disp_unit;
+   braid_Int           ranks[2], shm_ranks[2];
+   void               *base, *rbase = NULL;
+
+   if (_braid_CoreElt(core, shm_active))
+   {
+      return _braid_error_flag;
+   }
+
+   MPI_Comm_size(comm, &nprocs);
+   MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, myid, MPI_INFO_NULL, &shm_comm);
+
+   /* Find the time neighbors that share memory with me */
+   ranks[0] = (myid > 0)        ? myid-1 : MPI_PROC_NULL;
+   ranks[1] = (myid < nprocs-1) ? myid+1 : MPI_PROC_NULL;
+   MPI_Comm_group(comm, &group);
+   MPI_Comm_group(shm_comm, &shm_group);
+   MPI_Group_translate_ranks(group, 2, ranks, shm_group, shm_ranks);
+   MPI_Group_free(&group);
+   MPI_Group_free(&shm_group);
+
+   _braid_CoreElt(core, shm_left)  = -1;
+   _braid_CoreElt(core, shm_right) = -1;
+   if ( (shm_ranks[0] != MPI_UNDEFINED) && (shm_ranks[0] != MPI_PROC_NULL) )
+   {
+      _braid_CoreElt(core, shm_left) = myid-1;
+   }
+   if ( (shm_ranks[1] != MPI_UNDEFINED) && (shm_ranks[1] != MPI_PROC_NULL) )
+   {
+      _braid_CoreElt(core, shm_right) = myid+1;
+   }
+
+   /* Slots hold the largest message, including the compression header */
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_BaseBufSize(core, app,  &size, bstatus);
+   size += _braid_CommHeaderSize(core);
+
+   wsize = 0;
+   if (_braid_CoreElt(core, shm_left) > -1)
+   {
+      wsize = hsize + size;
+   }
+   MPI_Win_allocate_shared(wsize, 1, MPI_INFO_NULL, shm_comm, &base, &win);
+   if (_braid_CoreElt(core, shm_right) > -1)
+   {
+      MPI_Win_shared_query(win, shm_ranks[1], &rsize, &disp_unit, &rbase);
+   }
+   MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+   if (wsize > 0)
+   {
+      ((volatile braid_Int *) base)[0] = 0;
+   }
+   MPI_Win_sync(win);
+   MPI_Barrier(shm_comm);
+   MPI_Win_sync(win);
+
+   _braid_CoreElt(core, shm_comm)      = shm_comm;
+   _braid_CoreElt(core, shm_win)       = win;
+   _braid_CoreElt(core, shm_slot_size) = size;
+   _braid_CoreElt(core, shm_recv_slot) = (wsize > 0) ? base : NULL;
+   _braid_CoreElt(core, shm_send_slot) = rbase;
+   _braid_CoreElt(core, shm_recvs)     = NULL;
+   _braid_CoreElt(core, shm_nsends)    = 0;
+   _braid_CoreElt(core, shm_nrecvs)    = 0;
+   _braid_CoreElt(core, shm_active)    = 1;
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Every send and receive has completed by now, so a message still in a slot
+ * was never received.  MPI_Win_free is collective on the node communicator,
+ * so no rank frees its slot while its left neighbor may still write to it.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmCommDestroy(braid_Core  core)
+{
+#ifndef braid_SEQUENTIAL
+   if (_braid_CoreElt(core, shm_active))
+   {
+      MPI_Win_unlock_all(_braid_CoreElt(core, shm_win));
+      MPI_Win_free(&_braid_CoreElt(core, shm_win));
+      MPI_Comm_free(&_braid_CoreElt(core, shm_comm));
+      _braid_CoreElt(core, shm_left)      = -1;
+      _braid_CoreElt(core, shm_right)     = -1;
+      _braid_CoreElt(core, shm_recv_slot) = NULL;
+      _braid_CoreElt(core, shm_send_slot) = NULL;
+      _braid_CoreElt(core, shm_active)    = 0;
+   }
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmCommPost(braid_Core          core,
+                   _braid_CommHandle  *handle)
+{
+#ifndef braid_SEQUENTIAL
+   MPI_Comm             comm  = _braid_CoreElt(core, comm);
+   braid_Int            hsize = 2*sizeof(braid_Real);
+   void                *sslot = _braid_CoreElt(core, shm_send_slot);
+   braid_Int           *flag;
+   _braid_CommHandle  **queue;
+
+   if (_braid_CommHandleElt(handle, request_type) == 1)
+   {
+      /* Append to the end of the receive queue */
+      queue = &_braid_CoreElt(core, shm_recvs);
+      while (*queue != NULL)
+      {
+         queue = &_braid_CommHandleElt((*queue), shm_next);
+      }
+      *queue = handle;
+      _braid_CommHandleElt(handle, shm)      = 1;
+      _braid_CommHandleElt(handle, shm_seq)  = _braid_CoreElt(core, shm_nrecvs)++;
+      _braid_CommHandleElt(handle, shm_next) = NULL;
+   }
+   else
+   {
+      flag = (braid_Int *) sslot;
+      _braid_CommHandleElt(handle, shm_seq) = _braid_CoreElt(core, shm_nsends)++;
+      if (!__atomic_load_n(&flag[0], __ATOMIC_ACQUIRE))
+      {
+         /* The slot is empty, the send is complete once it is written */
+         memcpy((char *)sslot + hsize, _braid_CommHandleElt(handle, buffer),
+                _braid_CommHandleElt(handle, size));
+         flag[1] = _braid_CommHandleElt(handle, size);
+         flag[2] = _braid_CommHandleElt(handle, shm_seq);
+         __atomic_store_n(&flag[0], 1, __ATOMIC_RELEASE);
+         _braid_CommHandleElt(handle, shm) = 2;
+      }
+      else
+      {
+         /* The receiver has not taken my last message yet, so use MPI */
+         MPI_Isend(_braid_CommHandleElt(handle, buffer), _braid_CommHandleElt(handle, size),
+                   MPI_BYTE, _braid_CoreElt(core, shm_right), 6, comm,
+                   &_braid_CommHandleElt(handle, requests)[0]);
+         _braid_CommHandleElt(handle, num_requests) = 1;
+         _braid_CommHandleElt(handle, shm)          = 0;
+      }
+   }
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Receives complete in the order they were posted.  When the slot does not
+ * hold the next message, that message was sent with MPI.  The slot is checked
+ * again after a successful probe, because the sender always fills the slot
+ * before it sends a later message with MPI.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmCommProgress(braid_Core          core,
+                       _braid_CommHandle  *handle,
+                       braid_Int          *ready_ptr)
+{
+   braid_Int  ready = 0;
+
+#ifndef braid_SEQUENTIAL
+   MPI_Comm            comm  = _braid_CoreElt(core, comm);
+   braid_Int           left  = _braid_CoreElt(core, shm_left);
+   braid_Int           hsize = 2*sizeof(braid_Real);
+   void               *rslot = _braid_CoreElt(core, shm_recv_slot);
+   braid_Int          *flag  = (braid_Int *) rslot;
+   _braid_CommHandle  *recv;
+   MPI_Status         *status;
+   braid_Int           found, slot;
+   int                 probe;
+
+   while ( !ready && (_braid_CommHandleElt(handle, shm) == 1) )
+   {
+      recv   = _braid_CoreElt(core, shm_recvs);
+      status = _braid_CommHandleElt(recv, status);
+
+      /* Look for the message of the oldest receive in my slot, then in MPI */
+      slot  = ( __atomic_load_n(&flag[0], __ATOMIC_ACQUIRE) &&
+                (flag[2] == _braid_CommHandleElt(recv, shm_seq)) );
+      found = slot;
+      if (!found)
+      {
+         MPI_Iprobe(left, 6, comm, &probe, MPI_STATUS_IGNORE);
+         if (probe)
+         {
+            slot  = ( __atomic_load_n(&flag[0], __ATOMIC_ACQUIRE) &&
+                      (flag[2] == _braid_CommHandleElt(recv, shm_seq)) );
+            found = 1;
+         }
+      }
+      if (!found)
+      {
+         break;
+      }
+
+      status[0].MPI_SOURCE = left;
+      if (slot && (recv == handle))
+      {
+         /* Leave the message in the slot, _braid_CommWait unpacks it there */
+         ready = 1;
+      }
+      else
+      {
+         if (slot)
+         {
+            /* Another receive is waited on first, copy to free the slot */
+            memcpy(_braid_CommHandleElt(recv, buffer), (char *)rslot + hsize, flag[1]);
+            __atomic_store_n(&flag[0], 0, __ATOMIC_RELEASE);
+         }
+         else
+         {
+            MPI_Recv(_braid_CommHandleElt(recv, buffer), _braid_CoreElt(core, shm_slot_size),
+                     MPI_BYTE, left, 6, comm, status);
+         }
+         _braid_CommHandleElt(recv, shm) = 2;
+         _braid_CoreElt(core, shm_recvs) = _braid_CommHandleElt(recv, shm_next);
+      }
+   }
+#endif
+
+   *ready_ptr = ready;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmCommRelease(braid_Core          core,
+                      _braid_CommHandle  *handle)
+{
+#ifndef braid_SEQUENTIAL
+   braid_Int  *flag = (braid_Int *) _braid_CoreElt(core, shm_recv_slot);
+
+   _braid_CommHandleElt(handle, shm) = 2;
+   _braid_CoreElt(core, shm_recvs) = _braid_CommHandleElt(handle, shm_next);
+   __atomic_store_n(&flag[0], 0, __ATOMIC_RELEASE);
+#endif
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -143,19 +696,71 @@ _braid_CommWait(braid_Core          core,
       MPI_Request   *requests     = _braid_CommHandleElt(handle, requests);
       MPI_Status    *status       = _braid_CommHandleElt(handle, status);
       void          *buffer       = _braid_CommHandleElt(handle, buffer);
+      braid_BaseVector vector     = _braid_CommHandleElt(handle, vector);
       braid_BufferStatus bstatus  = (braid_BufferStatus)core;
+      void          *data         = buffer;
+      braid_Int      inslot       = 0;
 
-      MPI_Waitall(num_requests, requests, status);
+      if (_braid_CommHandleElt(handle, shm) == 1)
+      {
+         /* Shared-memory receive, unpack in place if it arrives in my slot */
+         _braid_ShmCommProgress(core, handle, &inslot);
+         while ( !inslot && (_braid_CommHandleElt(handle, shm) == 1) )
+         {
+            /* Give up the core, in case the neighbor shares it */
+            sched_yield();
+            _braid_ShmCommProgress(core, handle, &inslot);
+         }
+         if (inslot)
+         {
+            data = (char *)_braid_CoreElt(core, shm_recv_slot) + 2*sizeof(braid_Real);
+         }
+      }
+      else
+      {
+         MPI_Waitall(num_requests, requests, status);
+      }
 
-      if (request_type == 1) /* recv type */
+      if (vector != NULL) /* in place message */
+      {
+         MPI_Type_free(&_braid_CommHandleElt(handle, dtype));
+         if (request_type == 1)
+         {
+            *(_braid_CommHandleElt(handle, vector_ptr)) = vector;
+         }
+         else
+         {
+            _braid_BaseFree(core, app, vector);
+         }
+      }
+      else if (request_type == 1) /* recv type */
       {
          _braid_BufferStatusInit( 0, 0, bstatus );
          braid_BaseVector  *vector_ptr = _braid_CommHandleElt(handle, vector_ptr);
+         void              *message    = data;
 
          /* Store the sender rank the bufferStatus */
          _braid_StatusElt(bstatus, send_recv_rank ) = status->MPI_SOURCE;
 
-         _braid_BaseBufUnpack(core, app,  buffer, vector_ptr, bstatus);
+         /* Strip the header and decompress the message, if needed */
+         if (_braid_CommHeaderSize(core) > 0)
+         {
+            _braid_CommDecompress(core, data, &message);
+         }
+
+         if (_braid_IsLowPrec(core, _braid_CommHandleElt(handle, level)))
+         {
+            _braid_BaseBufUnpackLowPrec(core, app,  message, vector_ptr, bstatus);
+         }
+         else
+         {
+            _braid_BaseBufUnpack(core, app,  message, vector_ptr, bstatus);
+         }
+
+         if (inslot)
+         {
+            _braid_ShmCommRelease(core, handle);
+         }
       }
 
       _braid_TFree(requests);
@@ -169,6 +774,43 @@ _braid_CommWait(braid_Core          core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommTest(braid_Core          core,
+                _braid_CommHandle  *handle,
+                braid_Int          *done_ptr)
+{
+   braid_Int  done = 1;
+   int        flag;
+
+   if (handle != NULL)
+   {
+      if (_braid_CommHandleElt(handle, shm) == 1)
+      {
+         _braid_ShmCommProgress(core, handle, &done);
+         done = done || (_braid_CommHandleElt(handle, shm) == 2);
+      }
+      else if (_braid_CommHandleElt(handle, num_requests) > 0)
+      {
+         MPI_Testall(_braid_CommHandleElt(handle, num_requests),
+                     _braid_CommHandleElt(handle, requests), &flag,
+                     _braid_CommHandleElt(handle, status));
+         if (flag)
+         {
+            /* The requests are freed, keep the statuses for _braid_CommWait() */
+            _braid_CommHandleElt(handle, num_requests) = 0;
+         }
+         done = flag;
+      }
+   }
+
+   *done_ptr = done;
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -242,6 +884,7 @@ _braid_TriCommInit(braid_Core     core,
          _braid_BaseBufPack(core, app, u, buffers[nrequests], bstatus);
          size = _braid_StatusElt(bstatus, size_buffer);
          MPI_Isend(buffers[nrequests], size, MPI_BYTE, proc, 0, comm, &requests[nrequests]);
+         _braid_CommCount(core, level, size);
          nrequests++;
       }
    }
@@ -0,0 +1,259 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC. 
+ * Produced at the Lawrence Livermore National Laboratory. Written by 
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin 
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ * 
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ * 
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ * 
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+#include <float.h>
+#include "_braid.h"
+#include "_util.h"
+
+/* The Delta correction on a coarse step stores V and W, rank vectors each,
+ * at delta_v[(index-ilower)*rank + j] and delta_w[...].  A basis shorter than
+ * rank (Arnoldi breakdown) ends with NULL entries. */
+
+/*----------------------------------------------------------------------------
+ * Propagate u over the coarse step to time step 'index' on grid 'level' > 0,
+ * either with the fine steps of the interval on level-1 (fine = 1), or with
+ * one plain coarse step (fine = 0)
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaPropagate(braid_Core        core,
+                      braid_Int         level,
+                      braid_Int         index,
+                      braid_Int         fine,
+                      braid_BaseVector  u)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   braid_Real         tol      = _braid_CoreElt(core, tol);
+   braid_Int          iter     = _braid_CoreElt(core, niter);
+   braid_Int          ichunk   = _braid_CoreElt(core, ichunk);
+   braid_Int          nrefine  = _braid_CoreElt(core, nrefine);
+   braid_Int          gupper   = _braid_CoreElt(core, gupper);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_StepStatus   status   = (braid_StepStatus)core;
+   braid_Int          c_ilower = _braid_GridElt(grids[level], ilower);
+   braid_Real        *c_ta     = _braid_GridElt(grids[level], ta);
+   braid_Int          f_ilower = _braid_GridElt(grids[level-1], ilower);
+   braid_Int          cfactor  = _braid_GridElt(grids[level-1], cfactor);
+   braid_Real        *f_ta     = _braid_GridElt(grids[level-1], ta);
+
+   braid_Int          fi, fstart, fstop, ii;
+
+   if (fine)
+   {
+      _braid_MapCoarseToFine(index-1, cfactor, fstart);
+      _braid_MapCoarseToFine(index,   cfactor, fstop);
+      for (fi = fstart+1; fi <= fstop; fi++)
+      {
+         ii = fi-f_ilower;
+         _braid_StepStatusInit(f_ta[ii-1], f_ta[ii], fi-1, ichunk, tol, iter, level-1, nrefine, gupper, status);
+         _braid_DeltaStep(core, level-1, fi, u, u);
+      }
+   }
+   else
+   {
+      ii = index-c_ilower;
+      _braid_StepStatusInit(c_ta[ii-1], c_ta[ii], index-1, ichunk, tol, iter, level, nrefine, gupper, status);
+      _braid_BaseStep(core, app, u, NULL, u, level, status);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Apply the propagator over the coarse step to time step 'index', linearized
+ * about u0 by a finite difference: v = (Phi(u0 + delta*v) - y0) / delta, where
+ * y0 = Phi(u0)
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaLinearize(braid_Core        core,
+                      braid_Int         level,
+                      braid_Int         index,
+                      braid_Int         fine,
+                      braid_BaseVector  u0,
+                      braid_BaseVector  y0,
+                      braid_Real        delta,
+                      braid_BaseVector  v,
+                      braid_BaseVector *z_ptr)
+{
+   braid_App          app = _braid_CoreElt(core, app);
+   braid_BaseVector   z;
+
+   _braid_BaseClone(core, app, u0, &z);
+   _braid_BaseSum(core, app, delta, v, 1.0, z);
+   _braid_DeltaPropagate(core, level, index, fine, z);
+   _braid_BaseSum(core, app, -1.0/delta, y0, 1.0/delta, z);
+
+   *z_ptr = z;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaStep(braid_Core        core,
+                 braid_Int         level,
+                 braid_Int         index,
+                 braid_BaseVector  ustop,
+                 braid_BaseVector  u)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   braid_Int          rank     = _braid_CoreElt(core, delta_rank);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_StepStatus   status   = (braid_StepStatus)core;
+   braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
+   braid_BaseVector  *delta_v  = _braid_GridElt(grids[level], delta_v);
+   braid_BaseVector  *delta_w  = _braid_GridElt(grids[level], delta_w);
+
+   braid_Real        *coeffs = NULL;
+   braid_Int          iv, j, k = 0;
+
+   /* Project u onto the basis before stepping */
+   if (delta_v != NULL)
+   {
+      iv = (index-ilower)*rank;
+      coeffs = _braid_CTAlloc(braid_Real, rank);
+      for (k = 0; (k < rank) && (delta_v[iv+k] != NULL); k++)
+      {
+         _braid_BaseInnerProd(core, app, delta_v[iv+k], u, &coeffs[k]);
+      }
+   }
+
+   _braid_BaseStep(core, app, ustop, NULL, u, level, status);
+
+   /* Add the correction W V^T u */
+   for (j = 0; j < k; j++)
+   {
+      _braid_BaseSum(core, app, coeffs[j], delta_w[iv+j], 1.0, u);
+   }
+   _braid_TFree(coeffs);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaBuild(braid_Core  core,
+                  braid_Int   level,
+                  braid_Int   index)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   braid_Int          rank     = _braid_CoreElt(core, delta_rank);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
+   braid_Int          iupper   = _braid_GridElt(grids[level], iupper);
+   braid_BaseVector  *va       = _braid_GridElt(grids[level], va);
+   braid_BaseVector  *delta_v  = _braid_GridElt(grids[level], delta_v);
+   braid_BaseVector  *delta_w  = _braid_GridElt(grids[level], delta_w);
+   braid_Int          f_ilower = _braid_GridElt(grids[level-1], ilower);
+   braid_Int          cfactor  = _braid_GridElt(grids[level-1], cfactor);
+
+   braid_BaseVector   u0, yf, yc, z, q, y;
+   braid_Real         norm, delta, h, hmax;
+   braid_Int          iv, fstart, j, m, pass, done;
+
+   if (delta_v == NULL)
+   {
+      delta_v = _braid_CTAlloc(braid_BaseVector, (iupper-ilower+1)*rank);
+      delta_w = _braid_CTAlloc(braid_BaseVector, (iupper-ilower+1)*rank);
+      _braid_GridElt(grids[level], delta_v) = delta_v;
+      _braid_GridElt(grids[level], delta_w) = delta_w;
+   }
+
+   /* Already built, or the fine interval starts on another processor */
+   iv = (index-ilower)*rank;
+   _braid_MapCoarseToFine(index-1, cfactor, fstart);
+   if ( (delta_v[iv] != NULL) || (fstart < f_ilower-1) )
+   {
+      return _braid_error_flag;
+   }
+
+   /* Linearize about the restricted solution at the start of the step */
+   u0 = va[index-ilower-1];
+   _braid_BaseInnerProd(core, app, u0, u0, &norm);
+   norm = sqrt(norm);
+   if (norm == 0.0)
+   {
+      return _braid_error_flag;
+   }
+   delta = sqrt(DBL_EPSILON)*(1.0 + norm);
+
+   _braid_BaseClone(core, app, u0, &yf);
+   _braid_DeltaPropagate(core, level, index, 1, yf);
+   _braid_BaseClone(core, app, u0, &yc);
+   _braid_DeltaPropagate(core, level, index, 0, yc);
+
+   /* Arnoldi on the fine propagator, started from u0 */
+   _braid_BaseClone(core, app, u0, &delta_v[iv]);
+   _braid_BaseSum(core, app, 0.0, u0, 1.0/norm, delta_v[iv]);
+   hmax = 0.0;
+   done = 0;
+   for (j = 0; (j < rank) && !done; j++)
+   {
+      _braid_DeltaLinearize(core, level, index, 1, u0, yf, delta, delta_v[iv+j], &z);
+
+      /* Orthogonalize Phi_f v_j against the basis (modified Gram-Schmidt,
+       * twice, since the Krylov vectors quickly become nearly dependent) */
+      if (j < rank-1)
+      {
+         _braid_BaseClone(core, app, z, &q);
+         for (pass = 0; pass < 2; pass++)
+         {
+            for (m = 0; m <= j; m++)
+            {
+               _braid_BaseInnerProd(core, app, delta_v[iv+m], q, &h);
+               _braid_BaseSum(core, app, -h, delta_v[iv+m], 1.0, q);
+            }
+         }
+         _braid_BaseInnerProd(core, app, q, q, &h);
+         h = sqrt(h);
+         hmax = _braid_max(h, hmax);
+         if (h > 1.0e-12*hmax)
+         {
+            _braid_BaseSum(core, app, 0.0, q, 1.0/h, q);
+            delta_v[iv+j+1] = q;
+         }
+         else
+         {
+            /* Invariant subspace found */
+            _braid_BaseFree(core, app, q);
+            done = 1;
+         }
+      }
+
+      /* w_j = (Phi_f - Phi_c) v_j */
+      _braid_DeltaLinearize(core, level, index, 0, u0, yc, delta, delta_v[iv+j], &y);
+      _braid_BaseSum(core, app, -1.0, y, 1.0, z);
+      _braid_BaseFree(core, app, y);
+      delta_w[iv+j] = z;
+   }
+
+   _braid_BaseFree(core, app, yf);
+   _braid_BaseFree(core, app, yc);
+
+   return _braid_error_flag;
+}
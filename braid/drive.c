@@ -216,6 +216,66 @@ _braid_DriveEndCycle(braid_Core          core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ * This is a locally scoped helper function for braid_Drive(), not a user 
+ * function.
+ *
+ * Nested iteration startup.  The fine-grid initial guess is injected to all
+ * coarse levels, where the FAS right-hand sides are still empty, so each coarse
+ * level holds the rediscretized problem.  Starting from the coarsest grid
+ * (whose F-relaxation in FInterp is sequential time stepping), the solution is
+ * interpolated to the next finer level, where nested_vcyc V-cycles are done
+ * with that level as the finest.  The last interpolation updates level 0.
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DriveNestedIter(braid_Core  core)
+{
+   braid_Int  nlevels     = _braid_CoreElt(core, nlevels);
+   braid_Int  nested_vcyc = _braid_CoreElt(core, nested_vcyc);
+
+   braid_Int  top, level, k;
+   braid_Real t0;
+
+   _braid_CopyFineToCoarse(core);
+
+   for (top = nlevels-2; top > -1; top--)
+   {
+      /* Interpolate the solution from level top+1 */
+      t0 = MPI_Wtime();
+      _braid_FInterp(core, top+1);
+      _braid_PhaseTime(core, top+1, _braid_PHASE_INTERP, t0);
+
+      if (top == 0)
+      {
+         break;
+      }
+
+      /* V-cycles on levels top, ..., nlevels-1 */
+      for (k = 0; k < nested_vcyc; k++)
+      {
+         for (level = top; level < nlevels-1; level++)
+         {
+            t0 = MPI_Wtime();
+            _braid_FCRelax(core, level);
+            _braid_PhaseTime(core, level, _braid_PHASE_RELAX, t0);
+
+            t0 = MPI_Wtime();
+            _braid_FRestrict(core, level);
+            _braid_PhaseTime(core, level, _braid_PHASE_RESTRICT, t0);
+         }
+         for (level = nlevels-1; level > top; level--)
+         {
+            t0 = MPI_Wtime();
+            _braid_FInterp(core, level);
+            _braid_PhaseTime(core, level, _braid_PHASE_INTERP, t0);
+         }
+      }
+   }
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  * This is a locally scoped helper function for braid_Drive(), not a user 
  * function.
@@ -343,6 +403,7 @@ _braid_DrivePrintStatus(braid_Core  core,
    braid_Optim          optim; 
    braid_Real           rnorm, rnorm_prev, cfactor, wtime;
    braid_Real           rnorm_adj, objective;
+   braid_Int            k;
 
    /* If my processor is not 0, or if print_level is not set high enough, return */
    if ((myid != 0) || (print_level < 1))
@@ -390,16 +451,25 @@ _braid_DrivePrintStatus(braid_Core  core,
    if (fullres != NULL)
    {
       _braid_GetFullRNorm(core, -1, &rnorm);
-      _braid_GetFullRNorm(core, -2, &rnorm_prev);
-      cfactor = 1.0;
-      if (rnorm_prev != braid_INVALID_RNORM)
-      {
-         cfactor = rnorm / rnorm_prev;
-      }
       if (rnorm != braid_INVALID_RNORM)
       {
-         _braid_printf("  Braid: Full || r_%d || = %1.6e, conv factor = %1.2e\n",
-                       iter, rnorm, cfactor);
+         /* With braid_SetFullRNormFreq, the previous full norm may be several
+          * iterations back, so print the average factor per iteration */
+         rnorm_prev = braid_INVALID_RNORM;
+         for (k = 2; (k <= iter+1) && (rnorm_prev == braid_INVALID_RNORM); k++)
+         {
+            _braid_GetFullRNorm(core, -k, &rnorm_prev);
+         }
+         if ((rnorm_prev != braid_INVALID_RNORM) && (rnorm_prev > 0.0))
+         {
+            cfactor = pow(rnorm / rnorm_prev, 1.0 / (k-2));
+            _braid_printf("  Braid: Full || r_%d || = %1.6e, conv factor = %1.2e\n",
+                          iter, rnorm, cfactor);
+         }
+         else
+         {
+            _braid_printf("  Braid: Full || r_%d || = %1.6e\n", iter, rnorm);
+         }
       }
    }
 
@@ -443,9 +513,11 @@ _braid_Drive(braid_Core  core,
 
 
    braid_Int     *nrels, nrel0;
+   braid_Int      anderson, nested;
    braid_Int      nlevels;
    braid_Int      ilower, iupper;
    braid_Real     rnorm_adj;
+   braid_Real     t0;
 
    /* Cycle state variables */
    _braid_CycleState  cycle;
@@ -461,17 +533,44 @@ _braid_Drive(braid_Core  core,
       /* Just do sequential time marching */
       done = 1;
    }
+   anderson = ( (_braid_CoreElt(core, anderson_dim) > 0) && (nlevels > 1) );
+   nested = ( (_braid_CoreElt(core, nested_vcyc) > 0) && (nlevels > 1) && !adjoint &&
+              !_braid_CoreElt(core, seq_soln) );
+
+   iter = 0;
+   _braid_CoreElt(core, niter) = iter;
+   _braid_CoreElt(core, frozen_index) = 0;
+   _braid_CoreElt(core, frozen_rnorm) = 0.0;
+   _braid_CoreElt(core, frozen_full_rnorm) = 0.0;
 
    level = 0;
-   if (skip)
+   if (_braid_CoreElt(core, reuse_tau))
+   {
+      /* Warm restart with the kept FAS right-hand sides: skip the first down
+       * cycle, the coarse levels solve with the kept right-hand sides */
+      level = nlevels-1;
+      _braid_CopyFineToCoarse(core);
+      _braid_CoreElt(core, reuse_tau) = 0;
+      skip = 1;
+   }
+   else if (nested)
+   {
+      /* Build the initial guess by nested iteration, then cycle on level 0 */
+      _braid_DriveNestedIter(core);
+      skip = 0;
+   }
+   else if (skip)
    {
       /* Skip work on first down cycle */
       level = nlevels-1;
       _braid_CopyFineToCoarse(core);
    }
 
-   iter = 0;
-   _braid_CoreElt(core, niter) = iter;
+   if ( anderson && !skip )
+   {
+      /* Save the initial iterate for the Anderson acceleration */
+      _braid_AndersonUpdate(core);
+   }
    while (!done)
    {
       /* When there is just one grid level, do sequential time marching */
@@ -483,7 +582,9 @@ _braid_Drive(braid_Core  core,
          nrels = _braid_CoreElt(core, nrels);
          nrel0 = nrels[0];
          nrels[0] = 1;
+         t0 = MPI_Wtime();
          _braid_FCRelax(core, 0);
+         _braid_PhaseTime(core, 0, _braid_PHASE_RELAX, t0);
          nrels[0] = nrel0;
          _braid_SetRNorm(core, -1, 0.0);
       }
@@ -496,19 +597,16 @@ _braid_Drive(braid_Core  core,
          /* Down cycle */
 
          /* CF-relaxation */
+         t0 = MPI_Wtime();
          _braid_FCRelax(core, level);
+         _braid_PhaseTime(core, level, _braid_PHASE_RELAX, t0);
 
-         /* F-relax then restrict (note that FRestrict computes a new rnorm) */
+         /* F-relax then restrict (note that FRestrict computes a new rnorm,
+          * and the full rnorm if requested) */
          /* if adjoint: This computes the local objective function at each step on finest grid. */
+         t0 = MPI_Wtime();
          _braid_FRestrict(core, level);
-            
-         /* Compute full residual norm if requested */
-         if ( (level == 0) &&  (fullres != NULL) )
-         {
-            braid_Real  full_rnorm;
-            _braid_ComputeFullRNorm(core, level, &full_rnorm);
-            _braid_SetFullRNorm(core, -1, full_rnorm);
-         }
+         _braid_PhaseTime(core, level, _braid_PHASE_RESTRICT, t0);
 
          level++;
       }
@@ -519,12 +617,21 @@ _braid_Drive(braid_Core  core,
          if (level > 0)
          {
             /* F-relax then interpolate */
+            t0 = MPI_Wtime();
             _braid_FInterp(core, level);
+            _braid_PhaseTime(core, level, _braid_PHASE_INTERP, t0);
 
             level--;
          }
          else
          {
+            if (anderson)
+            {
+               /* Replace the result of the cycle with the accelerated iterate */
+               t0 = MPI_Wtime();
+               _braid_AndersonUpdate(core);
+               _braid_PhaseTime(core, 0, _braid_PHASE_ANDERSON, t0);
+            }
 
             // Output the solution at the end of each cycle
             // Copy the rfactors because the call to FAccess will modify them
@@ -541,7 +648,9 @@ _braid_Drive(braid_Core  core,
                   ii=i-ilower;
                   saved_rfactors[ii]=rfactors[ii];
                }
+               t0 = MPI_Wtime();
                _braid_FAccess(core, 0, 0);
+               _braid_PhaseTime(core, 0, _braid_PHASE_ACCESS, t0);
                for (i=ilower; i<=iupper+1; i++)
                {
                   ii=i-ilower;
@@ -616,24 +725,34 @@ _braid_Drive(braid_Core  core,
       _braid_SetRNorm(core, -1, rnorm);
    }
    
-   /* Compute final full residual norms if requested */
+   /* Compute final full residual norms if requested (always due here) */
    if (fullres != NULL)
    {
-      braid_Real  full_rnorm;
-      _braid_ComputeFullRNorm(core, level, &full_rnorm);
-      _braid_SetFullRNorm(core, -1, full_rnorm);
+      braid_Int  full_freq = _braid_CoreElt(core, full_rnorm_freq);
+
       /* JBS: Ben S wanted a final rnorm, we should move this final residual
        * computation to FAccess to save work */
+      _braid_CoreElt(core, full_rnorm_freq) = 1;
       _braid_FRestrict(core, level);
+      _braid_CoreElt(core, full_rnorm_freq) = full_freq;
    }
 
+   _braid_AndersonDestroy(core);
+
    /* Allow final access to Braid by carrying out an F-relax to generate points */
    /* Record it only if sequential time stepping */
    if (max_levels > 1)
    {
       _braid_CoreElt(core, record) = 0;
    }
+   t0 = MPI_Wtime();
    _braid_FAccess(core, 0, 1);
+   _braid_PhaseTime(core, 0, _braid_PHASE_ACCESS, t0);
+
+   if (_braid_CoreElt(core, compress_storage) > 0)
+   {
+      _braid_UCompressRatio(core);
+   }
    
    /* If sequential time-marching, evaluate the tape */
    if ( adjoint && max_levels <= 1 )
@@ -664,7 +783,9 @@ _braid_TriDrive(braid_Core  core,
    braid_Int  access_level = _braid_CoreElt(core, access_level);
    braid_Int *nrels        = _braid_CoreElt(core, nrels);
    braid_Int  maxlevels    = _braid_CoreElt(core, max_levels);
+   braid_Int  anderson     = (_braid_CoreElt(core, anderson_dim) > 0);
    braid_Int  nlevels;
+   braid_Real t0;
 
    /* Cycle state variables */
    _braid_CycleState  cycle;
@@ -678,6 +799,11 @@ _braid_TriDrive(braid_Core  core,
    level = 0;
    iter = 0;
    _braid_CoreElt(core, niter) = iter;
+   if (anderson)
+   {
+      /* Save the initial iterate for the Anderson acceleration */
+      _braid_AndersonUpdate(core);
+   }
    while (!done)
    {
       /* Update cycle state and direction based on level and iter */
@@ -688,10 +814,14 @@ _braid_TriDrive(braid_Core  core,
          /* Down cycle */
 
          /* FCF-relaxation */
+         t0 = MPI_Wtime();
          _braid_TriFCFRelax(core, level, -1);
+         _braid_PhaseTime(core, level, _braid_PHASE_RELAX, t0);
 
          /* Restrict using injection */
+         t0 = MPI_Wtime();
          _braid_TriRestrict(core, level);
+         _braid_PhaseTime(core, level, _braid_PHASE_RESTRICT, t0);
             
          level++;
       }
@@ -704,11 +834,22 @@ _braid_TriDrive(braid_Core  core,
             if (level == (nlevels-1))
             {
                /* Coarsest grid solve */
-               _braid_TriFCFRelax(core, level, nrels[maxlevels-1]);
+               t0 = MPI_Wtime();
+               if (_braid_CoreElt(core, tridirect))
+               {
+                  _braid_TriDirectSolve(core, level);
+               }
+               else
+               {
+                  _braid_TriFCFRelax(core, level, nrels[maxlevels-1]);
+               }
+               _braid_PhaseTime(core, level, _braid_PHASE_COARSE, t0);
             }
 
             /* Interpolate with approximate ideal (injection then F-relaxation) */
+            t0 = MPI_Wtime();
             _braid_TriInterp(core, level);
+            _braid_PhaseTime(core, level, _braid_PHASE_INTERP, t0);
 
             level--;
          }
@@ -719,13 +860,35 @@ _braid_TriDrive(braid_Core  core,
             if (nlevels == 1)
             {
                /* Just do relaxation for one-level solve */
-               _braid_TriFCFRelax(core, level, -1);
+               t0 = MPI_Wtime();
+               if (_braid_CoreElt(core, tridirect))
+               {
+                  /* Solve directly and compute the residual for the
+                   * convergence check */
+                  _braid_TriDirectSolve(core, level);
+                  _braid_TriComputeRNorm(core, level);
+               }
+               else
+               {
+                  _braid_TriFCFRelax(core, level, -1);
+               }
+               _braid_PhaseTime(core, level, _braid_PHASE_COARSE, t0);
+            }
+
+            if (anderson)
+            {
+               /* Replace the result of the cycle with the accelerated iterate */
+               t0 = MPI_Wtime();
+               _braid_AndersonUpdate(core);
+               _braid_PhaseTime(core, 0, _braid_PHASE_ANDERSON, t0);
             }
 
             if (access_level >= 2)
             {
                /* Output the solution at the end of each cycle */
+               t0 = MPI_Wtime();
                _braid_TriAccess(core, 0, 0);
+               _braid_PhaseTime(core, 0, _braid_PHASE_ACCESS, t0);
             }
 
             /* Print current status */
@@ -733,6 +896,13 @@ _braid_TriDrive(braid_Core  core,
 
             /* Check convergence */
             _braid_DriveCheckConvergence(core, iter, &done);
+            if ( (nlevels == 1) && _braid_CoreElt(core, tridirect) &&
+                 (_braid_CoreElt(core, trilinearize) == NULL) )
+            {
+               /* The direct solve of an affine problem is exact, so another
+                * iteration would only repeat it */
+               done = 1;
+            }
 
             /* Increase TriMGRIT iteration counter */
             iter++;
@@ -747,7 +917,10 @@ _braid_TriDrive(braid_Core  core,
       _braid_GetRNorm(core, -2, &rnorm);
       _braid_SetRNorm(core, -1, rnorm);
    }
+   _braid_AndersonDestroy(core);
+   t0 = MPI_Wtime();
    _braid_TriAccess(core, 0, 1);
+   _braid_PhaseTime(core, 0, _braid_PHASE_ACCESS, t0);
    
    /* End cycle */
    _braid_DriveEndCycle(core, &cycle);
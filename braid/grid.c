@@ -45,6 +45,7 @@ _braid_GridInit(braid_Core     core,
    _braid_GridElt(grid, iupper) = iupper;
    _braid_GridElt(grid, recv_index) = -1;
    _braid_GridElt(grid, send_index) = -1;
+   _braid_GridElt(grid, uz_index)   = -1;
    
    /* Store each processor's time slice, plus one time value to the left 
     * and to the right */
@@ -77,6 +78,7 @@ _braid_GridClean(braid_Core    core,
    braid_BaseVector  *ua_alloc = _braid_GridElt(grid, ua_alloc);
    braid_BaseVector  *va_alloc = _braid_GridElt(grid, va_alloc);
    braid_BaseVector  *fa_alloc = _braid_GridElt(grid, fa_alloc);
+   char             **uz       = _braid_GridElt(grid, uz);
    
    braid_Int      ii;
 
@@ -105,6 +107,17 @@ _braid_GridClean(braid_Core    core,
             }
          }
       }
+      _braid_GridElt(grid, uz_index) = -1;
+   }
+   if (uz)
+   {
+      for (ii = 0; ii < nupoints; ii++)
+      {
+         if (uz[ii] != NULL)
+         {
+            _braid_TFree(uz[ii]);
+         }
+      }
    }
    if (va_alloc)
    {
@@ -145,13 +158,74 @@ _braid_GridDestroy(braid_Core    core,
       braid_Real        *ta_alloc = _braid_GridElt(grid, ta_alloc);
       braid_BaseVector  *va_alloc = _braid_GridElt(grid, va_alloc);
       braid_BaseVector  *fa_alloc = _braid_GridElt(grid, fa_alloc);
+      braid_BaseVector  *delta_v  = _braid_GridElt(grid, delta_v);
+      braid_BaseVector  *delta_w  = _braid_GridElt(grid, delta_w);
+      braid_BaseVector  *tau      = _braid_GridElt(grid, tau);
+      void             **la       = _braid_GridElt(grid, la);
+      braid_Int          ndelta, npoints;
+      braid_Int          ii;
 
       _braid_GridClean(core, grid);
 
+      /* Free the Newton-TriMGRIT linearizations */
+      if (la)
+      {
+         npoints = _braid_GridElt(grid, iupper) - _braid_GridElt(grid, ilower) + 1;
+         for (ii = 0; ii < npoints; ii++)
+         {
+            if (la[ii] != NULL)
+            {
+               _braid_CoreFcn(core, trilinfree)(_braid_CoreElt(core, app), la[ii]);
+            }
+         }
+         _braid_TFree(la);
+         _braid_TFree(_braid_GridElt(grid, la_epoch));
+      }
+
+      _braid_TriDirectDestroy(_braid_GridElt(grid, tridirect));
+
+      /* Free the Delta correction bases */
+      if (delta_v)
+      {
+         ndelta = (_braid_GridElt(grid, iupper) - _braid_GridElt(grid, ilower) + 1)*
+            _braid_CoreElt(core, delta_rank);
+         for (ii = 0; ii < ndelta; ii++)
+         {
+            if (delta_v[ii] != NULL)
+            {
+               _braid_BaseFree(core, _braid_CoreElt(core, app), delta_v[ii]);
+            }
+            if (delta_w[ii] != NULL)
+            {
+               _braid_BaseFree(core, _braid_CoreElt(core, app), delta_w[ii]);
+            }
+         }
+         _braid_TFree(delta_v);
+         _braid_TFree(delta_w);
+      }
+
+      /* Free the FAS right-hand sides kept for a warm restart */
+      if (tau)
+      {
+         npoints = _braid_GridElt(grid, iupper) - _braid_GridElt(grid, ilower) + 1;
+         for (ii = 0; ii < npoints; ii++)
+         {
+            if (tau[ii] != NULL)
+            {
+               _braid_BaseFree(core, _braid_CoreElt(core, app), tau[ii]);
+            }
+         }
+         _braid_TFree(tau);
+      }
+
       if (ua_alloc)
       {
          _braid_TFree(ua_alloc);
       }
+      if (_braid_GridElt(grid, uz))
+      {
+         _braid_TFree(_braid_GridElt(grid, uz));
+      }
       if (ta_alloc)
       {
          _braid_TFree(ta_alloc);
@@ -50,6 +50,141 @@ _braid_GetCFactor(braid_Core   core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * With full storage on levels >= x, level l holds all of its points if l >= x
+ * and only its C-points otherwise.  Coarse levels additionally hold va and fa
+ * at every point.  Storing F-points does not save Step calls (F-relaxation
+ * always recomputes them), it only gives implicit solvers better initial
+ * guesses, so the cheap coarse levels are the first to get full storage.
+ *
+ * If compressed storage was requested (braid_SetCompressStorage), a third
+ * option sits between full storage on all levels and full storage on the
+ * coarse levels only: full storage with the F-points on level 0 compressed.
+ * It is estimated at half the vector size per F-point (4-byte quantization
+ * codes), and it is only selected when uncompressed full storage does not fit.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ChooseStorage(braid_Core  core,
+                     braid_Int   choose)
+{
+   MPI_Comm            comm     = _braid_CoreElt(core, comm);
+   braid_App           app      = _braid_CoreElt(core, app);
+   braid_BufferStatus  bstatus  = (braid_BufferStatus)core;
+   braid_Real          budget   = _braid_CoreElt(core, memory_budget);
+   braid_Int           nlevels  = _braid_CoreElt(core, nlevels);
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   braid_Real         *level_memory;
+
+   braid_Real         *mem, *gmem, *full, *conly, zfull;
+   braid_Int           level, x, size, storage, compress;
+
+   /* Shell vectors, the adjoint and TriMGRIT have their own storage needs */
+   if ( _braid_CoreElt(core, useshell) || _braid_CoreElt(core, adjoint) ||
+        _braid_CoreElt(core, trimgrit) )
+   {
+      choose = 0;
+   }
+
+   /* The buffer size is the best estimate of the vector size we have */
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_BaseBufSize(core, app,  &size, bstatus);
+
+   full  = _braid_CTAlloc(braid_Real, nlevels);
+   conly = _braid_CTAlloc(braid_Real, nlevels);
+   for (level = 0; level < nlevels; level++)
+   {
+      full[level]  = (braid_Real) (_braid_GridElt(grids[level], iupper) -
+                                   _braid_GridElt(grids[level], ilower) + 1);
+      conly[level] = (braid_Real) _braid_GridElt(grids[level], ncpoints);
+      if (level > 0)
+      {
+         /* va and fa */
+         conly[level] += 2*full[level];
+         full[level]  += 2*full[level];
+      }
+      full[level]  *= size;
+      conly[level] *= size;
+   }
+
+   /* Level 0 with compressed F-points */
+   zfull = conly[0] + (full[0] - conly[0])*(0.5 + (braid_Real)_braid_UZHeaderSize/size);
+
+   storage  = _braid_CoreElt(core, storage);
+   compress = _braid_CoreElt(core, compress_storage);
+   if (choose)
+   {
+      /* mem[x] is the memory with full storage on levels >= x, and
+       * mem[nlevels+1] the memory with full storage and compression */
+      mem  = _braid_CTAlloc(braid_Real, nlevels+2);
+      gmem = _braid_CTAlloc(braid_Real, nlevels+2);
+      for (x = 0; x <= nlevels; x++)
+      {
+         for (level = 0; level < nlevels; level++)
+         {
+            mem[x] += (level >= x) ? full[level] : conly[level];
+         }
+      }
+      mem[nlevels+1] = mem[0] - full[0] + zfull;
+      MPI_Allreduce(mem, gmem, nlevels+2, braid_MPI_REAL, MPI_MAX, comm);
+
+      for (x = 0; x < nlevels; x++)
+      {
+         if (gmem[x] <= budget)
+         {
+            break;
+         }
+      }
+      if (x == 0)
+      {
+         storage  = 0;          /* everything fits */
+         compress = 0;
+      }
+      else if ( compress && (gmem[nlevels+1] <= budget) )
+      {
+         storage  = 0;          /* everything fits with compression */
+      }
+      else if (x == nlevels)
+      {
+         storage  = -1;         /* C-points only, even if over budget */
+         compress = 0;
+      }
+      else
+      {
+         storage  = x;
+         compress = 0;
+      }
+      _braid_CoreElt(core, storage)          = storage;
+      _braid_CoreElt(core, compress_storage) = compress;
+
+      _braid_TFree(mem);
+      _braid_TFree(gmem);
+   }
+
+   /* Estimated peak memory on each level for the storage in use */
+   for (level = 0; level < nlevels; level++)
+   {
+      if ( (storage < 0) || (level < storage) )
+      {
+         full[level] = conly[level];
+      }
+   }
+   if ( (storage == 0) && compress )
+   {
+      full[0] = zfull;
+   }
+   level_memory = _braid_CoreElt(core, level_memory);
+   _braid_TFree(level_memory);
+   level_memory = _braid_CTAlloc(braid_Real, nlevels);
+   MPI_Allreduce(full, level_memory, nlevels, braid_MPI_REAL, MPI_MAX, comm);
+   _braid_CoreElt(core, level_memory) = level_memory;
+
+   _braid_TFree(full);
+   _braid_TFree(conly);
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * Initialize grid hierarchy
  *----------------------------------------------------------------------------*/
@@ -223,11 +358,22 @@ _braid_InitHierarchy(braid_Core    core,
       {   
          /* Allocate space for storage of residual norm at each C-point */
          _braid_CoreElt(core, tnorm_a)  = _braid_CTAlloc(braid_Real, ncpoints);
+         if (_braid_CoreElt(core, full_rnorm_res) != NULL)
+         {
+            /* Only needed when the full residual is computed */
+            _braid_CoreElt(core, full_tnorm_a) = _braid_CTAlloc(braid_Real, ncpoints+1);
+         }
       }
    }
    nlevels = level+1;
    _braid_CoreElt(core, nlevels) = nlevels;
 
+   /* Select the storage for the memory budget (keep it after refinement) */
+   if (_braid_CoreElt(core, memory_budget) > 0.0)
+   {
+      _braid_ChooseStorage(core, !refined);
+   }
+
    /* Allocate ua, va, and fa here */
    for (level = 0; level < nlevels; level++)
    {
@@ -260,6 +406,13 @@ _braid_InitHierarchy(braid_Core    core,
       _braid_GridElt(grid, nupoints)  = nupoints;
       _braid_GridElt(grid, ua_alloc)  = ua;
       _braid_GridElt(grid, ua)        = ua+1;  /* shift */
+
+      /* Compressed F-point storage on the fine grid */
+      if ( (level == 0) && (_braid_CoreElt(core, compress_storage) > 0) &&
+           (nupoints == iupper-ilower+1) )
+      {
+         _braid_GridElt(grid, uz) = _braid_CTAlloc(char *, nupoints);
+      }
    }
 
    /* Communicate ta[-1] and ta[iupper-ilower+1] information */
@@ -50,13 +50,14 @@ _braid_FInterp(braid_Core  core,
    braid_BaseVector       f_u, f_e;
 
    braid_BaseVector       u, e;
-   braid_Int          flo, fhi, fi, ci;
-   braid_Int          interval;
+   braid_Int          flo, fhi, fi, ci, fstart;
+   braid_Int          interval, frozen;
 
    f_level   = level-1;
    f_cfactor = _braid_GridElt(grids[f_level], cfactor);
 
    _braid_GetRNorm(core, -1, &rnorm);
+   _braid_GetFrozenIndex(core, level, &frozen);
    
    _braid_UCommInitF(core, level);
 
@@ -72,12 +73,20 @@ _braid_FInterp(braid_Core  core,
    {
       _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
 
+      /* Skip intervals in the frozen region and frozen F-points, the
+       * correction there is zero */
+      if ((ci > 0) && (ci <= frozen))
+      {
+         continue;
+      }
+      _braid_USkipFrozen(core, level, frozen, flo, fhi, &fstart, &u);
+
       /* Relax and interpolate F-points, refining in space if needed */
-      if (flo <= fhi)
+      if ( (u == NULL) && (flo <= fhi) )
       {
          _braid_UGetVector(core, level, flo-1, &u);
       }
-      for (fi = flo; fi <= fhi; fi++)
+      for (fi = fstart; fi <= fhi; fi++)
       {
          _braid_Step(core, level, fi, NULL, u);
          _braid_USetVector(core, level, fi, u, 0);
@@ -126,6 +135,12 @@ _braid_FInterp(braid_Core  core,
 
    _braid_UCommWait(core, level);
 
+   /* Keep the FAS right-hand sides for a warm restart */
+   if (_braid_CoreElt(core, reuse) == 2)
+   {
+      _braid_KeepTau(core, level);
+   }
+
    /* Clean up */
    _braid_GridClean(core, grids[level]);
 
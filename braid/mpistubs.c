@@ -11,10 +11,12 @@
  ***********************************************************************EHEADER*/
 
 /******************************************************************************
- * MPI stubs to generate serial codes without mpi
+ * MPI stubs to generate serial codes without mpi.  With braid_THREADS, the
+ * point-to-point and collective routines are in mpithreads.c instead.
  *****************************************************************************/
 
 #include "_braid.h"
+#include <sys/time.h>
 
 #ifdef braid_SEQUENTIAL
 
@@ -30,6 +32,8 @@ MPI_Comm_c2f( int comm )
    return (MPI_Comm) comm;
 }
 
+#ifndef braid_THREADS
+
 int
 MPI_Init( int   *argc,
                 char      ***argv )
@@ -50,24 +54,34 @@ MPI_Abort( MPI_Comm comm,
    return(0);
 }
 
+#endif
+
 double
 MPI_Wtime( )
 {
-   return(0.0);
+   /* A real clock, so that sequential builds report wall and phase times */
+   struct timeval tv;
+
+   gettimeofday(&tv, NULL);
+   return( (double) tv.tv_sec + 1.0e-6 * (double) tv.tv_usec );
 }
 
 double
 MPI_Wtick( )
 {
-   return(0.0);
+   return(1.0e-6);
 }
 
+#ifndef braid_THREADS
+
 int
 MPI_Barrier( MPI_Comm comm )
 {
    return(0);
 }
 
+#endif
+
 int
 MPI_Comm_create( MPI_Comm   comm,
                        MPI_Group  group,
@@ -76,6 +90,8 @@ MPI_Comm_create( MPI_Comm   comm,
    return(0);
 }
 
+#ifndef braid_THREADS
+
 int
 MPI_Comm_dup( MPI_Comm  comm,
                     MPI_Comm *newcomm )
@@ -105,6 +121,8 @@ MPI_Comm_free( MPI_Comm *comm )
    return 0;
 }
 
+#endif
+
 int
 MPI_Comm_group( MPI_Comm   comm,
                       MPI_Group *group )
@@ -112,6 +130,8 @@ MPI_Comm_group( MPI_Comm   comm,
    return(0);
 }
 
+#ifndef braid_THREADS
+
 int
 MPI_Comm_split( MPI_Comm  comm,
                       int       n,
@@ -121,6 +141,8 @@ MPI_Comm_split( MPI_Comm  comm,
    return(0);
 }
 
+#endif
+
 int
 MPI_Group_incl( MPI_Group  group,
                       int        n,
@@ -143,6 +165,8 @@ MPI_Address( void           *location,
    return(0);
 }
 
+#ifndef braid_THREADS
+
 int
 MPI_Get_count( MPI_Status   *status,
                      MPI_Datatype  datatype,
@@ -569,12 +593,26 @@ MPI_Scan( void               *sendbuf,
    return 0;
 }
 
+/* recvbuf is undefined on rank 0, the only rank */
+int
+MPI_Exscan( void               *sendbuf,
+                void               *recvbuf,
+                int           count,
+                MPI_Datatype  datatype,
+                MPI_Op        op,
+                MPI_Comm      comm )
+{ 
+   return 0;
+}
+
 int
 MPI_Request_free( MPI_Request *request )
 {
    return 0;
 }
 
+#endif
+
 int
 MPI_Type_contiguous( int           count,
                            MPI_Datatype  oldtype,
@@ -625,10 +663,48 @@ MPI_Type_free( MPI_Datatype *datatype )
    return(0);
 }
 
+int
+MPI_Type_size( MPI_Datatype  datatype,
+               int          *size )
+{
+   /* Derived types are not built by these stubs, so only the basic types
+    * have a size */
+   switch (datatype)
+   {
+      case MPI_DOUBLE:  *size = sizeof(double);   break;
+      case MPI_INT:     *size = sizeof(int);      break;
+      case MPI_CHAR:    *size = sizeof(char);     break;
+      case MPI_LONG:    *size = sizeof(long);     break;
+      case MPI_BYTE:    *size = 1;                break;
+      case MPI_REAL:    *size = sizeof(double);   break;
+      case MPI_COMPLEX: *size = 2*sizeof(double); break;
+      case MPI_FLOAT:   *size = sizeof(float);    break;
+      default:          *size = 0;                break;
+   }
+   return(0);
+}
+
 int
 MPI_Op_free( MPI_Op *op )
 {
    return(0);
 }
 
+int
+MPI_Get_address( void     *location,
+                 MPI_Aint *address )
+{
+   return(0);
+}
+
+int
+MPI_Type_create_hindexed( int           count,
+                          int          *array_of_blocklengths,
+                          MPI_Aint     *array_of_displacements,
+                          MPI_Datatype  oldtype,
+                          MPI_Datatype *newtype )
+{
+   return(0);
+}
+
 #endif
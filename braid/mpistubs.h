@@ -24,6 +24,9 @@ extern "C" {
 
 /******************************************************************************
  * MPI stubs to generate serial codes without mpi
+ *
+ * With braid_THREADS (make sequential=yes threads=yes), the stubs run
+ * BRAID_NUM_THREADS ranks as threads of one process instead (see mpithreads.c)
  *****************************************************************************/
 
 /* These types have associated creation and destruction routines */
@@ -31,11 +34,13 @@ extern "C" {
 typedef int MPI_Group;
 typedef int MPI_Request;
 typedef int MPI_Datatype;
+typedef int MPI_Win;
 
 typedef struct
 {
    int MPI_SOURCE;
    int MPI_TAG;
+   int count;        /* received bytes (braid_THREADS) */
 } MPI_Status;
 typedef int  MPI_Op;
 typedef int  MPI_Aint;
@@ -63,8 +68,8 @@ typedef int  MPI_Aint;
 
 #define  MPI_UNDEFINED -9999
 #define  MPI_REQUEST_NULL  0
-#define  MPI_ANY_SOURCE    1
-#define  MPI_ANY_TAG       1
+#define  MPI_ANY_SOURCE    -2
+#define  MPI_ANY_TAG       -1
 
 /*--------------------------------------------------------------------------
  * Prototypes
@@ -116,6 +121,7 @@ int MPI_Waitany( int count , MPI_Request *array_of_requests , int *index , MPI_S
 int MPI_Allreduce( void *sendbuf , void *recvbuf , int count , MPI_Datatype datatype , MPI_Op op , MPI_Comm comm );
 int MPI_Reduce( void *sendbuf , void *recvbuf , int count , MPI_Datatype datatype , MPI_Op op , int root , MPI_Comm comm );
 int MPI_Scan( void *sendbuf , void *recvbuf , int count , MPI_Datatype datatype , MPI_Op op , MPI_Comm comm );
+int MPI_Exscan( void *sendbuf , void *recvbuf , int count , MPI_Datatype datatype , MPI_Op op , MPI_Comm comm );
 int MPI_Request_free( MPI_Request *request );
 int MPI_Type_contiguous( int count , MPI_Datatype oldtype , MPI_Datatype *newtype );
 int MPI_Type_vector( int count , int blocklength , int stride , MPI_Datatype oldtype , MPI_Datatype *newtype );
@@ -123,6 +129,10 @@ int MPI_Type_hvector( int count , int blocklength , MPI_Aint stride , MPI_Dataty
 int MPI_Type_struct( int count , int *array_of_blocklengths , MPI_Aint *array_of_displacements , MPI_Datatype *array_of_types , MPI_Datatype *newtype );
 int MPI_Type_commit( MPI_Datatype *datatype );
 int MPI_Type_free( MPI_Datatype *datatype );
+int MPI_Type_size( MPI_Datatype datatype , int *size );
+int MPI_Get_address( void *location , MPI_Aint *address );
+int MPI_Type_create_hindexed( int count , int *array_of_blocklengths , MPI_Aint *array_of_displacements , MPI_Datatype oldtype , MPI_Datatype *newtype );
+int MPI_Op_free( MPI_Op *op );
 
 #endif
    
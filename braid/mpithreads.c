@@ -0,0 +1,1255 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory. Written by
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+/******************************************************************************
+ * MPI stubs that run the ranks as threads of one process, for time-parallel
+ * runs without an MPI installation (make sequential=yes threads=yes).
+ *
+ * MPI_Init starts BRAID_NUM_THREADS-1 threads (default 1, i.e., serial), each
+ * of which calls main() again as its own rank.  Messages are handed over by
+ * pointer: MPI_Isend queues the sender's buffer at the receiver, and the
+ * receiver copies straight out of it, which completes the send.  MPI_Send
+ * queues a copy, so that it never blocks.  Collectives exchange pointers
+ * through one slot per rank of the communicator, between two barriers.
+ *
+ * Since the ranks share one address space, global variables of the user's
+ * program are shared between ranks, and exit() ends all ranks.  Derived
+ * datatypes (braid_SetBufDescribe) and persistent requests are not supported.
+ *****************************************************************************/
+
+#include <string.h>
+#include <pthread.h>
+#include "_braid.h"
+
+#if defined(braid_SEQUENTIAL) && defined(braid_THREADS)
+
+extern int main(int argc, char **argv);
+
+#define _braid_THREAD_MAXCOMM 1024
+
+/* A queued message.  The receiver copies it out and sets done (under the
+ * sender's lock), or frees it if the buffer is its own copy (MPI_Send). */
+typedef struct _braid_ThreadMsg_struct
+{
+   MPI_Comm    comm;
+   int         source;       /* rank of the sender in comm */
+   int         tag;
+   void       *buf;
+   int         size;         /* bytes */
+   int         owned;        /* buf is a copy that belongs to the message */
+   int         done;
+   int         sender;       /* thread of the sender */
+   struct _braid_ThreadMsg_struct *next;
+
+} _braid_ThreadMsg;
+
+/* The message queue of one thread, in arrival order */
+typedef struct
+{
+   pthread_mutex_t    lock;
+   pthread_cond_t     cond;
+   _braid_ThreadMsg  *head;
+   _braid_ThreadMsg  *tail;
+   int                events;    /* counts arrivals and completed sends */
+
+} _braid_ThreadBox;
+
+typedef struct
+{
+   int              size;
+   int             *thread;      /* thread of each rank */
+   int             *rank;        /* rank of each thread, -1 if not a member */
+   void           **slot;        /* pointers exchanged by collectives */
+   void           **slot2;
+   int             *islot;       /* (color, key) pairs of MPI_Comm_split */
+   pthread_mutex_t  lock;
+   pthread_cond_t   cond;
+   int              count;       /* barrier */
+   int              generation;
+
+} _braid_ThreadComm;
+
+typedef struct
+{
+   int                type;      /* 0 free, 1 send, 2 receive */
+   int                complete;
+   _braid_ThreadMsg  *msg;
+   MPI_Comm           comm;
+   int                source;
+   int                tag;
+   void              *buf;
+   int                maxsize;
+   MPI_Status         status;
+
+} _braid_ThreadReq;
+
+static int                  _braid_nthreads = 0;
+static pthread_t           *_braid_threads  = NULL;
+static _braid_ThreadBox    *_braid_boxes    = NULL;
+static _braid_ThreadComm   *_braid_comms[_braid_THREAD_MAXCOMM];
+static int                  _braid_ncomms   = 0;
+static pthread_mutex_t      _braid_comms_lock = PTHREAD_MUTEX_INITIALIZER;
+static int                  _braid_argc;
+static char               **_braid_argv;
+static char                *_braid_noargv[2] = {"braid", NULL};
+
+static __thread int                _braid_thread = 0;
+static __thread _braid_ThreadReq  *_braid_reqs  = NULL;
+static __thread int                _braid_nreqs = 0;
+
+/*----------------------------------------------------------------------------
+ * Helpers
+ *----------------------------------------------------------------------------*/
+
+static int
+_braid_ThreadTypeSize( MPI_Datatype datatype )
+{
+   switch (datatype)
+   {
+      case MPI_DOUBLE:  return sizeof(double);
+      case MPI_INT:     return sizeof(int);
+      case MPI_CHAR:    return sizeof(char);
+      case MPI_LONG:    return sizeof(long);
+      case MPI_BYTE:    return 1;
+      case MPI_REAL:    return sizeof(double);
+      case MPI_COMPLEX: return 2*sizeof(double);
+      case MPI_FLOAT:   return sizeof(float);
+   }
+   return 0;
+}
+
+static _braid_ThreadComm *
+_braid_ThreadCommCreate( int  size,
+                         int *thread )
+{
+   _braid_ThreadComm *c;
+   int                i;
+
+   c = (_braid_ThreadComm *) calloc(1, sizeof(_braid_ThreadComm));
+   c->size   = size;
+   c->thread = (int *) malloc(size*sizeof(int));
+   c->rank   = (int *) malloc(_braid_nthreads*sizeof(int));
+   c->slot   = (void **) calloc(size, sizeof(void *));
+   c->slot2  = (void **) calloc(size, sizeof(void *));
+   c->islot  = (int *) calloc(2*size, sizeof(int));
+   for (i = 0; i < _braid_nthreads; i++)
+   {
+      c->rank[i] = -1;
+   }
+   for (i = 0; i < size; i++)
+   {
+      c->thread[i] = thread[i];
+      c->rank[thread[i]] = i;
+   }
+   pthread_mutex_init(&c->lock, NULL);
+   pthread_cond_init(&c->cond, NULL);
+
+   return c;
+}
+
+static void
+_braid_ThreadBarrier( _braid_ThreadComm *c )
+{
+   int generation;
+
+   pthread_mutex_lock(&c->lock);
+   generation = c->generation;
+   c->count++;
+   if (c->count == c->size)
+   {
+      c->count = 0;
+      c->generation++;
+      pthread_cond_broadcast(&c->cond);
+   }
+   else
+   {
+      while (generation == c->generation)
+      {
+         pthread_cond_wait(&c->cond, &c->lock);
+      }
+   }
+   pthread_mutex_unlock(&c->lock);
+}
+
+/* Reduce count values of in into inout */
+static void
+_braid_ThreadOp( void         *in,
+                 void         *inout,
+                 int           count,
+                 MPI_Datatype  datatype,
+                 MPI_Op        op )
+{
+   int i;
+
+#define _braid_THREAD_OP(type)                                          \
+   {                                                                    \
+      type *a = (type *) in, *b = (type *) inout;                       \
+      for (i = 0; i < count; i++)                                       \
+      {                                                                 \
+         switch (op)                                                    \
+         {                                                              \
+            case MPI_SUM: b[i] = b[i] + a[i];              break;       \
+            case MPI_MIN: b[i] = (a[i] < b[i]) ? a[i] : b[i]; break;    \
+            case MPI_MAX: b[i] = (a[i] > b[i]) ? a[i] : b[i]; break;    \
+            case MPI_LOR: b[i] = (a[i] || b[i]);           break;       \
+         }                                                              \
+      }                                                                 \
+   }
+
+   switch (datatype)
+   {
+      case MPI_DOUBLE:
+      case MPI_REAL:    _braid_THREAD_OP(double); break;
+      case MPI_INT:     _braid_THREAD_OP(int);    break;
+      case MPI_LONG:    _braid_THREAD_OP(long);   break;
+      case MPI_FLOAT:   _braid_THREAD_OP(float);  break;
+      case MPI_CHAR:    _braid_THREAD_OP(char);   break;
+   }
+
+#undef _braid_THREAD_OP
+}
+
+static void *
+_braid_ThreadMain( void *arg )
+{
+   _braid_thread = (int) (size_t) arg;
+   main(_braid_argc, _braid_argv);
+
+   return NULL;
+}
+
+/* Find, unlink and copy out a matching message for a receive request.  The
+ * queue of this thread must be locked, and is unlocked if a match is found. */
+static int
+_braid_ThreadMatch( _braid_ThreadReq *req )
+{
+   _braid_ThreadBox  *box = &_braid_boxes[_braid_thread];
+   _braid_ThreadMsg  *msg, *prev = NULL;
+   int                size;
+
+   for (msg = box->head; msg != NULL; prev = msg, msg = msg->next)
+   {
+      if ( (msg->comm == req->comm) &&
+           ((req->source == MPI_ANY_SOURCE) || (msg->source == req->source)) &&
+           ((req->tag == MPI_ANY_TAG) || (msg->tag == req->tag)) )
+      {
+         break;
+      }
+   }
+   if (msg == NULL)
+   {
+      return 0;
+   }
+
+   if (prev == NULL)
+   {
+      box->head = msg->next;
+   }
+   else
+   {
+      prev->next = msg->next;
+   }
+   if (box->tail == msg)
+   {
+      box->tail = prev;
+   }
+   pthread_mutex_unlock(&box->lock);
+
+   size = (msg->size < req->maxsize) ? msg->size : req->maxsize;
+   memcpy(req->buf, msg->buf, size);
+   req->status.MPI_SOURCE = msg->source;
+   req->status.MPI_TAG    = msg->tag;
+   req->status.count      = size;
+   req->complete          = 1;
+
+   if (msg->owned)
+   {
+      free(msg->buf);
+      free(msg);
+   }
+   else
+   {
+      /* Complete the send */
+      box = &_braid_boxes[msg->sender];
+      pthread_mutex_lock(&box->lock);
+      msg->done = 1;
+      box->events++;
+      pthread_cond_broadcast(&box->cond);
+      pthread_mutex_unlock(&box->lock);
+   }
+
+   return 1;
+}
+
+/* Test (block = 0) or wait for (block = 1) a request */
+static int
+_braid_ThreadProgress( _braid_ThreadReq *req,
+                       int               block )
+{
+   _braid_ThreadBox  *box = &_braid_boxes[_braid_thread];
+
+   if (req->complete)
+   {
+      return 1;
+   }
+
+   pthread_mutex_lock(&box->lock);
+   if (req->type == 1)
+   {
+      while (block && !req->msg->done)
+      {
+         pthread_cond_wait(&box->cond, &box->lock);
+      }
+      if (req->msg->done)
+      {
+         req->complete = 1;
+         free(req->msg);
+         req->msg = NULL;
+      }
+      pthread_mutex_unlock(&box->lock);
+   }
+   else
+   {
+      while (!_braid_ThreadMatch(req))
+      {
+         if (!block)
+         {
+            pthread_mutex_unlock(&box->lock);
+            break;
+         }
+         /* Sleep until a new message arrives */
+         pthread_cond_wait(&box->cond, &box->lock);
+      }
+   }
+
+   return req->complete;
+}
+
+static void
+_braid_ThreadPost( _braid_ThreadMsg *msg,
+                   int               thread )
+{
+   _braid_ThreadBox  *box = &_braid_boxes[thread];
+
+   msg->next = NULL;
+   pthread_mutex_lock(&box->lock);
+   if (box->tail == NULL)
+   {
+      box->head = msg;
+   }
+   else
+   {
+      box->tail->next = msg;
+   }
+   box->tail = msg;
+   box->events++;
+   pthread_cond_broadcast(&box->cond);
+   pthread_mutex_unlock(&box->lock);
+}
+
+static int
+_braid_ThreadNewReq( int type )
+{
+   int r;
+
+   for (r = 0; r < _braid_nreqs; r++)
+   {
+      if (_braid_reqs[r].type == 0)
+      {
+         break;
+      }
+   }
+   if (r == _braid_nreqs)
+   {
+      _braid_nreqs = 2*_braid_nreqs + 8;
+      _braid_reqs  = (_braid_ThreadReq *) realloc(_braid_reqs, _braid_nreqs*sizeof(_braid_ThreadReq));
+      memset(&_braid_reqs[r], 0, (_braid_nreqs-r)*sizeof(_braid_ThreadReq));
+   }
+   memset(&_braid_reqs[r], 0, sizeof(_braid_ThreadReq));
+   _braid_reqs[r].type = type;
+
+   return r+1;   /* 0 is MPI_REQUEST_NULL */
+}
+
+/* Finish a completed request, copy its status and free it */
+static void
+_braid_ThreadFreeReq( MPI_Request *request,
+                      MPI_Status  *status )
+{
+   _braid_ThreadReq *req = &_braid_reqs[*request-1];
+
+   if (status != NULL)
+   {
+      *status = req->status;
+   }
+   req->type = 0;
+   *request  = MPI_REQUEST_NULL;
+}
+
+/*----------------------------------------------------------------------------
+ * Environment
+ *----------------------------------------------------------------------------*/
+
+int
+MPI_Init( int    *argc,
+          char ***argv )
+{
+   int   *thread, i;
+   char  *nthreads;
+
+   if ( (_braid_thread != 0) || (_braid_boxes != NULL) )
+   {
+      /* A rank started by the first MPI_Init */
+      return(0);
+   }
+
+   nthreads = getenv("BRAID_NUM_THREADS");
+   _braid_nthreads = (nthreads != NULL) ? atoi(nthreads) : 1;
+   if (_braid_nthreads < 1)
+   {
+      _braid_nthreads = 1;
+   }
+   _braid_argc = ( (argc != NULL) && (argv != NULL) ) ? *argc : 1;
+   _braid_argv = ( (argc != NULL) && (argv != NULL) ) ? *argv : _braid_noargv;
+
+   _braid_boxes = (_braid_ThreadBox *) calloc(_braid_nthreads, sizeof(_braid_ThreadBox));
+   thread = (int *) malloc(_braid_nthreads*sizeof(int));
+   for (i = 0; i < _braid_nthreads; i++)
+   {
+      pthread_mutex_init(&_braid_boxes[i].lock, NULL);
+      pthread_cond_init(&_braid_boxes[i].cond, NULL);
+      thread[i] = i;
+   }
+   _braid_comms[MPI_COMM_WORLD] = _braid_ThreadCommCreate(_braid_nthreads, thread);
+   _braid_ncomms = 1;
+   free(thread);
+
+   _braid_threads = (pthread_t *) malloc(_braid_nthreads*sizeof(pthread_t));
+   for (i = 1; i < _braid_nthreads; i++)
+   {
+      pthread_create(&_braid_threads[i], NULL, _braid_ThreadMain, (void *) (size_t) i);
+   }
+
+   return(0);
+}
+
+int
+MPI_Finalize( )
+{
+   int i;
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (_braid_thread == 0)
+   {
+      for (i = 1; i < _braid_nthreads; i++)
+      {
+         pthread_join(_braid_threads[i], NULL);
+      }
+   }
+   free(_braid_reqs);
+   _braid_reqs  = NULL;
+   _braid_nreqs = 0;
+
+   return(0);
+}
+
+int
+MPI_Abort( MPI_Comm comm,
+           int      errorcode )
+{
+   exit(errorcode);
+   return(0);
+}
+
+/*----------------------------------------------------------------------------
+ * Communicators
+ *----------------------------------------------------------------------------*/
+
+int
+MPI_Comm_size( MPI_Comm  comm,
+               int      *size )
+{
+   *size = _braid_comms[comm]->size;
+   return(0);
+}
+
+int
+MPI_Comm_rank( MPI_Comm  comm,
+               int      *rank )
+{
+   *rank = _braid_comms[comm]->rank[_braid_thread];
+   if (*rank < 0)
+   {
+      *rank = MPI_UNDEFINED;
+   }
+   return(0);
+}
+
+int
+MPI_Comm_split( MPI_Comm  comm,
+                int       color,
+                int       key,
+                MPI_Comm *newcomm )
+{
+   _braid_ThreadComm  *c    = _braid_comms[comm];
+   int                 rank = c->rank[_braid_thread];
+   int                *thread, *done, n, i, j, k, t;
+
+   c->islot[2*rank]   = color;
+   c->islot[2*rank+1] = key;
+   _braid_ThreadBarrier(c);
+
+   if (rank == 0)
+   {
+      /* Create the new communicators, ordered by key and then by rank */
+      thread = (int *) malloc(c->size*sizeof(int));
+      done   = (int *) calloc(c->size, sizeof(int));
+      for (i = 0; i < c->size; i++)
+      {
+         if ( done[i] || (c->islot[2*i] == MPI_UNDEFINED) )
+         {
+            c->slot[i] = (void *) (size_t) (MPI_COMM_NULL + 1);
+            continue;
+         }
+         n = 0;
+         for (j = i; j < c->size; j++)
+         {
+            if ( !done[j] && (c->islot[2*j] == c->islot[2*i]) )
+            {
+               for (k = n; (k > 0) && (c->islot[2*c->rank[thread[k-1]]+1] > c->islot[2*j+1]); k--)
+               {
+                  thread[k] = thread[k-1];
+               }
+               thread[k] = c->thread[j];
+               done[j] = 1;
+               n++;
+            }
+         }
+         pthread_mutex_lock(&_braid_comms_lock);
+         if (_braid_ncomms == _braid_THREAD_MAXCOMM)
+         {
+            printf("MPI_Comm_split: too many communicators\n");
+            exit(1);
+         }
+         _braid_comms[_braid_ncomms] = _braid_ThreadCommCreate(n, thread);
+         for (k = 0; k < n; k++)
+         {
+            t = c->rank[thread[k]];
+            c->slot[t] = (void *) (size_t) (_braid_ncomms + 1);
+         }
+         _braid_ncomms++;
+         pthread_mutex_unlock(&_braid_comms_lock);
+      }
+      free(thread);
+      free(done);
+   }
+   _braid_ThreadBarrier(c);
+
+   *newcomm = (MPI_Comm) ((size_t) c->slot[rank]) - 1;
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Comm_dup( MPI_Comm  comm,
+              MPI_Comm *newcomm )
+{
+   int rank;
+
+   MPI_Comm_rank(comm, &rank);
+   return MPI_Comm_split(comm, 0, rank, newcomm);
+}
+
+int
+MPI_Comm_free( MPI_Comm *comm )
+{
+   *comm = MPI_COMM_NULL;
+   return(0);
+}
+
+/*----------------------------------------------------------------------------
+ * Point-to-point
+ *----------------------------------------------------------------------------*/
+
+int
+MPI_Isend( void          *buf,
+           int            count,
+           MPI_Datatype   datatype,
+           int            dest,
+           int            tag,
+           MPI_Comm       comm,
+           MPI_Request   *request )
+{
+   _braid_ThreadComm *c = _braid_comms[comm];
+   _braid_ThreadMsg  *msg;
+
+   *request = _braid_ThreadNewReq(1);
+
+   msg = (_braid_ThreadMsg *) calloc(1, sizeof(_braid_ThreadMsg));
+   msg->comm   = comm;
+   msg->source = c->rank[_braid_thread];
+   msg->tag    = tag;
+   msg->buf    = buf;
+   msg->size   = count*_braid_ThreadTypeSize(datatype);
+   msg->sender = _braid_thread;
+   _braid_reqs[*request-1].msg = msg;
+   _braid_ThreadPost(msg, c->thread[dest]);
+
+   return(0);
+}
+
+int
+MPI_Irsend( void          *buf,
+            int            count,
+            MPI_Datatype   datatype,
+            int            dest,
+            int            tag,
+            MPI_Comm       comm,
+            MPI_Request   *request )
+{
+   return MPI_Isend(buf, count, datatype, dest, tag, comm, request);
+}
+
+int
+MPI_Send( void          *buf,
+          int            count,
+          MPI_Datatype   datatype,
+          int            dest,
+          int            tag,
+          MPI_Comm       comm )
+{
+   _braid_ThreadComm *c = _braid_comms[comm];
+   _braid_ThreadMsg  *msg;
+
+   msg = (_braid_ThreadMsg *) calloc(1, sizeof(_braid_ThreadMsg));
+   msg->comm   = comm;
+   msg->source = c->rank[_braid_thread];
+   msg->tag    = tag;
+   msg->size   = count*_braid_ThreadTypeSize(datatype);
+   msg->buf    = malloc(msg->size + 1);
+   msg->owned  = 1;
+   msg->sender = _braid_thread;
+   memcpy(msg->buf, buf, msg->size);
+   _braid_ThreadPost(msg, c->thread[dest]);
+
+   return(0);
+}
+
+int
+MPI_Irecv( void          *buf,
+           int            count,
+           MPI_Datatype   datatype,
+           int            source,
+           int            tag,
+           MPI_Comm       comm,
+           MPI_Request   *request )
+{
+   _braid_ThreadReq *req;
+
+   *request = _braid_ThreadNewReq(2);
+   req = &_braid_reqs[*request-1];
+   req->comm    = comm;
+   req->source  = source;
+   req->tag     = tag;
+   req->buf     = buf;
+   req->maxsize = count*_braid_ThreadTypeSize(datatype);
+
+   return(0);
+}
+
+int
+MPI_Recv( void          *buf,
+          int            count,
+          MPI_Datatype   datatype,
+          int            source,
+          int            tag,
+          MPI_Comm       comm,
+          MPI_Status    *status )
+{
+   MPI_Request request;
+
+   MPI_Irecv(buf, count, datatype, source, tag, comm, &request);
+   return MPI_Wait(&request, status);
+}
+
+int
+MPI_Send_init( void          *buf,
+               int            count,
+               MPI_Datatype   datatype,
+               int            dest,
+               int            tag,
+               MPI_Comm       comm,
+               MPI_Request   *request )
+{
+   printf("MPI_Send_init: persistent requests are not supported with braid_THREADS\n");
+   exit(1);
+   return(0);
+}
+
+int
+MPI_Recv_init( void          *buf,
+               int            count,
+               MPI_Datatype   datatype,
+               int            dest,
+               int            tag,
+               MPI_Comm       comm,
+               MPI_Request   *request )
+{
+   printf("MPI_Recv_init: persistent requests are not supported with braid_THREADS\n");
+   exit(1);
+   return(0);
+}
+
+int
+MPI_Startall( int          count,
+              MPI_Request *array_of_requests )
+{
+   return(0);
+}
+
+int
+MPI_Iprobe( int         source,
+            int         tag,
+            MPI_Comm    comm,
+            int        *flag,
+            MPI_Status *status )
+{
+   _braid_ThreadBox  *box = &_braid_boxes[_braid_thread];
+   _braid_ThreadMsg  *msg;
+
+   *flag = 0;
+   pthread_mutex_lock(&box->lock);
+   for (msg = box->head; msg != NULL; msg = msg->next)
+   {
+      if ( (msg->comm == comm) &&
+           ((source == MPI_ANY_SOURCE) || (msg->source == source)) &&
+           ((tag == MPI_ANY_TAG) || (msg->tag == tag)) )
+      {
+         *flag = 1;
+         if (status != NULL)
+         {
+            status->MPI_SOURCE = msg->source;
+            status->MPI_TAG    = msg->tag;
+            status->count      = msg->size;
+         }
+         break;
+      }
+   }
+   pthread_mutex_unlock(&box->lock);
+
+   return(0);
+}
+
+int
+MPI_Probe( int         source,
+           int         tag,
+           MPI_Comm    comm,
+           MPI_Status *status )
+{
+   _braid_ThreadBox  *box = &_braid_boxes[_braid_thread];
+   int                flag, events;
+
+   while (1)
+   {
+      pthread_mutex_lock(&box->lock);
+      events = box->events;
+      pthread_mutex_unlock(&box->lock);
+      MPI_Iprobe(source, tag, comm, &flag, status);
+      if (flag)
+      {
+         break;
+      }
+      pthread_mutex_lock(&box->lock);
+      while (box->events == events)
+      {
+         pthread_cond_wait(&box->cond, &box->lock);
+      }
+      pthread_mutex_unlock(&box->lock);
+   }
+
+   return(0);
+}
+
+int
+MPI_Get_count( MPI_Status   *status,
+               MPI_Datatype  datatype,
+               int          *count )
+{
+   *count = status->count / _braid_ThreadTypeSize(datatype);
+   return(0);
+}
+
+int
+MPI_Test( MPI_Request *request,
+          int         *flag,
+          MPI_Status  *status )
+{
+   *flag = 1;
+   if (*request != MPI_REQUEST_NULL)
+   {
+      *flag = _braid_ThreadProgress(&_braid_reqs[*request-1], 0);
+      if (*flag)
+      {
+         _braid_ThreadFreeReq(request, status);
+      }
+   }
+   return(0);
+}
+
+int
+MPI_Testall( int          count,
+             MPI_Request *array_of_requests,
+             int         *flag,
+             MPI_Status  *array_of_statuses )
+{
+   int i;
+
+   *flag = 1;
+   for (i = 0; i < count; i++)
+   {
+      if (array_of_requests[i] != MPI_REQUEST_NULL)
+      {
+         *flag &= _braid_ThreadProgress(&_braid_reqs[array_of_requests[i]-1], 0);
+      }
+   }
+   if (*flag)
+   {
+      for (i = 0; i < count; i++)
+      {
+         if (array_of_requests[i] != MPI_REQUEST_NULL)
+         {
+            _braid_ThreadFreeReq(&array_of_requests[i],
+                                 (array_of_statuses != NULL) ? &array_of_statuses[i] : NULL);
+         }
+      }
+   }
+   return(0);
+}
+
+int
+MPI_Wait( MPI_Request *request,
+          MPI_Status  *status )
+{
+   if (*request != MPI_REQUEST_NULL)
+   {
+      _braid_ThreadProgress(&_braid_reqs[*request-1], 1);
+      _braid_ThreadFreeReq(request, status);
+   }
+   return(0);
+}
+
+int
+MPI_Waitall( int          count,
+             MPI_Request *array_of_requests,
+             MPI_Status  *array_of_statuses )
+{
+   int i;
+
+   for (i = 0; i < count; i++)
+   {
+      MPI_Wait(&array_of_requests[i], (array_of_statuses != NULL) ? &array_of_statuses[i] : NULL);
+   }
+   return(0);
+}
+
+int
+MPI_Waitany( int          count,
+             MPI_Request *array_of_requests,
+             int         *index,
+             MPI_Status  *status )
+{
+   _braid_ThreadBox  *box = &_braid_boxes[_braid_thread];
+   int                i, active, events;
+
+   while (1)
+   {
+      pthread_mutex_lock(&box->lock);
+      events = box->events;
+      pthread_mutex_unlock(&box->lock);
+      active = 0;
+      for (i = 0; i < count; i++)
+      {
+         if (array_of_requests[i] != MPI_REQUEST_NULL)
+         {
+            active = 1;
+            if (_braid_ThreadProgress(&_braid_reqs[array_of_requests[i]-1], 0))
+            {
+               _braid_ThreadFreeReq(&array_of_requests[i], status);
+               *index = i;
+               return(0);
+            }
+         }
+      }
+      if (!active)
+      {
+         *index = MPI_UNDEFINED;
+         return(0);
+      }
+      /* Both arriving messages and completed sends wake this thread */
+      pthread_mutex_lock(&box->lock);
+      while (box->events == events)
+      {
+         pthread_cond_wait(&box->cond, &box->lock);
+      }
+      pthread_mutex_unlock(&box->lock);
+   }
+   return(0);
+}
+
+int
+MPI_Request_free( MPI_Request *request )
+{
+   if (*request != MPI_REQUEST_NULL)
+   {
+      _braid_ThreadProgress(&_braid_reqs[*request-1], 1);
+      _braid_ThreadFreeReq(request, NULL);
+   }
+   return(0);
+}
+
+/*----------------------------------------------------------------------------
+ * Collectives
+ *----------------------------------------------------------------------------*/
+
+int
+MPI_Barrier( MPI_Comm comm )
+{
+   _braid_ThreadBarrier(_braid_comms[comm]);
+   return(0);
+}
+
+int
+MPI_Allreduce( void          *sendbuf,
+               void          *recvbuf,
+               int            count,
+               MPI_Datatype   datatype,
+               MPI_Op         op,
+               MPI_Comm       comm )
+{
+   _braid_ThreadComm *c    = _braid_comms[comm];
+   int                rank = c->rank[_braid_thread];
+   int                size = count*_braid_ThreadTypeSize(datatype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   /* Every rank reduces in the same order, so all get the same result */
+   memcpy(recvbuf, c->slot[0], size);
+   for (i = 1; i < c->size; i++)
+   {
+      _braid_ThreadOp(c->slot[i], recvbuf, count, datatype, op);
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Reduce( void          *sendbuf,
+            void          *recvbuf,
+            int            count,
+            MPI_Datatype   datatype,
+            MPI_Op         op,
+            int            root,
+            MPI_Comm       comm )
+{
+   _braid_ThreadComm *c    = _braid_comms[comm];
+   int                rank = c->rank[_braid_thread];
+   int                size = count*_braid_ThreadTypeSize(datatype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   if (rank == root)
+   {
+      memcpy(recvbuf, c->slot[0], size);
+      for (i = 1; i < c->size; i++)
+      {
+         _braid_ThreadOp(c->slot[i], recvbuf, count, datatype, op);
+      }
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Scan( void          *sendbuf,
+          void          *recvbuf,
+          int            count,
+          MPI_Datatype   datatype,
+          MPI_Op         op,
+          MPI_Comm       comm )
+{
+   _braid_ThreadComm *c    = _braid_comms[comm];
+   int                rank = c->rank[_braid_thread];
+   int                size = count*_braid_ThreadTypeSize(datatype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   memcpy(recvbuf, c->slot[0], size);
+   for (i = 1; i <= rank; i++)
+   {
+      _braid_ThreadOp(c->slot[i], recvbuf, count, datatype, op);
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+/* recvbuf is left undefined on rank 0, as in MPI */
+int
+MPI_Exscan( void          *sendbuf,
+            void          *recvbuf,
+            int            count,
+            MPI_Datatype   datatype,
+            MPI_Op         op,
+            MPI_Comm       comm )
+{
+   _braid_ThreadComm *c    = _braid_comms[comm];
+   int                rank = c->rank[_braid_thread];
+   int                size = count*_braid_ThreadTypeSize(datatype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   if (rank > 0)
+   {
+      memcpy(recvbuf, c->slot[0], size);
+   }
+   for (i = 1; i < rank; i++)
+   {
+      _braid_ThreadOp(c->slot[i], recvbuf, count, datatype, op);
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Bcast( void          *buffer,
+           int            count,
+           MPI_Datatype   datatype,
+           int            root,
+           MPI_Comm       comm )
+{
+   _braid_ThreadComm *c    = _braid_comms[comm];
+   int                rank = c->rank[_braid_thread];
+
+   c->slot[rank] = buffer;
+   _braid_ThreadBarrier(c);
+   if (rank != root)
+   {
+      memcpy(buffer, c->slot[root], count*_braid_ThreadTypeSize(datatype));
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Allgatherv( void          *sendbuf,
+                int            sendcount,
+                MPI_Datatype   sendtype,
+                void          *recvbuf,
+                int           *recvcounts,
+                int           *displs,
+                MPI_Datatype   recvtype,
+                MPI_Comm       comm )
+{
+   _braid_ThreadComm *c     = _braid_comms[comm];
+   int                rank  = c->rank[_braid_thread];
+   int                tsize = _braid_ThreadTypeSize(recvtype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   for (i = 0; i < c->size; i++)
+   {
+      memcpy((char *)recvbuf + (size_t)displs[i]*tsize, c->slot[i], (size_t)recvcounts[i]*tsize);
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Allgather( void          *sendbuf,
+               int            sendcount,
+               MPI_Datatype   sendtype,
+               void          *recvbuf,
+               int            recvcount,
+               MPI_Datatype   recvtype,
+               MPI_Comm       comm )
+{
+   _braid_ThreadComm *c     = _braid_comms[comm];
+   int                rank  = c->rank[_braid_thread];
+   int                tsize = _braid_ThreadTypeSize(recvtype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   for (i = 0; i < c->size; i++)
+   {
+      memcpy((char *)recvbuf + (size_t)i*recvcount*tsize, c->slot[i], (size_t)recvcount*tsize);
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Gatherv( void          *sendbuf,
+             int            sendcount,
+             MPI_Datatype   sendtype,
+             void          *recvbuf,
+             int           *recvcounts,
+             int           *displs,
+             MPI_Datatype   recvtype,
+             int            root,
+             MPI_Comm       comm )
+{
+   _braid_ThreadComm *c     = _braid_comms[comm];
+   int                rank  = c->rank[_braid_thread];
+   int                tsize = _braid_ThreadTypeSize(recvtype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   if (rank == root)
+   {
+      for (i = 0; i < c->size; i++)
+      {
+         memcpy((char *)recvbuf + (size_t)displs[i]*tsize, c->slot[i], (size_t)recvcounts[i]*tsize);
+      }
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Gather( void          *sendbuf,
+            int            sendcount,
+            MPI_Datatype   sendtype,
+            void          *recvbuf,
+            int            recvcount,
+            MPI_Datatype   recvtype,
+            int            root,
+            MPI_Comm       comm )
+{
+   _braid_ThreadComm *c     = _braid_comms[comm];
+   int                rank  = c->rank[_braid_thread];
+   int                tsize = _braid_ThreadTypeSize(recvtype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   if (rank == root)
+   {
+      for (i = 0; i < c->size; i++)
+      {
+         memcpy((char *)recvbuf + (size_t)i*recvcount*tsize, c->slot[i], (size_t)recvcount*tsize);
+      }
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Scatterv( void          *sendbuf,
+              int           *sendcounts,
+              int           *displs,
+              MPI_Datatype   sendtype,
+              void          *recvbuf,
+              int            recvcount,
+              MPI_Datatype   recvtype,
+              int            root,
+              MPI_Comm       comm )
+{
+   _braid_ThreadComm *c     = _braid_comms[comm];
+   int                rank  = c->rank[_braid_thread];
+   int                tsize = _braid_ThreadTypeSize(recvtype);
+
+   c->slot[rank]  = sendbuf;
+   c->slot2[rank] = displs;
+   _braid_ThreadBarrier(c);
+   memcpy(recvbuf, (char *)c->slot[root] + (size_t)((int *)c->slot2[root])[rank]*tsize,
+          (size_t)recvcount*tsize);
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Scatter( void          *sendbuf,
+             int            sendcount,
+             MPI_Datatype   sendtype,
+             void          *recvbuf,
+             int            recvcount,
+             MPI_Datatype   recvtype,
+             int            root,
+             MPI_Comm       comm )
+{
+   _braid_ThreadComm *c     = _braid_comms[comm];
+   int                rank  = c->rank[_braid_thread];
+   int                tsize = _braid_ThreadTypeSize(recvtype);
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   memcpy(recvbuf, (char *)c->slot[root] + (size_t)rank*recvcount*tsize, (size_t)recvcount*tsize);
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+int
+MPI_Alltoall( void          *sendbuf,
+              int            sendcount,
+              MPI_Datatype   sendtype,
+              void          *recvbuf,
+              int            recvcount,
+              MPI_Datatype   recvtype,
+              MPI_Comm       comm )
+{
+   _braid_ThreadComm *c     = _braid_comms[comm];
+   int                rank  = c->rank[_braid_thread];
+   int                tsize = _braid_ThreadTypeSize(recvtype);
+   int                i;
+
+   c->slot[rank] = sendbuf;
+   _braid_ThreadBarrier(c);
+   for (i = 0; i < c->size; i++)
+   {
+      memcpy((char *)recvbuf + (size_t)i*recvcount*tsize,
+             (char *)c->slot[i] + (size_t)rank*recvcount*tsize, (size_t)recvcount*tsize);
+   }
+   _braid_ThreadBarrier(c);
+
+   return(0);
+}
+
+#endif
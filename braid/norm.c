@@ -171,133 +171,42 @@ _braid_GetFullRNorm(braid_Core  core,
 }
 
 /*----------------------------------------------------------------------------
+ * Compute the TriMGRIT residual two-norm over all points of grid 'level' and
+ * set it as the residual norm of the current iteration
  *----------------------------------------------------------------------------*/
 
 braid_Int
-_braid_ComputeFullRNorm(braid_Core  core,
-                        braid_Int   level,
-                        braid_Real *return_rnorm)
+_braid_TriComputeRNorm(braid_Core  core,
+                       braid_Int   level)
 {
-   MPI_Comm           comm        = _braid_CoreElt(core, comm);
-   braid_App          app         = _braid_CoreElt(core, app);
-   braid_Real         tol         = _braid_CoreElt(core, tol);
-   braid_Int          iter        = _braid_CoreElt(core, niter);
-   braid_Int          ichunk      = _braid_CoreElt(core, ichunk);
-   _braid_Grid      **grids       = _braid_CoreElt(core, grids);
-   braid_StepStatus   status      = (braid_StepStatus)core;
-   braid_Int          nrefine     = _braid_CoreElt(core, nrefine);
-   braid_Int          gupper      = _braid_CoreElt(core, gupper);
-   braid_Int          ncpoints    = _braid_GridElt(grids[level], ncpoints);
-   braid_Int          tnorm       = _braid_CoreElt(core, tnorm);
-   braid_Real        *ta          = _braid_GridElt(grids[level], ta);
-   braid_Int          ilower      = _braid_GridElt(grids[level], ilower);
-   _braid_CommHandle *send_handle;
-   braid_Int          send_index;
-
-   braid_Int         flo, fhi, fi, ci, ii, interval;
-   braid_Real        rnorm_temp, rnorm = 0, global_rnorm = 0;
-   braid_BaseVector  u, r;
-
-   _braid_UCommInit(core, level);
-
-   /* Start from the right-most interval. */
-   for (interval = ncpoints; interval > -1; interval--)
+   MPI_Comm           comm     = _braid_CoreElt(core, comm);
+   braid_App          app      = _braid_CoreElt(core, app);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
+   braid_Int          iupper   = _braid_GridElt(grids[level], iupper);
+
+   braid_Int          nrequests;
+   MPI_Request       *requests;
+   MPI_Status        *statuses;
+   void             **buffers;
+
+   braid_BaseVector   r;
+   braid_Real         rnorm, grnorm, srnorm;
+   braid_Int          i;
+
+   _braid_TriCommInit(core, level, &nrequests, &requests, &statuses, &buffers);
+   _braid_TriCommWait(core, level,  nrequests, &requests, &statuses, &buffers);
+
+   rnorm = 0.0;
+   for (i = ilower; i <= iupper; i++)
    {
-      _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
-      if (flo <= fhi)
-      {
-         _braid_UGetVector(core, level, flo-1, &u);
-      }
-      else if (ci > 0)
-      {
-         _braid_UGetVector(core, level, ci-1, &u);
-      }
-
-      /* Generate F-points and get residual. */
-      for (fi = flo; fi <= fhi; fi++)
-      {
-         _braid_BaseClone(core, app,  u, &r);
-         _braid_Step(core, level, fi, NULL, u);
-
-         /* Update local processor norm. */
-         ii = fi-ilower;
-         _braid_StepStatusInit(ta[ii-1], ta[ii], fi-1, ichunk, tol, iter, level, nrefine, gupper, status);
-         _braid_BaseFullResidual(core, app, u, r, status);
-         _braid_BaseSpatialNorm(core, app,  r, &rnorm_temp); 
-         if(tnorm == 1)       /* one-norm */ 
-         {  
-            rnorm += rnorm_temp;
-         }
-         else if(tnorm == 3)  /* inf-norm */
-         {  
-            rnorm = (((rnorm_temp) > (rnorm)) ? (rnorm_temp) : (rnorm));
-         }
-         else                 /* default two-norm */
-         {  
-            rnorm += (rnorm_temp*rnorm_temp);
-         }
-
-         /* Communicate w/ neighbor nodes. */
-         send_handle = _braid_GridElt(grids[level], send_handle);
-         send_index  = _braid_GridElt(grids[level], send_index);
-         if (fi == send_index)
-         {
-            /* Post send to neighbor processor */
-            _braid_CommSendInit(core, level, fi, u, &send_handle);
-            _braid_GridElt(grids[level], send_index)  = -1;
-            _braid_GridElt(grids[level], send_handle) = send_handle;
-         }
-         _braid_BaseFree(core, app,  r);
-      }
-      /* Residual from C-point. */
-      if (ci > 0)
-      {
-         /* Update local processor norm. */
-         ii = ci-ilower;
-         _braid_StepStatusInit(ta[ii-1], ta[ii], ci-1, ichunk, tol, iter, level, nrefine, gupper, status);
-         _braid_UGetVector(core, level, ci, &r);
-         _braid_BaseFullResidual(core, app, r, u, status);
-         _braid_BaseSpatialNorm(core, app,  u, &rnorm_temp);
-
-         if(tnorm == 1)       /* one-norm */ 
-         {  
-            rnorm += rnorm_temp;
-         }
-         else if(tnorm == 3)  /* inf-norm */
-         {  
-            rnorm = (((rnorm_temp) > (rnorm)) ? (rnorm_temp) : (rnorm));
-         }
-         else                 /* default two-norm */
-         {  
-            rnorm += (rnorm_temp*rnorm_temp);
-         }
-         _braid_BaseFree(core, app,  r);
-      }
-
-      if ((flo <= fhi) || (ci > 0))
-      {
-         _braid_BaseFree(core, app,  u);
-      }
+      _braid_TriResidual(core, level, i, 1, &r);
+      _braid_BaseSpatialNorm(core, app, r, &srnorm);
+      rnorm += (srnorm*srnorm);
+      _braid_BaseFree(core, app, r);
    }
-
-   _braid_UCommWait(core, level);
-
-   /* Compute global residual norm. */
-   if(tnorm == 1)       /* one-norm reduction */
-   {  
-      MPI_Allreduce(&rnorm, &global_rnorm, 1, braid_MPI_REAL, MPI_SUM, comm);
-   }
-   else if(tnorm == 3)  /* inf-norm reduction */
-   {  
-      MPI_Allreduce(&rnorm, &global_rnorm, 1, braid_MPI_REAL, MPI_MAX, comm);
-   }
-   else                 /* default two-norm reduction */
-   {  
-      MPI_Allreduce(&rnorm, &global_rnorm, 1, braid_MPI_REAL, MPI_SUM, comm);
-      global_rnorm = sqrt(global_rnorm);
-   }
-
-   *return_rnorm = global_rnorm;
+   MPI_Allreduce(&rnorm, &grnorm, 1, braid_MPI_REAL, MPI_SUM, comm);
+   _braid_SetRNorm(core, -1, sqrt(grnorm));
 
    return _braid_error_flag;
 }
@@ -38,10 +38,17 @@ _braid_FCRelax(braid_Core  core,
    braid_Int       ncpoints = _braid_GridElt(grids[level], ncpoints);
 
    braid_BaseVector  u;
-   braid_Int         flo, fhi, fi, ci;
-   braid_Int         nu, nrelax, interval;
+   braid_Int         flo, fhi, fi, ci, fstart;
+   braid_Int         nu, nrelax, interval, frozen;
+
+   if (_braid_CoreElt(core, step_begin) != NULL)
+   {
+      _braid_FCRelaxAsync(core, level);
+      return _braid_error_flag;
+   }
 
    nrelax  = nrels[level];
+   _braid_GetFrozenIndex(core, level, &frozen);
 
    for (nu = 0; nu < nrelax; nu++)
    {
@@ -52,17 +59,27 @@ _braid_FCRelax(braid_Core  core,
       {
          _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
 
-         if (flo <= fhi)
+         /* Skip intervals in the frozen region, and frozen coarse F-points */
+         if ((ci > 0) && (ci <= frozen))
          {
-            _braid_UGetVector(core, level, flo-1, &u);
+            continue;
          }
-         else if (ci > 0)
+         _braid_USkipFrozen(core, level, frozen, flo, fhi, &fstart, &u);
+
+         if (u == NULL)
          {
-            _braid_UGetVector(core, level, ci-1, &u);
+            if (flo <= fhi)
+            {
+               _braid_UGetVector(core, level, flo-1, &u);
+            }
+            else if (ci > 0)
+            {
+               _braid_UGetVector(core, level, ci-1, &u);
+            }
          }
 
          /* F-relaxation */
-         for (fi = flo; fi <= fhi; fi++)
+         for (fi = fstart; fi <= fhi; fi++)
          {
             _braid_Step(core, level, fi, NULL, u);
             _braid_USetVector(core, level, fi, u, 0);
@@ -87,6 +104,151 @@ _braid_FCRelax(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Do nu sweeps of F-then-C relaxation with asynchronous steps.  Each interval
+ * (slot) keeps one step in flight, and a new step is begun as soon as the last
+ * one of its interval is finished.  The interval that needs the vector from
+ * the left neighbor joins once that message has arrived.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_FCRelaxAsync(braid_Core  core,
+                    braid_Int   level)
+{
+   braid_App       app      = _braid_CoreElt(core, app);
+   braid_Int      *nrels    = _braid_CoreElt(core, nrels);
+   _braid_Grid   **grids    = _braid_CoreElt(core, grids);
+   braid_Int       ncpoints = _braid_GridElt(grids[level], ncpoints);
+   braid_Int       nslots   = ncpoints+1;
+
+   braid_BaseVector  *us;
+   braid_Int         *idx, *fhis, *cis, *busy;
+   braid_Int          flo, fhi, ci, s, fstart;
+   braid_Int          nu, nrelax, frozen, nactive, done;
+
+   nrelax  = nrels[level];
+   _braid_GetFrozenIndex(core, level, &frozen);
+
+   us   = _braid_CTAlloc(braid_BaseVector, nslots);
+   idx  = _braid_CTAlloc(braid_Int, nslots);  /* step in flight or next, -1 when done */
+   fhis = _braid_CTAlloc(braid_Int, nslots);
+   cis  = _braid_CTAlloc(braid_Int, nslots);
+   busy = _braid_CTAlloc(braid_Int, nslots);
+
+   for (nu = 0; nu < nrelax; nu++)
+   {
+      _braid_UCommInit(core, level);
+
+      /* Slot s is interval ncpoints-s, starting from the right-most interval */
+      nactive = 0;
+      for (s = 0; s < nslots; s++)
+      {
+         _braid_GetInterval(core, level, ncpoints-s, &flo, &fhi, &ci);
+         us[s]   = NULL;
+         busy[s] = 0;
+         fhis[s] = fhi;
+         cis[s]  = ci;
+         idx[s]  = -1;
+
+         /* Skip intervals in the frozen region, and empty intervals */
+         if ( ((ci > 0) && (ci <= frozen)) || ((flo > fhi) && !(ci > 0)) )
+         {
+            continue;
+         }
+
+         /* Skip frozen coarse F-points (this sets the start vector) */
+         _braid_USkipFrozen(core, level, frozen, flo, fhi, &fstart, &us[s]);
+         if ( (fstart > fhi) && !(ci > 0) )
+         {
+            _braid_BaseFree(core, app,  us[s]);
+            us[s] = NULL;
+            continue;
+         }
+         idx[s] = (fstart <= fhi) ? fstart : ci;
+         nactive++;
+      }
+
+      while (nactive > 0)
+      {
+         /* Begin a step on every idle interval */
+         for (s = 0; s < nslots; s++)
+         {
+            if ( (idx[s] < 0) || busy[s] )
+            {
+               continue;
+            }
+            if (us[s] == NULL)
+            {
+               /* Don't wait on the left neighbor while other intervals have work */
+               if ( (idx[s]-1 == _braid_GridElt(grids[level], recv_index)) && (nactive > 1) )
+               {
+                  _braid_CommTest(core, _braid_GridElt(grids[level], recv_handle), &done);
+                  if (!done)
+                  {
+                     continue;
+                  }
+               }
+               _braid_UGetVector(core, level, idx[s]-1, &us[s]);
+            }
+            _braid_StepBegin(core, level, idx[s], NULL, us[s]);
+            busy[s] = 1;
+         }
+
+         /* Finish the steps that are done (all of them without a poll routine) */
+         for (s = 0; s < nslots; s++)
+         {
+            if (!busy[s])
+            {
+               continue;
+            }
+            _braid_StepPoll(core, level, idx[s], us[s], &done);
+            if (!done)
+            {
+               continue;
+            }
+            _braid_StepFinish(core, level, idx[s], us[s]);
+            busy[s] = 0;
+
+            if (idx[s] == cis[s])
+            {
+               /* C-relaxation, move the vector into storage */
+               _braid_USetVector(core, level, idx[s], us[s], 1);
+               idx[s] = -1;
+               nactive--;
+            }
+            else
+            {
+               /* F-relaxation */
+               _braid_USetVector(core, level, idx[s], us[s], 0);
+               if (idx[s] < fhis[s])
+               {
+                  idx[s]++;
+               }
+               else if (cis[s] > 0)
+               {
+                  idx[s] = cis[s];
+               }
+               else
+               {
+                  _braid_BaseFree(core, app,  us[s]);
+                  idx[s] = -1;
+                  nactive--;
+               }
+            }
+         }
+      }
+      _braid_UCommWait(core, level);
+   }
+
+   _braid_TFree(us);
+   _braid_TFree(idx);
+   _braid_TFree(fhis);
+   _braid_TFree(cis);
+   _braid_TFree(busy);
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * Do nu sweeps of F-then-C relaxation followed by one final F-relaxation
  *----------------------------------------------------------------------------*/
@@ -121,6 +283,11 @@ _braid_TriFCFRelax(braid_Core  core,
       nrelax  = nrels[level];
    }
 
+   if (_braid_CoreElt(core, trilinearize) != NULL)
+   {
+      _braid_TriNewtonUpdate(core, level);
+   }
+
    for (nu = 0; nu <= nrelax; nu++)
    {
       /* F-points */
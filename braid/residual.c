@@ -56,7 +56,7 @@ _braid_Residual(braid_Core        core,
    {
       /* By default: r = ustop - \Phi(ustart)*/
       _braid_GetUInit(core, level, index, r, &rstop);
-      _braid_BaseStep(core, app,  rstop, NULL, r, level, status);
+      _braid_DeltaStep(core, level, index, rstop, r);
       _braid_BaseSum(core, app,  1.0, ustop, -1.0, r);
       if (level == 0)
       {
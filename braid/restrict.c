@@ -24,6 +24,58 @@
 #include "_braid.h"
 #include "_util.h"
 
+/*----------------------------------------------------------------------------
+ * Evaluate the full residual between ustop at time point index and the state
+ * r at index-1, overwriting r with the residual, and add its spatial norm to
+ * the running temporal norm rnorm and to the interval norm inorm
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_FullRNormAdd(braid_Core         core,
+                    braid_Int          index,
+                    braid_BaseVector   ustop,
+                    braid_BaseVector   r,
+                    braid_Real        *rnorm,
+                    braid_Real        *inorm)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_StepStatus   status   = (braid_StepStatus)core;
+   braid_Real         tol      = _braid_CoreElt(core, tol);
+   braid_Int          iter     = _braid_CoreElt(core, niter);
+   braid_Int          ichunk   = _braid_CoreElt(core, ichunk);
+   braid_Int          nrefine  = _braid_CoreElt(core, nrefine);
+   braid_Int          gupper   = _braid_CoreElt(core, gupper);
+   braid_Int          tnorm    = _braid_CoreElt(core, tnorm);
+   braid_Real        *ta       = _braid_GridElt(grids[0], ta);
+   braid_Int          ilower   = _braid_GridElt(grids[0], ilower);
+
+   braid_Int          ii = index-ilower;
+   braid_Real         rnorm_temp;
+
+   _braid_StepStatusInit(ta[ii-1], ta[ii], index-1, ichunk, tol, iter, 0, nrefine, gupper, status);
+   _braid_BaseFullResidual(core, app, ustop, r, status);
+   _braid_BaseSpatialNorm(core, app,  r, &rnorm_temp);
+
+   if(tnorm == 1)       /* one-norm */
+   {
+      *rnorm += rnorm_temp;
+      *inorm += rnorm_temp;
+   }
+   else if(tnorm == 3)  /* inf-norm */
+   {
+      *rnorm = (((rnorm_temp) > (*rnorm)) ? (rnorm_temp) : (*rnorm));
+      *inorm = (((rnorm_temp) > (*inorm)) ? (rnorm_temp) : (*inorm));
+   }
+   else                 /* default two-norm */
+   {
+      *rnorm += (rnorm_temp*rnorm_temp);
+      *inorm += (rnorm_temp*rnorm_temp);
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * F-Relax on level and restrict to level+1
  *
@@ -63,6 +115,10 @@
  *
  * storage == 0 is the same as -1, except that storage also exists at fine-grid
  * F-points.
+ *
+ * On level 0, the full residual norm (braid_SetFullRNormRes) is computed in the
+ * same F-relaxation, from the states it already generates, rather than in a
+ * separate sweep.
  *----------------------------------------------------------------------------*/
 
 braid_Int
@@ -82,19 +138,24 @@ _braid_FRestrict(braid_Core   core,
    braid_Real           *tnorm_a      = _braid_CoreElt(core, tnorm_a);
    braid_Int             nrefine      = _braid_CoreElt(core, nrefine);
    braid_Int             gupper       = _braid_CoreElt(core, gupper);
+   braid_Int             delta_rank   = _braid_CoreElt(core, delta_rank);
    braid_Int             cfactor      = _braid_GridElt(grids[level], cfactor);
    braid_Int             ncpoints     = _braid_GridElt(grids[level], ncpoints);
    braid_Real           *ta           = _braid_GridElt(grids[level], ta);
    braid_Int             f_ilower     = _braid_GridElt(grids[level], ilower);
+   braid_PtFcnResidual   fullres      = _braid_CoreElt(core, full_rnorm_res);
+   braid_Int             full_freq    = _braid_CoreElt(core, full_rnorm_freq);
+   braid_Real           *full_tnorm_a = _braid_CoreElt(core, full_tnorm_a);
    _braid_CommHandle    *recv_handle  = NULL;
    _braid_CommHandle    *send_handle  = NULL;
 
    braid_Int            c_level, c_ilower, c_iupper, c_index, c_i, c_ii;
    braid_BaseVector     c_u, *c_va, *c_fa;
 
-   braid_BaseVector     u, r;
-   braid_Int            interval, flo, fhi, fi, ci;
+   braid_BaseVector     u, r, fr;
+   braid_Int            interval, flo, fhi, fi, ci, frozen, c_frozen, full, fstart;
    braid_Real           rnorm, grnorm, rnorm_temp, rnm;
+   braid_Real           full_rnorm, full_inorm;
 
    c_level  = level+1;
    c_ilower = _braid_GridElt(grids[c_level], ilower);
@@ -103,6 +164,20 @@ _braid_FRestrict(braid_Core   core,
    c_fa     = _braid_GridElt(grids[c_level], fa);
 
    rnorm = 0.0;
+   _braid_GetFrozenIndex(core, level, &frozen);
+   _braid_GetFrozenIndex(core, c_level, &c_frozen);
+
+   /* Accumulate the full residual norm in this sweep, if it is due.  With a
+    * frozen region it is always due, so that full_tnorm_a is current for the
+    * intervals that freeze. */
+   full       = 0;
+   full_rnorm = 0.0;
+   if ( (level == 0) && (fullres != NULL) )
+   {
+      full = ( (iter % full_freq) == 0 ) ||
+             ( _braid_CoreElt(core, full_rnorm0) == braid_INVALID_RNORM ) ||
+             ( _braid_CoreElt(core, frozen_tol) > 0.0 );
+   }
 
    _braid_UCommInit(core, level);
 
@@ -115,20 +190,47 @@ _braid_FRestrict(braid_Core   core,
    {
       _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
 
-      if (flo <= fhi)
+      /* In the frozen region nothing changes, so only restrict u and leave
+       * c_fa empty (the coarse grid skips these points too).  On level 0, the
+       * residual norm of the region is added from frozen_rnorm below. */
+      if ((ci > 0) && (ci <= frozen))
       {
-         _braid_UGetVector(core, level, flo-1, &r);
+         _braid_UGetVectorRef(core, level, ci, &u);
+         _braid_MapFineToCoarse(ci, cfactor, c_index);
+         _braid_Coarsen(core, c_level, ci, c_index, u, &c_va[c_index-c_ilower]);
+         continue;
       }
-      else if (ci > 0)
+
+      /* Skip frozen coarse F-points */
+      _braid_USkipFrozen(core, level, frozen, flo, fhi, &fstart, &r);
+      if (r == NULL)
       {
-         _braid_UGetVector(core, level, ci-1, &r);
+         if (flo <= fhi)
+         {
+            _braid_UGetVector(core, level, flo-1, &r);
+         }
+         else if (ci > 0)
+         {
+            _braid_UGetVector(core, level, ci-1, &r);
+         }
       }
 
       /* F-relaxation */
       _braid_GetRNorm(core, -1, &rnm);
-      for (fi = flo; fi <= fhi; fi++)
+      full_inorm = 0.0;
+      for (fi = fstart; fi <= fhi; fi++)
       {
+         if (full)
+         {
+            _braid_BaseClone(core, app,  r, &fr);
+         }
          _braid_Step(core, level, fi, NULL, r);
+         if (full)
+         {
+            /* Full residual at this F-point, from the state just computed */
+            _braid_FullRNormAdd(core, fi, r, fr, &full_rnorm, &full_inorm);
+            _braid_BaseFree(core, app,  fr);
+         }
          _braid_USetVector(core, level, fi, r, 0);
          
          /* Allow user to process current vector, note that r here is
@@ -170,8 +272,17 @@ _braid_FRestrict(braid_Core   core,
       /* Compute residual and restrict */
       if (ci > 0)
       {
-         /* Compute FAS residual */
          _braid_UGetVectorRef(core, level, ci, &u);
+
+         /* Full residual at this C-point (r is still the state at ci-1) */
+         if (full)
+         {
+            _braid_BaseClone(core, app,  r, &fr);
+            _braid_FullRNormAdd(core, ci, u, fr, &full_rnorm, &full_inorm);
+            _braid_BaseFree(core, app,  fr);
+         }
+
+         /* Compute FAS residual */
          _braid_FASResidual(core, level, ci, u, r);
 
          /* Compute rnorm (only on level 0) */
@@ -205,6 +316,10 @@ _braid_FRestrict(braid_Core   core,
       {
          _braid_BaseFree(core, app,  r);
       }
+      if (full)
+      {
+         full_tnorm_a[interval] = full_inorm;
+      }
    }
    _braid_UCommWait(core, level);
 
@@ -215,26 +330,52 @@ _braid_FRestrict(braid_Core   core,
       _braid_PrintSpatialNorms(core, tnorm_a, ncpoints);
    }
 
-   /* Compute rnorm (only on level 0) */
+   /* Compute rnorm (only on level 0), including the frozen region */
    if (level == 0)
    {
       if(tnorm == 1)          /* one-norm reduction */
       {  
          MPI_Allreduce(&rnorm, &grnorm, 1, braid_MPI_REAL, MPI_SUM, comm);
+         grnorm += _braid_CoreElt(core, frozen_rnorm);
       }
       else if(tnorm == 3)     /* inf-norm reduction */
       {  
          _braid_Max(tnorm_a, ncpoints, &rnorm); 
          MPI_Allreduce(&rnorm, &grnorm, 1, braid_MPI_REAL, MPI_MAX, comm);
+         grnorm = _braid_max(grnorm, _braid_CoreElt(core, frozen_rnorm));
       }
       else                    /* default two-norm reduction */
       {  
          MPI_Allreduce(&rnorm, &grnorm, 1, braid_MPI_REAL, MPI_SUM, comm);
-         grnorm = sqrt(grnorm);
+         grnorm = sqrt(grnorm + _braid_CoreElt(core, frozen_rnorm));
       }
 
       /* Store new rnorm */
       _braid_SetRNorm(core, -1, grnorm);
+
+      /* Full residual norm reduction */
+      if (full)
+      {
+         if(tnorm == 3)       /* inf-norm reduction */
+         {
+            MPI_Allreduce(&full_rnorm, &grnorm, 1, braid_MPI_REAL, MPI_MAX, comm);
+            grnorm = _braid_max(grnorm, _braid_CoreElt(core, frozen_full_rnorm));
+         }
+         else if(tnorm == 1)  /* one-norm reduction */
+         {
+            MPI_Allreduce(&full_rnorm, &grnorm, 1, braid_MPI_REAL, MPI_SUM, comm);
+            grnorm += _braid_CoreElt(core, frozen_full_rnorm);
+         }
+         else                 /* default two-norm reduction */
+         {
+            MPI_Allreduce(&full_rnorm, &grnorm, 1, braid_MPI_REAL, MPI_SUM, comm);
+            grnorm = sqrt(grnorm + _braid_CoreElt(core, frozen_full_rnorm));
+         }
+         _braid_SetFullRNorm(core, -1, grnorm);
+      }
+
+      /* Grow the frozen region, if requested */
+      _braid_UpdateFrozenIndex(core);
    }
    
    /* Now apply coarse residual to update fa values */
@@ -262,6 +403,16 @@ _braid_FRestrict(braid_Core   core,
             /* Finalize update of c_va[-1] */
             _braid_CommWait(core, &recv_handle);
          }
+         if (c_i <= c_frozen)
+         {
+            /* Frozen region, the coarse grid does not step here */
+            continue;
+         }
+         if (delta_rank > 0)
+         {
+            /* Build the Delta correction for this coarse step (once) */
+            _braid_DeltaBuild(core, c_level, c_i);
+         }
          _braid_BaseClone(core, app,  c_va[c_ii-1], &c_u);
          _braid_Residual(core, c_level, c_i, c_va[c_ii], c_u);
          _braid_BaseSum(core, app,  1.0, c_u, 1.0, c_fa[c_ii]);
@@ -48,19 +48,46 @@ _braid_Coarsen(braid_Core        core,
 
    braid_Int      c_ii = c_index-c_ilower;
    braid_Int      f_ii = f_index-f_ilower;
+   braid_Int      f_low = _braid_IsLowPrec(core, level-1);
+   braid_Int      c_low = _braid_IsLowPrec(core, level);
+
+   braid_BaseVector  hvector;
    
    if ( _braid_CoreElt(core, scoarsen) == NULL )
    {
-      /* No spatial coarsening needed, just clone the fine vector.*/
-      _braid_BaseClone(core, app,  fvector, cvector);
+      if (c_low && !f_low)
+      {
+         /* Convert to the coarse-level precision instead of cloning */
+         _braid_BaseConvertPrec(core, app, fvector, 1, cvector);
+      }
+      else
+      {
+         /* No spatial coarsening needed, just clone the fine vector.*/
+         _braid_BaseClone(core, app,  fvector, cvector);
+      }
    }
    else
    {
-      /* Call the user's coarsening routine */
+      /* Call the user's coarsening routine, always in the fine-level precision */
+      hvector = fvector;
+      if (f_low)
+      {
+         _braid_BaseConvertPrec(core, app, fvector, 0, &hvector);
+      }
       _braid_CoarsenRefStatusInit(f_ta[f_ii], f_ta[f_ii-1], f_ta[f_ii+1], 
                                   c_ta[c_ii-1], c_ta[c_ii+1],
                                   level-1, nrefine, gupper, c_index, cstatus);
-      _braid_BaseSCoarsen(core, app, fvector, cvector, cstatus);
+      _braid_BaseSCoarsen(core, app, hvector, cvector, cstatus);
+      if (f_low)
+      {
+         _braid_BaseFree(core, app, hvector);
+      }
+      if (c_low)
+      {
+         hvector = *cvector;
+         _braid_BaseConvertPrec(core, app, hvector, 1, cvector);
+         _braid_BaseFree(core, app, hvector);
+      }
    }
    return _braid_error_flag;
 }
@@ -82,18 +109,45 @@ _braid_RefineBasic(braid_Core        core,
    braid_CoarsenRefStatus cstatus = (braid_CoarsenRefStatus)core;
    braid_Int              nrefine = _braid_CoreElt(core, nrefine);
    braid_Int              gupper  = _braid_CoreElt(core, gupper);
+   braid_Int              f_low   = _braid_IsLowPrec(core, level);
+   braid_Int              c_low   = _braid_IsLowPrec(core, level+1);
+
+   braid_BaseVector       hvector;
 
    if ( _braid_CoreElt(core, scoarsen) == NULL )
    {
-      /* No spatial refinement needed, just clone the fine vector.*/
-      _braid_BaseClone(core, app,  cvector, fvector);
+      if (c_low && !f_low)
+      {
+         /* Convert back to the fine-level precision instead of cloning */
+         _braid_BaseConvertPrec(core, app, cvector, 0, fvector);
+      }
+      else
+      {
+         /* No spatial refinement needed, just clone the fine vector.*/
+         _braid_BaseClone(core, app,  cvector, fvector);
+      }
    }
    else
    {
-      /* Call the user's refinement routine */
+      /* Call the user's refinement routine, always in the fine-level precision */
+      hvector = cvector;
+      if (c_low)
+      {
+         _braid_BaseConvertPrec(core, app, cvector, 0, &hvector);
+      }
       _braid_CoarsenRefStatusInit(f_ta[0], f_ta[-1], f_ta[+1], c_ta[-1], c_ta[+1],
                                   level, nrefine, gupper, c_index, cstatus);
-      _braid_BaseSRefine(core,  app, cvector, fvector, cstatus);
+      _braid_BaseSRefine(core,  app, hvector, fvector, cstatus);
+      if (c_low)
+      {
+         _braid_BaseFree(core, app, hvector);
+      }
+      if (f_low)
+      {
+         hvector = *fvector;
+         _braid_BaseConvertPrec(core, app, hvector, 1, fvector);
+         _braid_BaseFree(core, app, hvector);
+      }
    }
 
    return _braid_error_flag;
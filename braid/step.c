@@ -70,7 +70,7 @@ _braid_Step(braid_Core         core,
    {
       if ( _braid_CoreElt(core, residual) == NULL )
       {
-         _braid_BaseStep(core, app,  ustop, NULL, u, level, status);
+         _braid_DeltaStep(core, level, index, ustop, u);
          if(fa[ii] != NULL)
          {
             _braid_BaseSum(core, app,  1.0, fa[ii], 1.0, u);
@@ -85,6 +85,133 @@ _braid_Step(braid_Core         core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Begin one asynchronous time step
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_StepBegin(braid_Core         core,
+                 braid_Int          level,
+                 braid_Int          index,
+                 braid_BaseVector   ustop,
+                 braid_BaseVector   u)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   braid_Real         tol      = _braid_CoreElt(core, tol);
+   braid_Int          iter     = _braid_CoreElt(core, niter);
+   braid_Int          ichunk   = _braid_CoreElt(core, ichunk);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_StepStatus   status   = (braid_StepStatus)core;
+   braid_Int          nrefine  = _braid_CoreElt(core, nrefine);
+   braid_Int          gupper   = _braid_CoreElt(core, gupper);
+   braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
+   braid_Real        *ta       = _braid_GridElt(grids[level], ta);
+   braid_BaseVector  *fa       = _braid_GridElt(grids[level], fa);
+
+   braid_Int        ii;
+
+   ii = index-ilower;
+   _braid_StepStatusInit(ta[ii-1], ta[ii], index-1, ichunk, tol, iter, level, nrefine, gupper, status);
+
+   /* If ustop is set to NULL, use a default approach for setting it */
+   if (ustop == NULL)
+   {
+      _braid_GetUInit(core, level, index, u, &ustop);
+   }
+
+   /* Without a user residual, the FAS rhs is added in _braid_StepFinish() */
+   if ( (level == 0) || (_braid_CoreElt(core, residual) == NULL) )
+   {
+      _braid_BaseStepBegin(core, app, ustop, NULL, u, status);
+   }
+   else
+   {
+      _braid_BaseStepBegin(core, app, ustop, fa[ii], u, status);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Test one asynchronous time step for completion
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_StepPoll(braid_Core         core,
+                braid_Int          level,
+                braid_Int          index,
+                braid_BaseVector   u,
+                braid_Int         *done_ptr)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   braid_Real         tol      = _braid_CoreElt(core, tol);
+   braid_Int          iter     = _braid_CoreElt(core, niter);
+   braid_Int          ichunk   = _braid_CoreElt(core, ichunk);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_StepStatus   status   = (braid_StepStatus)core;
+   braid_Int          nrefine  = _braid_CoreElt(core, nrefine);
+   braid_Int          gupper   = _braid_CoreElt(core, gupper);
+   braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
+   braid_Real        *ta       = _braid_GridElt(grids[level], ta);
+
+   braid_Int        ii;
+
+   if (_braid_CoreElt(core, step_poll) == NULL)
+   {
+      *done_ptr = 1;
+      return _braid_error_flag;
+   }
+
+   ii = index-ilower;
+   _braid_StepStatusInit(ta[ii-1], ta[ii], index-1, ichunk, tol, iter, level, nrefine, gupper, status);
+   _braid_BaseStepPoll(core, app, u, status, done_ptr);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Complete one asynchronous time step
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_StepFinish(braid_Core         core,
+                  braid_Int          level,
+                  braid_Int          index,
+                  braid_BaseVector   u)
+{
+   braid_App          app      = _braid_CoreElt(core, app);
+   braid_Real         tol      = _braid_CoreElt(core, tol);
+   braid_Int          iter     = _braid_CoreElt(core, niter);
+   braid_Int          ichunk   = _braid_CoreElt(core, ichunk);
+   braid_Int         *rfactors = _braid_CoreElt(core, rfactors);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_StepStatus   status   = (braid_StepStatus)core;
+   braid_Int          nrefine  = _braid_CoreElt(core, nrefine);
+   braid_Int          gupper   = _braid_CoreElt(core, gupper);
+   braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
+   braid_Real        *ta       = _braid_GridElt(grids[level], ta);
+   braid_BaseVector  *fa       = _braid_GridElt(grids[level], fa);
+
+   braid_Int        ii;
+
+   ii = index-ilower;
+   _braid_StepStatusInit(ta[ii-1], ta[ii], index-1, ichunk, tol, iter, level, nrefine, gupper, status);
+   _braid_BaseStepFinish(core, app, u, status);
+
+   if (level == 0)
+   {
+      rfactors[ii] = _braid_StatusElt(status, rfactor);
+      if ( !_braid_CoreElt(core, r_space) && _braid_StatusElt(status, r_space) )
+            _braid_CoreElt(core, r_space) = 1;
+   }
+   else if ( (_braid_CoreElt(core, residual) == NULL) && (fa[ii] != NULL) )
+   {
+      _braid_BaseSum(core, app,  1.0, fa[ii], 1.0, u);
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * Get an initial guess for ustop to use in the step routine (implicit schemes)
  * This vector may just be a shell. User should be able to deal with it
@@ -157,6 +284,9 @@ _braid_TriSolve(braid_Core  core,
    braid_BaseVector  *fa       = _braid_GridElt(grids[level], fa);
 
    braid_BaseVector   u, uleft, uright;
+   void             **la;
+   braid_Int         *la_epoch;
+   braid_Int          lin_epoch;
 
    braid_Int          ii = index-ilower, homogeneous = 0;
 
@@ -178,6 +308,22 @@ _braid_TriSolve(braid_Core  core,
       homogeneous = 1;
    }
 
+   /* Newton-TriMGRIT: linearize first if this point is not in the current
+    * epoch, or in every solve before the start iteration */
+   if (_braid_CoreElt(core, trilinearize) != NULL)
+   {
+      la        = _braid_GridElt(grids[level], la);
+      la_epoch  = _braid_GridElt(grids[level], la_epoch);
+      lin_epoch = _braid_GridElt(grids[level], lin_epoch);
+      if ( (la_epoch[ii] != lin_epoch) ||
+           (_braid_CoreElt(core, niter) < _braid_CoreElt(core, newton_start)) )
+      {
+         _braid_BaseTriLinearize(core, app, uleft, uright, u, status, &la[ii]);
+         la_epoch[ii] = lin_epoch;
+      }
+      _braid_CoreElt(core, tri_lin) = la[ii];
+   }
+
    if (level == 0)
    {
       /* No FAS rhs */
@@ -187,9 +333,41 @@ _braid_TriSolve(braid_Core  core,
    {
       _braid_BaseTriSolve(core, app, uleft, uright, fa[ii], u, homogeneous, status);
    }
+   _braid_CoreElt(core, tri_lin) = NULL;
 
    _braid_USetVectorRef(core, level, index, u);
 
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Start a new linearization epoch on grid 'level' if the current one expired
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_TriNewtonUpdate(braid_Core  core,
+                       braid_Int   level)
+{
+   braid_Int          iter     = _braid_CoreElt(core, niter);
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
+   braid_Int          iupper   = _braid_GridElt(grids[level], iupper);
+   braid_Int          lin_iter = _braid_GridElt(grids[level], lin_iter);
+   braid_Int          lag;
+
+   if (_braid_GridElt(grids[level], la) == NULL)
+   {
+      _braid_GridElt(grids[level], la)       = _braid_CTAlloc(void *, iupper-ilower+1);
+      _braid_GridElt(grids[level], la_epoch) = _braid_CTAlloc(braid_Int, iupper-ilower+1);
+   }
+
+   lag = (level == 0) ? _braid_CoreElt(core, newton_lag) : _braid_CoreElt(core, newton_clag);
+   if ( (_braid_GridElt(grids[level], lin_epoch) == 0) || (iter - lin_iter >= lag) )
+   {
+      _braid_GridElt(grids[level], lin_epoch) ++;
+      _braid_GridElt(grids[level], lin_iter) = iter;
+   }
+
+   return _braid_error_flag;
+}
+
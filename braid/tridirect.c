@@ -0,0 +1,672 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory. Written by
+ * Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+ * Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+#include <math.h>
+#include <float.h>
+#include "_braid.h"
+#include "_util.h"
+
+/* Direct solver for an affine TriMGRIT level.  With the residual r_i(u) =
+ * A_i(u) - f_i at the current iterate u, it solves
+ *
+ *    L_i e_{i-1} + D_i e_i + U_i e_{i+1} = -r_i(u)
+ *
+ * for the correction e, where the N x N blocks are probed with TriResidual
+ * on unit vectors added to u.  For an affine TriResidual this gives the exact
+ * solution u + e.  With Newton-TriMGRIT, the probes are scaled to a finite
+ * difference step, so the blocks approximate the Jacobian at u, and they are
+ * probed again with each new linearization epoch.  The vectors are moved in
+ * and out of dense arrays with BufPack/BufUnpack, so they must pack as N
+ * braid_Reals.
+ *
+ * Each process factors its rows with block Thomas.  The rows of its first
+ * and last point, written in terms of the neighboring interface points, form a
+ * reduced block tridiagonal system (blocks of size 2N, one per process) that
+ * is solved on process 0.  Each process then solves its rows again with the
+ * interface values moved to the rhs.  Dense matrices are stored row-major. */
+
+/*----------------------------------------------------------------------------
+ * LU factorization of the n x n matrix A in place, with partial pivoting
+ *----------------------------------------------------------------------------*/
+
+static void
+_braid_DenseLU(braid_Int    n,
+               braid_Real  *A,
+               braid_Int   *piv)
+{
+   braid_Int   i, j, k, p;
+   braid_Real  tmp;
+
+   for (k = 0; k < n; k++)
+   {
+      p = k;
+      for (i = k+1; i < n; i++)
+      {
+         if (fabs(A[i*n+k]) > fabs(A[p*n+k]))
+         {
+            p = i;
+         }
+      }
+      piv[k] = p;
+      if (p != k)
+      {
+         for (j = 0; j < n; j++)
+         {
+            tmp = A[k*n+j]; A[k*n+j] = A[p*n+j]; A[p*n+j] = tmp;
+         }
+      }
+      for (i = k+1; i < n; i++)
+      {
+         A[i*n+k] /= A[k*n+k];
+         for (j = k+1; j < n; j++)
+         {
+            A[i*n+j] -= A[i*n+k]*A[k*n+j];
+         }
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Overwrite the n x m matrix B with A^{-1} B, where A holds an LU factorization
+ *----------------------------------------------------------------------------*/
+
+static void
+_braid_DenseLUSolve(braid_Int    n,
+                    braid_Real  *A,
+                    braid_Int   *piv,
+                    braid_Real  *B,
+                    braid_Int    m)
+{
+   braid_Int   i, j, k;
+   braid_Real  tmp;
+
+   for (k = 0; k < n; k++)
+   {
+      if (piv[k] != k)
+      {
+         for (j = 0; j < m; j++)
+         {
+            tmp = B[k*m+j]; B[k*m+j] = B[piv[k]*m+j]; B[piv[k]*m+j] = tmp;
+         }
+      }
+      for (i = k+1; i < n; i++)
+      {
+         for (j = 0; j < m; j++)
+         {
+            B[i*m+j] -= A[i*n+k]*B[k*m+j];
+         }
+      }
+   }
+   for (k = n-1; k >= 0; k--)
+   {
+      for (j = 0; j < m; j++)
+      {
+         B[k*m+j] /= A[k*n+k];
+      }
+      for (i = 0; i < k; i++)
+      {
+         for (j = 0; j < m; j++)
+         {
+            B[i*m+j] -= A[i*n+k]*B[k*m+j];
+         }
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * C = C - A B, with A n x n and B, C n x m
+ *----------------------------------------------------------------------------*/
+
+static void
+_braid_DenseSubMult(braid_Int    n,
+                    braid_Real  *A,
+                    braid_Real  *B,
+                    braid_Real  *C,
+                    braid_Int    m)
+{
+   braid_Int  i, j, k;
+
+   for (i = 0; i < n; i++)
+   {
+      for (k = 0; k < n; k++)
+      {
+         if (A[i*n+k] != 0.0)
+         {
+            for (j = 0; j < m; j++)
+            {
+               C[i*m+j] -= A[i*n+k]*B[k*m+j];
+            }
+         }
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Block Thomas factorization of the nb x nb block tridiagonal matrix with n x n
+ * blocks L (lower), D (diagonal) and U (upper).  D is overwritten with the LU
+ * factors of the eliminated diagonal blocks and U with D^{-1} U.  The first
+ * block of L and the last block of U are not used.
+ *----------------------------------------------------------------------------*/
+
+static void
+_braid_BlockThomasFactor(braid_Int    nb,
+                         braid_Int    n,
+                         braid_Real  *L,
+                         braid_Real  *D,
+                         braid_Real  *U,
+                         braid_Int   *piv)
+{
+   braid_Int  i, nn = n*n;
+
+   for (i = 0; i < nb; i++)
+   {
+      if (i > 0)
+      {
+         _braid_DenseSubMult(n, &L[i*nn], &U[(i-1)*nn], &D[i*nn], n);
+      }
+      _braid_DenseLU(n, &D[i*nn], &piv[i*n]);
+      if (i < nb-1)
+      {
+         _braid_DenseLUSolve(n, &D[i*nn], &piv[i*n], &U[i*nn], n);
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Overwrite B (nb blocks of n x m) with the solution of the block tridiagonal
+ * system factored by _braid_BlockThomasFactor()
+ *----------------------------------------------------------------------------*/
+
+static void
+_braid_BlockThomasSolve(braid_Int    nb,
+                        braid_Int    n,
+                        braid_Real  *L,
+                        braid_Real  *D,
+                        braid_Real  *U,
+                        braid_Int   *piv,
+                        braid_Real  *B,
+                        braid_Int    m)
+{
+   braid_Int  i, nn = n*n, nm = n*m;
+
+   for (i = 0; i < nb; i++)
+   {
+      if (i > 0)
+      {
+         _braid_DenseSubMult(n, &L[i*nn], &B[(i-1)*nm], &B[i*nm], m);
+      }
+      _braid_DenseLUSolve(n, &D[i*nn], &piv[i*n], &B[i*nm], m);
+   }
+   for (i = nb-2; i >= 0; i--)
+   {
+      _braid_DenseSubMult(n, &U[i*nn], &B[(i+1)*nm], &B[i*nm], m);
+   }
+}
+
+/*----------------------------------------------------------------------------
+ * Evaluate TriResidual (without the rhs) at time step 'index' on grid 'level'
+ * for the vectors uleft, uright and v, and return it in the array r.  The
+ * vector v is overwritten and freed.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_TriDirectResidual(braid_Core         core,
+                         braid_Int          level,
+                         braid_Int          index,
+                         braid_BaseVector   uleft,
+                         braid_BaseVector   uright,
+                         braid_BaseVector   v,
+                         braid_Real        *r)
+{
+   braid_App           app      = _braid_CoreElt(core, app);
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   braid_TriStatus     status   = (braid_TriStatus)core;
+   braid_BufferStatus  bstatus  = (braid_BufferStatus)core;
+   braid_Int           ilower   = _braid_GridElt(grids[level], ilower);
+   braid_Real         *ta       = _braid_GridElt(grids[level], ta);
+
+   braid_Int           ii = index-ilower, size;
+
+   _braid_StatusElt(status, t)     = ta[ii];
+   _braid_StatusElt(status, tprev) = ta[ii-1];
+   _braid_StatusElt(status, tnext) = ta[ii+1];
+   _braid_StatusElt(status, idx)   = index;
+   _braid_StatusElt(status, level) = level;
+
+   /* The blocks are differences from here, so the rhs can be left out */
+   _braid_BaseTriResidual(core, app, uleft, uright, NULL, v, (level > 0), status);
+
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_BaseBufSize(core, app, &size, bstatus);
+   _braid_StatusElt(bstatus, size_buffer) = size;
+   _braid_BaseBufPack(core, app, v, r, bstatus);
+   _braid_BaseFree(core, app, v);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Probe and factor the block rows of grid 'level' at the current iterate, and
+ * factor the reduced system.  The ghost points of u must be current.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_TriDirectSetup(braid_Core  core,
+                      braid_Int   level)
+{
+   MPI_Comm            comm     = _braid_CoreElt(core, comm);
+   braid_App           app      = _braid_CoreElt(core, app);
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   braid_BufferStatus  bstatus  = (braid_BufferStatus)core;
+   braid_Int           ilower   = _braid_GridElt(grids[level], ilower);
+   braid_Int           iupper   = _braid_GridElt(grids[level], iupper);
+   braid_Int           gupper   = _braid_GridElt(grids[level], gupper);
+
+   _braid_TriDirect   *td;
+   braid_BaseVector    uleft, uright, u, v, e, up;
+   braid_Real         *buf, *c, *r, *S, *sbuf, *rbuf;
+   braid_Int          *npts;
+   braid_Real          h, unorm;
+   braid_Int           myid, nprocs, size, N, NN, n, i, j, k, p, q, Q;
+
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &nprocs);
+
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_BaseBufSize(core, app, &size, bstatus);
+   if ( (size % sizeof(braid_Real)) != 0 )
+   {
+      _braid_printf("\nThe direct TriMGRIT solve needs vectors packed as braid_Reals!\n");
+      exit(1);
+   }
+
+   td = _braid_CTAlloc(_braid_TriDirect, 1);
+   N  = size / sizeof(braid_Real);
+   NN = N*N;
+   n  = _braid_max(iupper-ilower+1, 0);
+   _braid_TriDirectElt(td, nblock)    = N;
+   _braid_TriDirectElt(td, npoints)   = n;
+   _braid_TriDirectElt(td, lin_epoch) = _braid_GridElt(grids[level], lin_epoch);
+
+   /* Find the processes with points, and the neighbors of this one */
+   npts = _braid_CTAlloc(braid_Int, nprocs);
+   MPI_Allgather(&n, 1, braid_MPI_INT, npts, 1, braid_MPI_INT, comm);
+   _braid_TriDirectElt(td, left)  = -1;
+   _braid_TriDirectElt(td, right) = -1;
+   for (p = myid-1; (p >= 0) && (npts[p] == 0); p--);
+   if ((n > 0) && (p >= 0))
+   {
+      _braid_TriDirectElt(td, left) = p;
+   }
+   for (p = myid+1; (p < nprocs) && (npts[p] == 0); p++);
+   if ((n > 0) && (p < nprocs))
+   {
+      _braid_TriDirectElt(td, right) = p;
+   }
+
+   sbuf = _braid_CTAlloc(braid_Real, 4*NN);
+   if (n > 0)
+   {
+      braid_Real  *L   = _braid_CTAlloc(braid_Real, n*NN);
+      braid_Real  *D   = _braid_CTAlloc(braid_Real, n*NN);
+      braid_Real  *U   = _braid_CTAlloc(braid_Real, n*NN);
+      braid_Int   *piv = _braid_CTAlloc(braid_Int, n*N);
+
+      /* Probe the blocks column by column, adding unit vectors to u */
+      buf = _braid_CTAlloc(braid_Real, N);
+      c   = _braid_CTAlloc(braid_Real, N);
+      r   = _braid_CTAlloc(braid_Real, N);
+      for (i = 0; i < n; i++)
+      {
+         _braid_UGetVectorRef(core, level, ilower+i-1, &uleft);
+         _braid_UGetVectorRef(core, level, ilower+i+1, &uright);
+         _braid_UGetVectorRef(core, level, ilower+i, &u);
+         _braid_BaseClone(core, app, u, &v);
+         _braid_TriDirectResidual(core, level, ilower+i, uleft, uright, v, c);
+
+         /* Unit probes are exact for an affine TriResidual.  With Newton-TriMGRIT
+          * the problem is nonlinear, so take a finite difference step. */
+         h = 1.0;
+         if (_braid_CoreElt(core, trilinearize) != NULL)
+         {
+            _braid_BaseSpatialNorm(core, app, u, &unorm);
+            h = sqrt(DBL_EPSILON) * _braid_max(unorm, 1.0);
+         }
+         for (j = 0; j < N; j++)
+         {
+            buf[j] = h;
+            _braid_BufferStatusInit(0, 0, bstatus);
+            _braid_BaseBufUnpack(core, app, buf, &e, bstatus);
+            buf[j] = 0.0;
+
+            if (ilower+i > 0)
+            {
+               _braid_BaseClone(core, app, uleft, &up);
+               _braid_BaseSum(core, app, 1.0, e, 1.0, up);
+               _braid_BaseClone(core, app, u, &v);
+               _braid_TriDirectResidual(core, level, ilower+i, up, uright, v, r);
+               _braid_BaseFree(core, app, up);
+               for (k = 0; k < N; k++)
+               {
+                  L[i*NN + k*N+j] = (r[k] - c[k]) / h;
+               }
+            }
+            _braid_BaseClone(core, app, u, &v);
+            _braid_BaseSum(core, app, 1.0, e, 1.0, v);
+            _braid_TriDirectResidual(core, level, ilower+i, uleft, uright, v, r);
+            for (k = 0; k < N; k++)
+            {
+               D[i*NN + k*N+j] = (r[k] - c[k]) / h;
+            }
+            if (ilower+i < gupper)
+            {
+               _braid_BaseClone(core, app, uright, &up);
+               _braid_BaseSum(core, app, 1.0, e, 1.0, up);
+               _braid_BaseClone(core, app, u, &v);
+               _braid_TriDirectResidual(core, level, ilower+i, uleft, up, v, r);
+               _braid_BaseFree(core, app, up);
+               for (k = 0; k < N; k++)
+               {
+                  U[i*NN + k*N+j] = (r[k] - c[k]) / h;
+               }
+            }
+            _braid_BaseFree(core, app, e);
+         }
+      }
+      _braid_TFree(buf);
+      _braid_TFree(c);
+      _braid_TFree(r);
+      /* Keep the coupling to the right neighbor before U is overwritten */
+      _braid_TriDirectElt(td, ulast) = _braid_CTAlloc(braid_Real, NN);
+      for (k = 0; k < NN; k++)
+      {
+         _braid_TriDirectElt(td, ulast)[k] = U[(n-1)*NN + k];
+      }
+      _braid_BlockThomasFactor(n, N, L, D, U, piv);
+
+      /* Couplings of the first and last rows to the interface points: solve
+       * with rhs [L_0 e_first, U_{n-1} e_last], then send the rows
+       * [V_first W_first; V_last W_last] of the solution to process 0 */
+      S = _braid_CTAlloc(braid_Real, n*2*NN);
+      for (k = 0; k < N; k++)
+      {
+         for (j = 0; j < N; j++)
+         {
+            S[k*2*N + j]                = L[k*N+j];
+            S[(n-1)*2*NN + k*2*N + N+j] = _braid_TriDirectElt(td, ulast)[k*N+j];
+         }
+      }
+      _braid_BlockThomasSolve(n, N, L, D, U, piv, S, 2*N);
+      for (k = 0; k < N; k++)
+      {
+         for (j = 0; j < 2*N; j++)
+         {
+            sbuf[k*2*N + j]     = S[k*2*N + j];
+            sbuf[(N+k)*2*N + j] = S[(n-1)*2*NN + k*2*N + j];
+         }
+      }
+      _braid_TFree(S);
+
+      _braid_TriDirectElt(td, L)   = L;
+      _braid_TriDirectElt(td, D)   = D;
+      _braid_TriDirectElt(td, U)   = U;
+      _braid_TriDirectElt(td, piv) = piv;
+      _braid_TriDirectElt(td, b)   = _braid_CTAlloc(braid_Real, n*N);
+   }
+
+   rbuf = NULL;
+   if (myid == 0)
+   {
+      rbuf = _braid_CTAlloc(braid_Real, nprocs*4*NN);
+   }
+   MPI_Gather(sbuf, 4*NN, braid_MPI_REAL, rbuf, 4*NN, braid_MPI_REAL, 0, comm);
+   _braid_TFree(sbuf);
+
+   /* Assemble and factor the reduced system on process 0, with the unknowns
+    * [u_first; u_last] of each process that has points */
+   if (myid == 0)
+   {
+      braid_Real  *RL, *RD, *RU;
+      braid_Int   *rprocs, M = 2*N, MM = 4*NN;
+
+      Q = 0;
+      rprocs = _braid_CTAlloc(braid_Int, nprocs);
+      for (p = 0; p < nprocs; p++)
+      {
+         if (npts[p] > 0)
+         {
+            rprocs[Q++] = p;
+         }
+      }
+      RL = _braid_CTAlloc(braid_Real, Q*MM);
+      RD = _braid_CTAlloc(braid_Real, Q*MM);
+      RU = _braid_CTAlloc(braid_Real, Q*MM);
+      for (q = 0; q < Q; q++)
+      {
+         for (k = 0; k < M; k++)
+         {
+            RD[q*MM + k*M+k] = 1.0;
+            for (j = 0; j < N; j++)
+            {
+               /* The left coupling acts on u_last, the right one on u_first */
+               RL[q*MM + k*M + N+j] = rbuf[rprocs[q]*MM + k*M + j];
+               RU[q*MM + k*M + j]   = rbuf[rprocs[q]*MM + k*M + N+j];
+            }
+         }
+      }
+      _braid_TriDirectElt(td, rpiv) = _braid_CTAlloc(braid_Int, Q*M);
+      _braid_BlockThomasFactor(Q, M, RL, RD, RU, _braid_TriDirectElt(td, rpiv));
+
+      _braid_TriDirectElt(td, nreduced) = Q;
+      _braid_TriDirectElt(td, rprocs)   = rprocs;
+      _braid_TriDirectElt(td, RL)       = RL;
+      _braid_TriDirectElt(td, RD)       = RD;
+      _braid_TriDirectElt(td, RU)       = RU;
+      _braid_TFree(rbuf);
+   }
+   _braid_TFree(npts);
+
+   /* Interface values of all processes, [u_first; u_last] each */
+   _braid_TriDirectElt(td, z) = _braid_CTAlloc(braid_Real, nprocs*2*N);
+
+   _braid_GridElt(grids[level], tridirect) = td;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Solve grid 'level' exactly, assuming that TriResidual is affine (otherwise
+ * do one secant Newton step)
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_TriDirectSolve(braid_Core  core,
+                      braid_Int   level)
+{
+   MPI_Comm            comm     = _braid_CoreElt(core, comm);
+   braid_App           app      = _braid_CoreElt(core, app);
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   braid_BufferStatus  bstatus  = (braid_BufferStatus)core;
+   braid_Int           ilower   = _braid_GridElt(grids[level], ilower);
+
+   _braid_TriDirect   *td;
+   braid_BaseVector    u, v, r;
+   braid_Real         *b, *y, *z, *rz, *L, *D, *U, *ulast;
+   braid_Int          *piv;
+   braid_Int           myid, nprocs, N, n, i, k, q, left, right, size;
+
+   braid_Int           nrequests;
+   MPI_Request        *requests;
+   MPI_Status         *statuses;
+   void              **buffers;
+
+   /* The residual and the probes need the current ghost points */
+   _braid_TriCommInit(core, level, &nrequests, &requests, &statuses, &buffers);
+   _braid_TriCommWait(core, level,  nrequests, &requests, &statuses, &buffers);
+
+   /* With Newton-TriMGRIT, probe the blocks again in each new linearization
+    * epoch.  Otherwise they are probed once. */
+   td = _braid_GridElt(grids[level], tridirect);
+   if (_braid_CoreElt(core, trilinearize) != NULL)
+   {
+      _braid_TriNewtonUpdate(core, level);
+      if ( (td != NULL) &&
+           (_braid_TriDirectElt(td, lin_epoch) != _braid_GridElt(grids[level], lin_epoch)) )
+      {
+         _braid_TriDirectDestroy(td);
+         _braid_GridElt(grids[level], tridirect) = NULL;
+      }
+   }
+   if (_braid_GridElt(grids[level], tridirect) == NULL)
+   {
+      _braid_TriDirectSetup(core, level);
+   }
+   td    = _braid_GridElt(grids[level], tridirect);
+   N     = _braid_TriDirectElt(td, nblock);
+   n     = _braid_TriDirectElt(td, npoints);
+   b     = _braid_TriDirectElt(td, b);
+   z     = _braid_TriDirectElt(td, z);
+   L     = _braid_TriDirectElt(td, L);
+   D     = _braid_TriDirectElt(td, D);
+   U     = _braid_TriDirectElt(td, U);
+   piv   = _braid_TriDirectElt(td, piv);
+   ulast = _braid_TriDirectElt(td, ulast);
+   left  = _braid_TriDirectElt(td, left);
+   right = _braid_TriDirectElt(td, right);
+
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &nprocs);
+
+   /* Local rhs b_i = f_i - A_i(u) and its solution y = T^{-1} b */
+   y = _braid_CTAlloc(braid_Real, 2*N);
+   if (n > 0)
+   {
+      for (i = 0; i < n; i++)
+      {
+         _braid_TriResidual(core, level, ilower+i, 1, &r);  /* A(u) - f */
+         _braid_BufferStatusInit(0, 0, bstatus);
+         _braid_BaseBufSize(core, app, &size, bstatus);
+         _braid_StatusElt(bstatus, size_buffer) = size;
+         _braid_BaseBufPack(core, app, r, &b[i*N], bstatus);
+         _braid_BaseFree(core, app, r);
+         for (k = 0; k < N; k++)
+         {
+            b[i*N+k] = -b[i*N+k];
+         }
+      }
+
+      rz = _braid_CTAlloc(braid_Real, n*N);
+      for (k = 0; k < n*N; k++)
+      {
+         rz[k] = b[k];
+      }
+      _braid_BlockThomasSolve(n, N, L, D, U, piv, rz, 1);
+      for (k = 0; k < N; k++)
+      {
+         y[k]   = rz[k];
+         y[N+k] = rz[(n-1)*N + k];
+      }
+      _braid_TFree(rz);
+   }
+
+   /* Solve the reduced system on process 0 and share its solution */
+   MPI_Gather(y, 2*N, braid_MPI_REAL, z, 2*N, braid_MPI_REAL, 0, comm);
+   if (myid == 0)
+   {
+      braid_Int   Q      = _braid_TriDirectElt(td, nreduced);
+      braid_Int  *rprocs = _braid_TriDirectElt(td, rprocs);
+
+      rz = _braid_CTAlloc(braid_Real, Q*2*N);
+      for (q = 0; q < Q; q++)
+      {
+         for (k = 0; k < 2*N; k++)
+         {
+            rz[q*2*N + k] = z[rprocs[q]*2*N + k];
+         }
+      }
+      _braid_BlockThomasSolve(Q, 2*N, _braid_TriDirectElt(td, RL), _braid_TriDirectElt(td, RD),
+                              _braid_TriDirectElt(td, RU), _braid_TriDirectElt(td, rpiv), rz, 1);
+      for (q = 0; q < Q; q++)
+      {
+         for (k = 0; k < 2*N; k++)
+         {
+            z[rprocs[q]*2*N + k] = rz[q*2*N + k];
+         }
+      }
+      _braid_TFree(rz);
+   }
+   MPI_Bcast(z, nprocs*2*N, braid_MPI_REAL, 0, comm);
+   _braid_TFree(y);
+
+   /* Move the interface values to the rhs and solve the local rows again */
+   if (n > 0)
+   {
+      if (left > -1)
+      {
+         _braid_DenseSubMult(N, &L[0], &z[left*2*N + N], &b[0], 1);
+      }
+      if (right > -1)
+      {
+         _braid_DenseSubMult(N, ulast, &z[right*2*N], &b[(n-1)*N], 1);
+      }
+      _braid_BlockThomasSolve(n, N, L, D, U, piv, b, 1);
+
+      for (i = 0; i < n; i++)
+      {
+         _braid_BufferStatusInit(0, 0, bstatus);
+         _braid_BaseBufUnpack(core, app, &b[i*N], &v, bstatus);
+         _braid_UGetVectorRef(core, level, ilower+i, &u);
+         _braid_BaseSum(core, app, 1.0, v, 1.0, u);
+         _braid_BaseFree(core, app, v);
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Free the direct solver data
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_TriDirectDestroy(_braid_TriDirect  *td)
+{
+   if (td)
+   {
+      _braid_TFree(_braid_TriDirectElt(td, L));
+      _braid_TFree(_braid_TriDirectElt(td, D));
+      _braid_TFree(_braid_TriDirectElt(td, U));
+      _braid_TFree(_braid_TriDirectElt(td, piv));
+      _braid_TFree(_braid_TriDirectElt(td, ulast));
+      _braid_TFree(_braid_TriDirectElt(td, b));
+      _braid_TFree(_braid_TriDirectElt(td, z));
+      _braid_TFree(_braid_TriDirectElt(td, rprocs));
+      _braid_TFree(_braid_TriDirectElt(td, RL));
+      _braid_TFree(_braid_TriDirectElt(td, RD));
+      _braid_TFree(_braid_TriDirectElt(td, RU));
+      _braid_TFree(_braid_TriDirectElt(td, rpiv));
+      _braid_TFree(td);
+   }
+
+   return _braid_error_flag;
+}
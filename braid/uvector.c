@@ -21,9 +21,311 @@
  *
  ***********************************************************************EHEADER*/
 
+#include <float.h>
+#include <string.h>
 #include "_braid.h"
 #include "_util.h"
 
+/*----------------------------------------------------------------------------
+ * Returns the compressed record of point 'index' on grid 'level' through
+ * 'z_ptr', and whether the point is stored compressed.  Only the F-points on
+ * level 0 are compressed, except for the last time point, so that
+ * braid_GetLast returns the exact solution.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UZIsStored(braid_Core    core,
+                  braid_Int     level,
+                  braid_Int     index,
+                  braid_Int     iu,
+                  char       ***z_ptr)
+{
+   _braid_Grid        **grids    = _braid_CoreElt(core, grids);
+   char               **uz       = _braid_GridElt(grids[level], uz);
+   braid_Int            nupoints = _braid_GridElt(grids[level], nupoints);
+   braid_Int            cfactor  = _braid_GridElt(grids[level], cfactor);
+
+   if ( (uz == NULL) || (iu < 0) || (iu >= nupoints) ||
+        _braid_IsCPoint(index, cfactor) || (index == _braid_CoreElt(core, ntime)) )
+   {
+      return 0;
+   }
+   *z_ptr = &uz[iu];
+
+   return 1;
+}
+
+/*----------------------------------------------------------------------------
+ * Free the decompressed F-point view on grid 'level', if there is one
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UZRelease(braid_Core  core,
+                 braid_Int   level)
+{
+   braid_App            app      = _braid_CoreElt(core, app);
+   _braid_Grid        **grids    = _braid_CoreElt(core, grids);
+   braid_BaseVector    *ua       = _braid_GridElt(grids[level], ua);
+   braid_Int            uz_index = _braid_GridElt(grids[level], uz_index);
+
+   if (uz_index > -1)
+   {
+      _braid_BaseFree(core, app, ua[uz_index]);
+      ua[uz_index] = NULL;
+      _braid_GridElt(grids[level], uz_index) = -1;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * The stored F-point vectors only serve as initial guesses for the implicit
+ * solves, so they are quantized with an error below the absolute stopping
+ * tolerance.  A flat array of n braid_Reals in [xmin, xmax] is stored as
+ * integer codes k, with x = xmin + k*q and q = 2*tol/sqrt(n), so the 2-norm of
+ * the error is at most tol.  The codes take 1, 2 or 4 bytes, depending on the
+ * number of levels.  The packed bytes are stored as they are if the tolerance
+ * is not known yet (rtol before the first residual), a value is not finite, or
+ * the codes do not fit in 4 bytes.  If a codec was set with
+ * braid_SetCompressCommFcns, it is called with the same tolerance instead.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_UCompress(braid_Core         core,
+                 braid_BaseVector   u,
+                 char             **z_ptr)
+{
+   braid_App                 app         = _braid_CoreElt(core, app);
+   braid_PtFcnBufCompress    bufcompress = _braid_CoreElt(core, bufcompress);
+   braid_Real                tol         = _braid_CoreElt(core, tol);
+   braid_Real                rnorm0      = _braid_CoreElt(core, rnorm0);
+   braid_BufferStatus        bstatus     = (braid_BufferStatus)core;
+   braid_Int                 hsize       = _braid_UZHeaderSize;
+
+   braid_Int                 codec, size, csize, nbytes, finite, i, n;
+   braid_Int                *header;
+   braid_Real               *dbuf, *qbuf, xmin, xmax, q, levels;
+   uint32_t                  k;
+   void                     *buffer, *cbuffer;
+   unsigned char            *codes;
+   char                     *z;
+
+   /* Pack the vector */
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_BaseBufSize(core, app, &size, bstatus);
+   buffer = _braid_TAlloc(char, size);
+   _braid_StatusElt(bstatus, size_buffer) = size;
+   _braid_BaseBufPack(core, app, u, buffer, bstatus);
+   size = _braid_StatusElt(bstatus, size_buffer);
+
+   if ( _braid_CoreElt(core, rtol) )
+   {
+      tol = (rnorm0 != braid_INVALID_RNORM) ? tol*rnorm0 : 0.0;
+   }
+
+   codec   = _braid_UZ_RAW;
+   nbytes  = 0;
+   cbuffer = NULL;
+   csize   = size;
+   n       = size / sizeof(braid_Real);
+   dbuf    = (braid_Real *) buffer;
+   xmin    = 0.0;
+   q       = 0.0;
+   if ( (tol > 0.0) && (bufcompress != NULL) )
+   {
+      cbuffer = _braid_TAlloc(char, size);
+      csize   = 0;
+      bufcompress(app, buffer, size, tol, cbuffer, &csize);
+      if ( (csize > 0) && (csize < size) )
+      {
+         codec = _braid_UZ_USER;
+      }
+      else
+      {
+         _braid_TFree(cbuffer);
+         csize = size;
+      }
+   }
+   else if ( (tol > 0.0) && (n > 0) && ((size % sizeof(braid_Real)) == 0) )
+   {
+      finite = 1;
+      xmin   = dbuf[0];
+      xmax   = dbuf[0];
+      for (i = 0; i < n; i++)
+      {
+         if ( !(fabs(dbuf[i]) <= DBL_MAX) )
+         {
+            finite = 0;
+            break;
+         }
+         xmin = _braid_min(xmin, dbuf[i]);
+         xmax = _braid_max(xmax, dbuf[i]);
+      }
+      q      = 2.0*tol/sqrt((braid_Real) n);
+      levels = (xmax - xmin)/q;
+      if (finite)
+      {
+         if (levels < 255.0)
+         {
+            nbytes = 1;
+         }
+         else if (levels < 65535.0)
+         {
+            nbytes = 2;
+         }
+         else if (levels < 4294967295.0)
+         {
+            nbytes = 4;
+         }
+      }
+      if ( (nbytes > 0) && (2*sizeof(braid_Real) + n*nbytes < size) )
+      {
+         codec = _braid_UZ_QUANT;
+         csize = 2*sizeof(braid_Real) + n*nbytes;
+      }
+   }
+
+   z = _braid_TAlloc(char, hsize + csize);
+   header = (braid_Int *) z;
+   header[0] = codec;
+   header[1] = size;
+   header[2] = csize;
+   header[3] = nbytes;
+   if (codec == _braid_UZ_QUANT)
+   {
+      qbuf    = (braid_Real *)(z + hsize);
+      qbuf[0] = xmin;
+      qbuf[1] = q;
+      codes   = (unsigned char *)(z + hsize + 2*sizeof(braid_Real));
+      for (i = 0; i < n; i++)
+      {
+         k = (uint32_t) floor((dbuf[i] - xmin)/q + 0.5);
+         if (nbytes == 1)
+         {
+            codes[i] = (unsigned char) k;
+         }
+         else if (nbytes == 2)
+         {
+            ((uint16_t *) codes)[i] = (uint16_t) k;
+         }
+         else
+         {
+            ((uint32_t *) codes)[i] = k;
+         }
+      }
+   }
+   else
+   {
+      memcpy(z + hsize, (codec == _braid_UZ_USER) ? cbuffer : buffer, csize);
+   }
+
+   if (cbuffer != NULL)
+   {
+      _braid_TFree(cbuffer);
+   }
+   _braid_TFree(buffer);
+
+   *z_ptr = z;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_UDecompress(braid_Core         core,
+                   char              *z,
+                   braid_BaseVector  *u_ptr)
+{
+   braid_App                 app           = _braid_CoreElt(core, app);
+   braid_PtFcnBufDecompress  bufdecompress = _braid_CoreElt(core, bufdecompress);
+   braid_BufferStatus        bstatus       = (braid_BufferStatus)core;
+   braid_Int                 hsize         = _braid_UZHeaderSize;
+   braid_Int                *header        = (braid_Int *) z;
+   braid_Int                 codec         = header[0];
+   braid_Int                 size          = header[1];
+   braid_Int                 csize         = header[2];
+   braid_Int                 nbytes        = header[3];
+
+   braid_Int                 i, n;
+   braid_Real               *dbuf, *qbuf;
+   uint32_t                  k;
+   unsigned char            *codes;
+   void                     *buffer;
+
+   buffer = _braid_TAlloc(char, size);
+   if (codec == _braid_UZ_QUANT)
+   {
+      n     = size / sizeof(braid_Real);
+      dbuf  = (braid_Real *) buffer;
+      qbuf  = (braid_Real *)(z + hsize);
+      codes = (unsigned char *)(z + hsize + 2*sizeof(braid_Real));
+      for (i = 0; i < n; i++)
+      {
+         if (nbytes == 1)
+         {
+            k = codes[i];
+         }
+         else if (nbytes == 2)
+         {
+            k = ((uint16_t *) codes)[i];
+         }
+         else
+         {
+            k = ((uint32_t *) codes)[i];
+         }
+         dbuf[i] = qbuf[0] + k*qbuf[1];
+      }
+   }
+   else if (codec == _braid_UZ_USER)
+   {
+      bufdecompress(app, z + hsize, csize, buffer, size);
+   }
+   else
+   {
+      memcpy(buffer, z + hsize, size);
+   }
+
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_BaseBufUnpack(core, app, buffer, u_ptr, bstatus);
+   _braid_TFree(buffer);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_UCompressRatio(braid_Core  core)
+{
+   MPI_Comm             comm     = _braid_CoreElt(core, comm);
+   _braid_Grid        **grids    = _braid_CoreElt(core, grids);
+   char               **uz       = _braid_GridElt(grids[0], uz);
+   braid_Int            nupoints = _braid_GridElt(grids[0], nupoints);
+   braid_Real           bytes[2], gbytes[2];
+   braid_Int           *header;
+   braid_Int            iu;
+
+   bytes[0] = 0.0;
+   bytes[1] = 0.0;
+   for (iu = 0; (uz != NULL) && (iu < nupoints); iu++)
+   {
+      if (uz[iu] != NULL)
+      {
+         header = (braid_Int *) uz[iu];
+         bytes[0] += header[1];
+         bytes[1] += _braid_UZHeaderSize + header[2];
+      }
+   }
+   MPI_Allreduce(bytes, gbytes, 2, braid_MPI_REAL, MPI_SUM, comm);
+
+   _braid_CoreElt(core, storage_ratio) = (gbytes[1] > 0.0) ? gbytes[0]/gbytes[1] : 0.0;
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * Returns an index into the local u-vector for grid 'level' at point 'index'.
  *----------------------------------------------------------------------------*/
@@ -104,12 +406,21 @@ _braid_UGetVectorRef(braid_Core         core,
    _braid_Grid        **grids = _braid_CoreElt(core, grids);
    braid_BaseVector    *ua    = _braid_GridElt(grids[level], ua);
    braid_BaseVector     u     = NULL;
+   char               **z;
    braid_Int            iu, sflag;
 
    _braid_UGetIndex(core, level, index, &iu, &sflag);
    if (sflag>-2) // We have a full point or a shell (iu>=0)
    {
       u = ua[iu];
+      if ( (u == NULL) && _braid_UZIsStored(core, level, index, iu, &z) && (*z != NULL) )
+      {
+         /* Decompress into a view, which replaces the previous one */
+         _braid_UZRelease(core, level);
+         _braid_UDecompress(core, *z, &u);
+         ua[iu] = u;
+         _braid_GridElt(grids[level], uz_index) = iu;
+      }
    }
 
    *u_ptr = u;
@@ -161,11 +472,32 @@ _braid_USetVectorRef(braid_Core        core,
 {
    _braid_Grid        **grids = _braid_CoreElt(core, grids);
    braid_BaseVector    *ua    = _braid_GridElt(grids[level], ua);
+   char               **z;
    braid_Int            iu, sflag;
 
    _braid_UGetIndex(core, level, index, &iu, &sflag);
    // If sflag ==0, we have a full point, if sflag == -1, we have a shell
-   if (sflag == 0)
+   if ( (sflag == 0) && _braid_UZIsStored(core, level, index, iu, &z) )
+   {
+      braid_App    app = _braid_CoreElt(core, app);
+      if ( (ua[iu] != NULL) && (ua[iu] != u) )
+      {
+         /* Drop the old view */
+         _braid_UZRelease(core, level);
+      }
+      if (*z != NULL)
+      {
+         _braid_TFree(*z);
+      }
+      _braid_UCompress(core, u, z);
+      _braid_BaseFree(core, app, u);
+      ua[iu] = NULL;
+      if (_braid_GridElt(grids[level], uz_index) == iu)
+      {
+         _braid_GridElt(grids[level], uz_index) = -1;
+      }
+   }
+   else if (sflag == 0)
    {
       ua[iu] = u;
    }
@@ -198,6 +530,7 @@ _braid_UGetVector(braid_Core         core,
    braid_Int            recv_index  = _braid_GridElt(grids[level], recv_index);
    _braid_CommHandle   *recv_handle = _braid_GridElt(grids[level], recv_handle);
    braid_BaseVector     u           = NULL;
+   char               **z;
    braid_Int            iu, sflag;
 
    if (index == recv_index)
@@ -214,7 +547,14 @@ _braid_UGetVector(braid_Core         core,
    else
    {
       _braid_UGetIndex(core, level, index, &iu, &sflag);
-      if (sflag == 0)
+      if ( (sflag == 0) && (ua[iu] == NULL) && _braid_UZIsStored(core, level, index, iu, &z) )
+      {
+         if (*z != NULL)
+         {
+            _braid_UDecompress(core, *z, &u);
+         }
+      }
+      else if (sflag == 0)
       {
          _braid_BaseClone(core, app, ua[iu], &u);
       }
@@ -250,6 +590,7 @@ _braid_USetVector(braid_Core        core,
    braid_BaseVector    *ua          = _braid_GridElt(grids[level], ua);
    braid_Int            send_index  = _braid_GridElt(grids[level], send_index);
    _braid_CommHandle   *send_handle = _braid_GridElt(grids[level], send_handle);
+   char               **z;
    braid_Int            iu, sflag;
 
    if (index == send_index)
@@ -261,7 +602,24 @@ _braid_USetVector(braid_Core        core,
    }
 
    _braid_UGetIndex(core, level, index, &iu, &sflag);
-   if (sflag == 0) // We have a full point
+   if ( (sflag == 0) && _braid_UZIsStored(core, level, index, iu, &z) )
+   {
+      // We have a compressed point
+      if (ua[iu] != NULL)
+      {
+         _braid_UZRelease(core, level);
+      }
+      if (*z != NULL)
+      {
+         _braid_TFree(*z);
+      }
+      _braid_UCompress(core, u, z);
+      if (move)
+      {
+         _braid_BaseFree(core, app,  u);
+      }
+   }
+   else if (sflag == 0) // We have a full point
    {
       if (ua[iu] != NULL)
       {
@@ -301,6 +659,49 @@ _braid_USetVector(braid_Core        core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Frozen points are not changed by the cycle, and on coarse grids their value
+ * is the restricted value in va[].  Level 0 F-points are not skipped, since
+ * their values are not stored in general.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_USkipFrozen(braid_Core        core,
+                   braid_Int         level,
+                   braid_Int         frozen,
+                   braid_Int         flo,
+                   braid_Int         fhi,
+                   braid_Int        *fstart_ptr,
+                   braid_BaseVector *u_ptr)
+{
+   braid_App            app         = _braid_CoreElt(core, app);
+   _braid_Grid        **grids       = _braid_CoreElt(core, grids);
+   braid_Int            ilower      = _braid_GridElt(grids[level], ilower);
+   braid_BaseVector    *va          = _braid_GridElt(grids[level], va);
+   braid_Int            send_index  = _braid_GridElt(grids[level], send_index);
+   _braid_CommHandle   *send_handle = _braid_GridElt(grids[level], send_handle);
+   braid_Int            fstart      = flo;
+   braid_BaseVector     u           = NULL;
+
+   if ( (level > 0) && (flo <= fhi) && (frozen >= flo) )
+   {
+      fstart = _braid_min(frozen, fhi) + 1;
+      if ( (send_index >= flo) && (send_index < fstart) )
+      {
+         /* Post the send of the skipped point */
+         _braid_CommSendInit(core, level, send_index, va[send_index-ilower], &send_handle);
+         _braid_GridElt(grids[level], send_index)  = -1;
+         _braid_GridElt(grids[level], send_handle) = send_handle;
+      }
+      _braid_BaseClone(core, app, va[fstart-1-ilower], &u);
+   }
+
+   *fstart_ptr = fstart;
+   *u_ptr      = u;
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * Basic communication (from the left, to the right)
  *----------------------------------------------------------------------------*/
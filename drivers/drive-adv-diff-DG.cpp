@@ -113,6 +113,7 @@ struct DGAdvectionOptions : public BraidOptions
    double dt; // derived from t_start, t_final, and num_time_steps
    bool   krylov_coarse;
    int    krylov_size;
+   int    delta_rank;
    bool   init_rand;
    int    prec_type; // passed down to FE_Evolution
    int    diss_oper_type;
@@ -175,6 +176,10 @@ public:
    virtual int SpatialNorm(braid_Vector  u_,
                            double       *norm_ptr);
 
+   virtual int InnerProd(braid_Vector  u_,
+                         braid_Vector  v_,
+                         double       *prod_ptr);
+
    virtual ~DGAdvectionApp();
 
    void PrintStats(MPI_Comm comm);
@@ -229,6 +234,19 @@ int main(int argc, char *argv[])
       mesh->SetCurvature(std::max(opts.order, 1));
    }
 
+   // The Arnoldi coarse steps and XBraid's Delta correction both change the
+   // coarse propagator, so use only one of them
+   if (opts.krylov_coarse && opts.delta_rank > 0)
+   {
+      if (myid == 0)
+      {
+         cerr << "\nError: use only one of -kc and -delta\n" << endl;
+      }
+      delete mesh;
+      MPI_Finalize();
+      return 3;
+   }
+
    // Split comm (MPI_COMM_WORLD) into spatial and temporal communicators
    MPI_Comm comm_x, comm_t;
    BraidUtil util;
@@ -244,6 +262,10 @@ int main(int argc, char *argv[])
    // Run a Braid simulation
    BraidCore core(comm, &app);
    opts.SetBraidCoreOptions(core);
+   if (opts.delta_rank > 0)
+   {
+      core.SetDeltaCorrection(opts.delta_rank);
+   }
 
    core.Drive();
    app.PrintStats(comm);
@@ -400,6 +422,7 @@ DGAdvectionOptions::DGAdvectionOptions(int argc, char *argv[])
    lump_mass       = false;
    krylov_coarse   = false;
    krylov_size     = 4;
+   delta_rank      = 0;
    init_rand       = false;
    prec_type       = 0; // see FE_Evolution::SetPreconditionerType()
    vishost         = "localhost";
@@ -431,6 +454,9 @@ DGAdvectionOptions::DGAdvectionOptions(int argc, char *argv[])
              " time-stepping.");
    AddOption(&krylov_size, "-ks", "--krylov-size", "Set size of the Krylov space for the"
                            " Arnoldi-based coarse-grid time-stepping.");
+   AddOption(&delta_rank, "-delta", "--delta-rank", "Rank of XBraid's low-rank"
+             " Delta correction of the coarse-grid steps (0 is off), built by"
+             " Arnoldi on the fine steps.  Not combined with -kc.");
    AddOption(&init_rand, "-rand", "--random-init", "-zero", "--zero-init",
              "How to initialize vectors: with random numbers or zeros");
    AddOption(&prec_type, "-prec", "--preconditioner",
@@ -632,6 +658,19 @@ int DGAdvectionApp::SpatialNorm(braid_Vector  u_,
    return 0;
 }
 
+// The mass-matrix inner product of SpatialNorm, used by the Delta correction
+int DGAdvectionApp::InnerProd(braid_Vector  u_,
+                              braid_Vector  v_,
+                              double       *prod_ptr)
+{
+   BraidVector  *u  = (BraidVector*) u_;
+   BraidVector  *v  = (BraidVector*) v_;
+   FE_Evolution *ev = dynamic_cast<FE_Evolution*>(ode[u->level]);
+   MFEM_ASSERT(ev, "expected object of type FE_Evolution");
+   *prod_ptr = ev->InnerProduct(*u, *v);
+   return 0;
+}
+
 // Allocate data structures for the given number of spatial levels. Used by
 // InitMultilevelApp.
 void DGAdvectionApp::AllocLevels(int num_levels)
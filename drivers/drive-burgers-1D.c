@@ -71,6 +71,8 @@ typedef struct _braid_App_struct
    int       problem;       /* test problem, 0: linear advection, 1: Burger's equation */
    double    a;             /* if is_linear == 1, then use this as the linear advection constant */
    int       alternate_sc;  /* alternate spatial coarsening each level; semi-coarsen first in time, then in space, repeating */ 
+   int       stepper;       /* 0: forward Euler, 1: backward Euler */
+   int       lowprec;       /* levels >= lowprec store single precision vectors (0 is off) */
    double *  sc_info;       /* Runtime information on CFL's encountered and spatial discretizations used */
 } my_App;
 
@@ -81,6 +83,7 @@ typedef struct _braid_Vector_struct
 {
    int     size;
    double *values;
+   float  *fvalues;  /* used instead of values on coarse levels with -lowprec */
 
 } my_Vector;
 
@@ -568,6 +571,24 @@ my_SpatialNorm(braid_App     app,
    return 0;
 }
 
+int
+my_InnerProd(braid_App     app,
+             braid_Vector  u,
+             braid_Vector  v,
+             double       *prod_ptr)
+{
+   int    i, size = (u->size);
+   double dot = 0.0;
+
+   for (i = 0; i < size; i++)
+   {
+      dot += (u->values)[i]*(v->values)[i];
+   }
+   *prod_ptr = dot;
+
+   return 0;
+}
+
 int
 my_Access(braid_App          app,
           braid_Vector       u,
@@ -660,6 +681,223 @@ my_BufUnpack(braid_App           app,
    return 0;
 }
 
+/* Coarse-level (single) precision versions of the vector routines, used
+ * with -lowprec.  The state is stored in fvalues, and Step works on a
+ * temporary double precision copy. */
+
+int
+my_Demote(braid_App     app,
+          braid_Vector  u,
+          braid_Vector *v_ptr)
+{
+   my_Vector *v;
+   int i, size = (u->size);
+
+   v = (my_Vector *) malloc(sizeof(my_Vector));
+   (v->size)    = size;
+   (v->values)  = NULL;
+   (v->fvalues) = (float *) malloc(size*sizeof(float));
+   for (i = 0; i < size; i++)
+   {
+      (v->fvalues)[i] = (float) (u->values)[i];
+   }
+   *v_ptr = v;
+
+   return 0;
+}
+
+int
+my_Promote(braid_App     app,
+           braid_Vector  u,
+           braid_Vector *v_ptr)
+{
+   my_Vector *v;
+   int i, size = (u->size);
+
+   v = (my_Vector *) malloc(sizeof(my_Vector));
+   (v->size)   = size;
+   (v->values) = (double *) malloc(size*sizeof(double));
+   for (i = 0; i < size; i++)
+   {
+      (v->values)[i] = (u->fvalues)[i];
+   }
+   *v_ptr = v;
+
+   return 0;
+}
+
+int
+my_StepLow(braid_App        app,
+           braid_Vector     ustop,
+           braid_Vector     fstop,
+           braid_Vector     u,
+           braid_StepStatus status)
+{
+   my_Vector *du, *dustop, *dfstop = NULL;
+   int i, size = (u->size);
+
+   my_Promote(app, u, &du);
+   my_Promote(app, ustop, &dustop);
+   if (fstop != NULL)
+   {
+      my_Promote(app, fstop, &dfstop);
+   }
+
+   if (app->stepper == 0)
+   {
+      my_StepFE(app, dustop, dfstop, du, status);
+   }
+   else
+   {
+      my_StepBE(app, dustop, dfstop, du, status);
+   }
+
+   for (i = 0; i < size; i++)
+   {
+      (u->fvalues)[i] = (float) (du->values)[i];
+   }
+
+   my_Free(app, du);
+   my_Free(app, dustop);
+   if (dfstop != NULL)
+   {
+      my_Free(app, dfstop);
+   }
+
+   return 0;
+}
+
+int
+my_CloneLow(braid_App     app,
+            braid_Vector  u,
+            braid_Vector *v_ptr)
+{
+   my_Vector *v;
+   int size = (u->size);
+
+   v = (my_Vector *) malloc(sizeof(my_Vector));
+   (v->size)    = size;
+   (v->values)  = NULL;
+   (v->fvalues) = (float *) malloc(size*sizeof(float));
+   memcpy(v->fvalues, u->fvalues, size*sizeof(float));
+   *v_ptr = v;
+
+   return 0;
+}
+
+int
+my_FreeLow(braid_App    app,
+           braid_Vector u)
+{
+   free(u->fvalues);
+   free(u);
+
+   return 0;
+}
+
+int
+my_SumLow(braid_App     app,
+          double        alpha,
+          braid_Vector  x,
+          double        beta,
+          braid_Vector  y)
+{
+   int i, size = (y->size);
+
+   for (i = 0; i < size; i++)
+   {
+      (y->fvalues)[i] = alpha*(x->fvalues)[i] + beta*(y->fvalues)[i];
+   }
+
+   return 0;
+}
+
+int
+my_BufPackLow(braid_App           app,
+              braid_Vector        u,
+              void               *buffer,
+              braid_BufferStatus  bstatus)
+{
+   int   *ibuffer = buffer;
+   float *fbuffer = (float *) (ibuffer + 1);
+   int    size = (u->size);
+
+   ibuffer[0] = size;
+   memcpy(fbuffer, u->fvalues, size*sizeof(float));
+
+   braid_BufferStatusSetSize( bstatus,  sizeof(int) + size*sizeof(float));
+
+   return 0;
+}
+
+int
+my_BufUnpackLow(braid_App           app,
+                void               *buffer,
+                braid_Vector       *u_ptr,
+                braid_BufferStatus  bstatus)
+{
+   my_Vector *u;
+   int       *ibuffer = buffer;
+   float     *fbuffer = (float *) (ibuffer + 1);
+   int        size;
+
+   size = ibuffer[0];
+
+   u = (my_Vector *) malloc(sizeof(my_Vector));
+   (u->size)    = size;
+   (u->values)  = NULL;
+   (u->fvalues) = (float *) malloc(size*sizeof(float));
+   memcpy(u->fvalues, fbuffer, size*sizeof(float));
+   *u_ptr = u;
+
+   return 0;
+}
+
+/* Describe the vector values in place, used with -describe.  Without spatial
+ * coarsening, all vectors have nspace+1 values. */
+int
+my_BufDescribe(braid_App      app,
+               int            level,
+               double         t,
+               braid_Vector  *u_ptr,
+               MPI_Datatype  *dtype_ptr)
+{
+   my_Vector *u = *u_ptr;
+   int        lowprec = (app->lowprec > 0) && (level >= app->lowprec);
+   int        size = (app->nspace)+1;
+   MPI_Aint   disp;
+
+   if (u == NULL)
+   {
+      u = (my_Vector *) malloc(sizeof(my_Vector));
+      (u->size)    = size;
+      (u->values)  = NULL;
+      (u->fvalues) = NULL;
+      if (lowprec)
+      {
+         (u->fvalues) = (float *) malloc(size*sizeof(float));
+      }
+      else
+      {
+         (u->values) = (double *) malloc(size*sizeof(double));
+      }
+      *u_ptr = u;
+   }
+
+   if (lowprec)
+   {
+      MPI_Get_address(u->fvalues, &disp);
+      MPI_Type_create_hindexed(1, &size, &disp, MPI_FLOAT, dtype_ptr);
+   }
+   else
+   {
+      MPI_Get_address(u->values, &disp);
+      MPI_Type_create_hindexed(1, &size, &disp, MPI_DOUBLE, dtype_ptr);
+   }
+   MPI_Type_commit(dtype_ptr);
+
+   return 0;
+}
 
 int
 my_CoarsenLinear(braid_App              app,           
@@ -862,9 +1100,24 @@ int main (int argc, char *argv[])
    int           max_iter      = 30;
    int           fmg           = 0;
    int           nfmg_Vcyc     = 1;
+   int           nested_vcyc   = 0;
+   double        mem_budget    = 0.0;
+   int           zstore        = 0;
    int           scoarsen      = 0;
    int           alternate_sc  = 0;
    int           res           = 0;
+   int           access_level  = 1;
+   double        frozen_tol    = 0.0;
+   int           compress      = -1;
+   int           lowprec       = 0;
+   int           describe      = 0;
+   int           shmcomm       = 0;
+   int           delta_rank    = 0;
+   int           anderson_dim  = 0;
+   int           anderson_ortho = 0;
+   char         *solfile       = NULL;
+   char         *wckpfile      = NULL;
+   char         *rckpfile      = NULL;
    int           stepper       = 0;
    int           max_iter_x[2];
 
@@ -921,7 +1174,21 @@ int main (int argc, char *argv[])
             printf("  -asc  <alternate sc> : alternate spatial coarsening each level; 1: semi-coarsen first in time, then in space, repeating\n"); 
             printf("                       : 2: semi-coarsen first in space, and then in time, repeating\n"); 
             printf("  -fmg  <nfmg_Vcyc>    : use FMG cycling, nfmg_Vcyc V-cycles at each fmg level\n");
+            printf("  -nested <nvcyc>      : nested iteration initial guess, nvcyc V-cycles at each coarse level\n");
+            printf("  -mem <bytes>         : choose the storage for this vector memory budget per processor\n");
+            printf("  -zstore              : store F-points, quantized within tol on the fine grid (with -mem, if needed)\n");
             printf("  -res                 : use my residual\n");
+            printf("  -access <level>      : set access level, 0 writes no solution files (default 1)\n");
+            printf("  -frozen <frac>       : skip leading C-points whose combined residual is below frac*tol\n");
+            printf("  -comp <level>        : send single precision messages on levels >= level until close to tol\n");
+            printf("  -lowprec <level>     : store vectors in single precision on levels >= level\n");
+            printf("  -describe            : send and receive vectors in place (no spatial coarsening)\n");
+            printf("  -shm                 : exchange with same-node time neighbors through shared memory\n");
+            printf("  -delta <rank>        : add a rank <rank> Delta correction to the coarse steps (no spatial coarsening)\n");
+            printf("  -anderson <kdim> <ortho>: Anderson acceleration over the last kdim cycles, Gram-Schmidt variant ortho\n");
+            printf("  -wsol <file>         : write the solution to one binary file, instead of a text file per time step\n");
+            printf("  -wckp <file>         : write a checkpoint when done\n");
+            printf("  -rckp <file>         : continue from a checkpoint\n");
             printf("\n");
          }
          exit(1);
@@ -1013,6 +1280,21 @@ int main (int argc, char *argv[])
          fmg = 1;
          nfmg_Vcyc = atoi(argv[arg_index++]);
       }
+      else if ( strcmp(argv[arg_index], "-nested") == 0 )
+      {
+         arg_index++;
+         nested_vcyc = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-mem") == 0 )
+      {
+         arg_index++;
+         mem_budget = atof(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-zstore") == 0 )
+      {
+         arg_index++;
+         zstore = 1;
+      }
       else if ( strcmp(argv[arg_index], "-sc") == 0 )
       {
          arg_index++;
@@ -1028,6 +1310,62 @@ int main (int argc, char *argv[])
          arg_index++;
          res = 1;
       }
+      else if ( strcmp(argv[arg_index], "-access") == 0 )
+      {
+         arg_index++;
+         access_level = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-frozen") == 0 )
+      {
+         arg_index++;
+         frozen_tol = atof(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-comp") == 0 )
+      {
+         arg_index++;
+         compress = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-lowprec") == 0 )
+      {
+         arg_index++;
+         lowprec = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-describe") == 0 )
+      {
+         arg_index++;
+         describe = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-shm") == 0 )
+      {
+         arg_index++;
+         shmcomm = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-delta") == 0 )
+      {
+         arg_index++;
+         delta_rank = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-anderson") == 0 )
+      {
+         arg_index++;
+         anderson_dim   = atoi(argv[arg_index++]);
+         anderson_ortho = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-wsol") == 0 )
+      {
+         arg_index++;
+         solfile = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-wckp") == 0 )
+      {
+         arg_index++;
+         wckpfile = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-rckp") == 0 )
+      {
+         arg_index++;
+         rckpfile = argv[arg_index++];
+      }
       else
       {
          printf("ABORTING: incorrect command line parameter %s\n", argv[arg_index]);
@@ -1054,6 +1392,8 @@ int main (int argc, char *argv[])
    (app->problem)       = problem;
    (app->a)             = a;
    (app->alternate_sc)  = alternate_sc;
+   (app->stepper)       = stepper;
+   (app->lowprec)       = lowprec;
 
    /* Initialize the storage structure for recording spatial coarsening information */ 
    app->sc_info = (double*) malloc( 2*max_levels*sizeof(double) );
@@ -1092,6 +1432,39 @@ int main (int argc, char *argv[])
       braid_SetNRelax(core,  0, nrelax0);
    }
    braid_SetAbsTol(core, tol);
+   if (frozen_tol > 0.0)
+   {
+      braid_SetFrozenRegion(core, frozen_tol);
+   }
+   if (compress > -1)
+   {
+      braid_SetCompressComm(core, compress, 1.0e+02);
+   }
+   if (lowprec > 0)
+   {
+      braid_SetCoarsePrecision(core, lowprec, my_Demote, my_Promote, my_StepLow,
+                               my_CloneLow, my_FreeLow, my_SumLow, my_BufPackLow,
+                               my_BufUnpackLow);
+   }
+   if (describe && !scoarsen)
+   {
+      braid_SetBufDescribe(core, my_BufDescribe);
+   }
+   braid_SetShmComm(core, shmcomm);
+   braid_SetAccessLevel(core, access_level);
+   if (delta_rank > 0)
+   {
+      braid_SetDeltaCorrection(core, delta_rank, my_InnerProd);
+   }
+   if (anderson_dim > 0)
+   {
+      braid_SetAnderson(core, anderson_dim, anderson_ortho, my_InnerProd);
+   }
+   if (solfile != NULL)
+   {
+      braid_SetWriteSolution(core, solfile);
+      braid_SetAccessLevel(core, 0);
+   }
    
    if(alternate_sc == 0){
       braid_SetCFactor(core, -1, cfactor);
@@ -1127,6 +1500,22 @@ int main (int argc, char *argv[])
       braid_SetFMG(core);
       braid_SetNFMGVcyc(core, nfmg_Vcyc);
    }
+   if (nested_vcyc > 0)
+   {
+      braid_SetNestedIter(core, nested_vcyc);
+   }
+   if (mem_budget > 0.0)
+   {
+      braid_SetMemoryBudget(core, mem_budget);
+   }
+   if (zstore)
+   {
+      if (mem_budget == 0.0)
+      {
+         braid_SetStorage(core, 0);
+      }
+      braid_SetCompressStorage(core, 1);
+   }
    if (res)
    {
       braid_SetResidual(core, my_Residual);
@@ -1161,7 +1550,17 @@ int main (int argc, char *argv[])
    //      my_Access, my_Free, my_Clone, my_Sum, my_SpatialNorm, my_CoarsenBilinear, 
    //      my_InterpBilinear);
 
+   if (rckpfile != NULL)
+   {
+      braid_ReadCheckpoint(core, rckpfile);
+   }
+
    braid_Drive(core);
+
+   if (wckpfile != NULL)
+   {
+      braid_WriteCheckpoint(core, wckpfile);
+   }
    
    if(myid == 0)
    {
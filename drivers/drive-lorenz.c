@@ -325,7 +325,7 @@ my_BufPack(braid_App     app,
    {
       dbuffer[i] = (u->values[i]);
    }
-   braid_BufferStatusSetSize( bstatus, sizeof(double));
+   braid_BufferStatusSetSize( bstatus, VecSize*sizeof(double));
 
    return 0;
 }
@@ -370,6 +370,7 @@ int main (int argc, char *argv[])
    int           max_iter   = 100;
    int           fmg        = 0;
    int           res        = 0;
+   int           access_level = 1;
 
    int           arg_index, myid, nprocs;
    char          filename[255];
@@ -407,6 +408,7 @@ int main (int argc, char *argv[])
             printf("  -mi  <max_iter>   : set max iterations\n");
             printf("  -fmg              : use FMG cycling\n");
             printf("  -res              : use my residual\n");
+            printf("  -access <level>   : set access level, 0 writes no output files (default 1)\n");
             printf("\n");
          }
          exit(1);
@@ -461,6 +463,11 @@ int main (int argc, char *argv[])
          arg_index++;
          res = 1;
       }
+      else if ( strcmp(argv[arg_index], "-access") == 0 )
+      {
+         arg_index++;
+         access_level = atoi(argv[arg_index++]);
+      }
       else
       {
          arg_index++;
@@ -470,7 +477,11 @@ int main (int argc, char *argv[])
 
    /* initialize the output file */
    sprintf(filename, "%s.%05d", "ex-lorenz.out", myid);
-   file = fopen(filename, "w");
+   file = NULL;
+   if (access_level > 0)
+   {
+      file = fopen(filename, "w");
+   }
 
    /* set up app structure */
    app = (my_App *) malloc(sizeof(my_App));
@@ -495,6 +506,7 @@ int main (int argc, char *argv[])
    braid_SetCFactor(core, -1, cfactor);
    /*braid_SetCFactor(core,  0, 10);*/
    braid_SetMaxIter(core, max_iter);
+   braid_SetAccessLevel(core, access_level);
    if (fmg)
    {
       braid_SetFMG(core);
@@ -509,7 +521,7 @@ int main (int argc, char *argv[])
    braid_Destroy(core);
 
    /* reorder the output file */
-   if (myid == 0)
+   if (myid == 0 && access_level > 0)
    {
       int   ti, index, i, npoints = (ntime+1);
       Vec  *solution;
@@ -702,7 +702,7 @@ main(int argc, char *argv[])
    double      tstart, tstop, dt, dx, start, end; 
    int         rank, ntime, mspace, arg_index;
    double      alpha, nu;
-   int         max_levels, min_coarse, nrelax, nrelaxc, cfactor, maxiter;
+   int         max_levels, min_coarse, nrelax, nrelaxc, cfactor, maxiter, direct;
    int         access_level, print_level;
    double      tol;
    double time;
@@ -725,6 +725,7 @@ main(int argc, char *argv[])
    min_coarse     = 1;
    nrelax         = 1;
    nrelaxc        = 30;
+   direct         = 0;
    maxiter        = 300;
    cfactor        = 2;
    tol            = 1.0e-6;
@@ -752,6 +753,7 @@ main(int argc, char *argv[])
          printf("  -ml <max_levels>        : Max number of braid levels \n");
          printf("  -num  <nrelax>          : Num F-C relaxations\n");
          printf("  -nuc <nrelaxc>          : Num F-C relaxations on coarsest grid\n");
+         printf("  -direct                 : Direct solve on coarsest grid (with -ml 1, of the whole problem)\n");
          printf("  -mi <maxiter>           : Max iterations \n");
          printf("  -cf <cfactor>           : Coarsening factor \n");
          printf("  -tol <tol>              : Stopping tolerance \n");
@@ -799,6 +801,11 @@ main(int argc, char *argv[])
          arg_index++;
          nrelaxc = atoi(argv[arg_index++]);
       }
+      else if ( strcmp(argv[arg_index], "-direct") == 0 )
+      {
+         arg_index++;
+         direct = 1;
+      }
       else if ( strcmp(argv[arg_index], "-mi") == 0 )
       {
          arg_index++;
@@ -894,6 +901,7 @@ main(int argc, char *argv[])
    braid_SetPrintLevel( core, print_level);       
    braid_SetMaxIter(core, maxiter);
    braid_SetAbsTol(core, tol);
+   braid_SetTriDirect(core, direct);
 
    /* Parallel-in-time TriMGRIT simulation */
    start=clock();
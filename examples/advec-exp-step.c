@@ -83,6 +83,7 @@ typedef struct _braid_App_struct
 typedef struct _braid_Vector_struct
 {
    double *values;
+   double  edge[4];      /* Old end values, kept by my_StepBegin for my_StepFinish */
 } my_Vector;
 
 void
@@ -144,6 +145,79 @@ my_Step(braid_App        app,
    return 0;
 }
 
+/* The step split in two for braid_SetStepAsync (option -async).  Begin updates
+ * the interior points, and Finish the two end points, which in a code
+ * distributed in space would be the ones waiting on neighbor data.  Together
+ * they compute exactly what my_Step does, which XBraid still uses outside of
+ * F- and C-relaxation. */
+
+int
+my_StepBegin(braid_App        app,
+             braid_Vector     ustop,
+             braid_Vector     fstop,
+             braid_Vector     u,
+             braid_StepStatus status)
+{
+   double tstart;             /* current time */
+   double tstop;              /* evolve to this time*/
+   braid_StepStatusGetTstartTstop(status, &tstart, &tstop);
+   int mspace = (app->mspace);
+   double nu = (app->nu);
+   double dx = 1.0/(mspace-1);
+   double dt = tstop - tstart;
+
+   double A = ((dt*nu)/(dx*dx)) + (dt/(2*dx));
+   double B = 1 - ((2*nu*dt)/(dx*dx));
+   double C = (dt*nu)/(dx*dx) - (dt/(2*dx));
+   (u->edge)[0] = (u->values)[0];
+   (u->edge)[1] = (u->values)[1];
+   (u->edge)[2] = (u->values)[mspace-2];
+   (u->edge)[3] = (u->values)[mspace-1];
+
+   for (int i = 1; i <= mspace - 2; i++)
+   {
+     (u->values)[i] = A*(u->values)[i-1] + B*(u->values)[i] + C*(u->values)[i+1];
+   }
+
+   return 0;
+}
+
+int
+my_StepPoll(braid_App        app,
+            braid_Vector     u,
+            braid_StepStatus status,
+            braid_Int       *done_ptr)
+{
+   /* Nothing to wait on here, a real code would call MPI_Testall */
+   *done_ptr = 1;
+
+   return 0;
+}
+
+int
+my_StepFinish(braid_App        app,
+              braid_Vector     u,
+              braid_StepStatus status)
+{
+   double tstart;             /* current time */
+   double tstop;              /* evolve to this time*/
+   braid_StepStatusGetTstartTstop(status, &tstart, &tstop);
+   int mspace = (app->mspace);
+   double nu = (app->nu);
+   double dx = 1.0/(mspace-1);
+   double dt = tstop - tstart;
+
+   double A = ((dt*nu)/(dx*dx)) + (dt/(2*dx));
+   double B = 1 - ((2*nu*dt)/(dx*dx));
+   double C = (dt*nu)/(dx*dx) - (dt/(2*dx));
+
+   /* Deal with the u_1 and u_M vectors seperately */
+   (u->values)[0] = B*(u->edge)[0] + C*(u->edge)[1];
+   (u->values)[mspace-1] = A*(u->edge)[2] + B*(u->edge)[3];
+
+   return 0;
+}
+
 int
 my_Init(braid_App     app,
         double        t,
@@ -407,7 +481,7 @@ my_BufSize(braid_App           app,
            int                 *size_ptr,
            braid_BufferStatus  bstatus)
 {
-   *size_ptr = 2*sizeof(double);
+   *size_ptr = (app->mspace)*sizeof(double);
    return 0;
 }
 
@@ -428,7 +502,7 @@ my_BufPack(braid_App           app,
       dbuffer[i] = (u->values)[i];
    }
 
-   braid_BufferStatusSetSize( bstatus,  2*sizeof(double));
+   braid_BufferStatusSetSize( bstatus,  mspace*sizeof(double));
 
    return 0;
 }
@@ -448,7 +522,7 @@ my_BufUnpack(braid_App           app,
 
    /* Allocate memory */
    u = (my_Vector *) malloc(sizeof(my_Vector));
-   u->values = (double*) malloc( 2*sizeof(double) );
+   u->values = (double*) malloc( mspace*sizeof(double) );
 
    /* Unpack the buffer */
    for(i = 0; i < mspace; i++)
@@ -472,7 +546,7 @@ int main (int argc, char *argv[])
    int         rank, ntime, mspace, arg_index;
    double      alpha, nu;
    int         max_levels, min_coarse, nrelax, nrelaxc, cfactor, maxiter;
-   int         access_level, print_level;
+   int         access_level, print_level, async;
    double      tol;
 
    /* Initialize MPI */
@@ -496,6 +570,7 @@ int main (int argc, char *argv[])
    tol            = 1.0e-6;
    access_level   = 2;
    print_level    = 2;
+   async          = 0;
 
    max_levels     = 30;
    min_coarse     = 1;
@@ -531,6 +606,7 @@ int main (int argc, char *argv[])
          printf("  -tol <tol>              : Stopping tolerance \n");
          printf("  -access <access_level>  : Braid access level \n");
          printf("  -print <print_level>    : Braid print level \n");
+         printf("  -async                  : Take the relaxation steps with braid_SetStepAsync \n");
          exit(1);
       }
       else if ( strcmp(argv[arg_index], "-ntime") == 0 )
@@ -598,6 +674,11 @@ int main (int argc, char *argv[])
          arg_index++;
          print_level = atoi(argv[arg_index++]);
       }
+      else if ( strcmp(argv[arg_index], "-async") == 0 )
+      {
+         arg_index++;
+         async = 1;
+      }
       else
       {
          printf("ABORTING: incorrect command line parameter %s\n", argv[arg_index]);
@@ -639,6 +720,10 @@ int main (int argc, char *argv[])
    braid_SetMaxLevels(core, max_levels);
    braid_SetAbsTol(core, 1.0e-06);
    braid_SetCFactor(core, -1, 2);
+   if (async)
+   {
+      braid_SetStepAsync(core, my_StepBegin, my_StepPoll, my_StepFinish);
+   }
    
    /* Run simulation, and then clean up */
    braid_Drive(core);
@@ -653,6 +738,10 @@ int main (int argc, char *argv[])
          for (i = 0; i < (app->ntime); i++)
          {
             double **w = (app->w);
+            if (w[i] == NULL)
+            {
+               continue;  /* time point stored on another processor */
+            }
             fprintf(file, "%05d: ", (i+1));
             for(j=0; j <mspace; j++){
                if(j==mspace-1){
@@ -1096,6 +1096,27 @@ main(int argc, char *argv[])
       fclose(file);
    }   
 
+   /**********************PRINT BENCHMARK RECORD OUT**********************/
+   /* Same one-line JSON record as braid_SetBenchFile(), for the harness in bench/ */
+   if (getenv("BRAID_BENCH_FILE") != NULL)
+   {
+      file = fopen(getenv("BRAID_BENCH_FILE"), "a");
+      fprintf(file, "{\"ntime\": %d, \"nprocs\": 1, \"nlevels\": 1, \"cfactor\": 1,"
+              " \"trimgrit\": 0, \"niter\": %d,", ntime, (int) niters);
+      if (isinf(norm)||isnan(norm))
+      {
+         fprintf(file, " \"rnorm\": null,");
+      }
+      else
+      {
+         fprintf(file, " \"rnorm\": %1.6e,", norm);
+      }
+      fprintf(file, " \"tol\": %1.6e, \"converged\": %d, \"time\": %1.6e, \"phases\": {}}\n",
+              tol, (norm <= tol), time);
+      fflush(file);
+      fclose(file);
+   }
+
    /**********************PRINT U0 OUT**********************/
    char filename1[255];
    double *us;
@@ -0,0 +1,159 @@
+!BHEADER**********************************************************************
+! Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+! Produced at the Lawrence Livermore National Laboratory. Written by
+! Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+! Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+!
+! This file is part of XBraid. For support, post issues to the XBraid Github page.
+!
+! This program is free software; you can redistribute it and/or modify it under
+! the terms of the GNU General Public License (as published by the Free Software
+! Foundation) version 2.1 dated February 1999.
+!
+! This program is distributed in the hope that it will be useful, but WITHOUT ANY
+! WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+! PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+! License for more details.
+!
+! You should have received a copy of the GNU Lesser General Public License along
+! with this program; if not, write to the Free Software Foundation, Inc., 59
+! Temple Place, Suite 330, Boston, MA 02111-1307 USA
+!
+!EHEADER**********************************************************************
+
+!
+! Example:       ex-01-f03.f90
+!
+! Interface:     Fortran 2003 (braid/braid_mod.f90)
+!
+! Requires:      Fortran 2003 compiler
+!
+! Compile with:  make ex-01-f03
+!
+! Description:   solve the decoupled scalar ODEs
+!
+!                   u_i' = lambda_i u_i,  u_i(0) = 1,  lambda_i = -(i)/nvalues
+!
+!                for i = 1, ..., nvalues with backward Euler.  XBraid owns the
+!                vectors and the user code only writes step, init and access
+!                on plain arrays.
+!
+!                Run with:  mpirun -np 2 ex-01-f03 [nvalues [ntime [max_levels]]]
+!
+
+module ex01_f03_app
+
+   use iso_c_binding
+   use braid_mod
+   implicit none
+
+   type my_app
+      real(c_double), allocatable :: lambda(:)
+      integer                     :: rank
+   end type my_app
+
+contains
+
+   subroutine my_step(app, tstart, tstop, u, status)
+      type(c_ptr),    intent(in)    :: app
+      real(c_double), intent(in)    :: tstart, tstop
+      real(c_double), intent(inout) :: u(:)
+      type(c_ptr),    intent(in)    :: status
+
+      type(my_app), pointer :: a
+
+      call c_f_pointer(app, a)
+      ! Backward Euler
+      u = u / (1.0d0 - (tstop - tstart)*a%lambda)
+   end subroutine my_step
+
+   subroutine my_init(app, t, u)
+      type(c_ptr),    intent(in)    :: app
+      real(c_double), intent(in)    :: t
+      real(c_double), intent(out)   :: u(:)
+
+      if (t == 0.0d0) then
+         u = 1.0d0
+      else
+         u = 0.456d0
+      end if
+   end subroutine my_init
+
+   subroutine my_access(app, t, u, status)
+      type(c_ptr),    intent(in)    :: app
+      real(c_double), intent(in)    :: t
+      real(c_double), intent(in)    :: u(:)
+      type(c_ptr),    intent(in)    :: status
+
+      type(my_app), pointer :: a
+      integer(c_int)        :: done
+
+      call c_f_pointer(app, a)
+      call braid_AccessStatusGetDone(status, done)
+      if ((done == 1) .and. (t == 1.0d0)) then
+         write(*,'(a,es23.15)') '  ||u(1)|| = ', sqrt(sum(u*u))
+      end if
+   end subroutine my_access
+
+end module ex01_f03_app
+
+
+program ex01_f03
+
+   use mpi
+   use iso_c_binding
+   use braid_mod
+   use ex01_f03_app
+   implicit none
+
+   type(my_app), target :: app
+   type(c_ptr)          :: core
+   integer              :: nvalues, ntime, max_levels, i, ierr
+   integer(c_int)       :: niter
+   character(len=32)    :: arg
+
+   nvalues    = 1000
+   ntime      = 1024
+   max_levels = 3
+   if (command_argument_count() >= 1) then
+      call get_command_argument(1, arg)
+      read(arg,*) nvalues
+   end if
+   if (command_argument_count() >= 2) then
+      call get_command_argument(2, arg)
+      read(arg,*) ntime
+   end if
+   if (command_argument_count() >= 3) then
+      call get_command_argument(3, arg)
+      read(arg,*) max_levels
+   end if
+
+   call MPI_Init(ierr)
+   call MPI_Comm_rank(MPI_COMM_WORLD, app%rank, ierr)
+
+   allocate(app%lambda(nvalues))
+   do i = 1, nvalues
+      app%lambda(i) = -dble(i)/dble(nvalues)
+   end do
+
+   call braid_init_f03(MPI_COMM_WORLD, MPI_COMM_WORLD, 0.0d0, 1.0d0, ntime, c_loc(app), &
+         nvalues, my_step, my_init, my_access, core)
+
+   call braid_SetPrintLevel(core, 1)
+   call braid_SetMaxLevels(core, int(max_levels, c_int))
+   call braid_SetCFactor(core, -1, 2)
+   call braid_SetAbsTol(core, 1.0d-8)
+   call braid_SetMaxIter(core, 50)
+
+   call braid_Drive(core)
+
+   call braid_GetNumIter(core, niter)
+   if (app%rank == 0) then
+      write(*,'(a,i4)') '  iterations = ', niter
+   end if
+
+   call braid_destroy_f03(core)
+   deallocate(app%lambda)
+   call MPI_Finalize(ierr)
+
+end program ex01_f03
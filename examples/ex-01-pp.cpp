@@ -0,0 +1,299 @@
+//BHEADER**********************************************************************
+// Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. Written by
+// Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+// Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+//
+// This file is part of XBraid. For support, post issues to the XBraid Github page.
+//
+// This program is free software; you can redistribute it and/or modify it under
+// the terms of the GNU General Public License (as published by the Free Software
+// Foundation) version 2.1 dated February 1999.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+// License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc., 59
+// Temple Place, Suite 330, Boston, MA 02111-1307 USA
+//
+//EHEADER**********************************************************************
+
+//
+// Example:       ex-01-pp.cpp
+//
+// Interface:     C++, through the templated BraidCoreT of braid.hpp
+//
+// Requires:      C++-language support
+//
+// Compile with:  make ex-01-pp
+//
+// Help with:     ex-01-pp -help
+//
+// Sample run:    mpirun -np 2 ex-01-pp
+//
+// Description:   solve the scalar ODE
+//                   u' = lambda u,
+//                   with lambda=-1 and y(0) = 1
+//                with backward Euler, as ex-01.c does, but with the App and
+//                vector types given to BraidCoreT at compile time.  The
+//                callbacks call the (non-virtual) members of MyApp and
+//                MyVector directly.  Option -pool recycles the vectors freed
+//                by XBraid with a BraidVectorPool, keeping at most the given
+//                number of them.
+//
+//                When run with the default 10 time steps, the solution is:
+//                $ ./ex-01-pp
+//                $ cat ex-01-pp.out.00*
+//                  1.00000000000000e+00
+//                  6.66666666666667e-01
+//                  4.44444444444444e-01
+//                  2.96296296296296e-01
+//                  1.97530864197531e-01
+//                  1.31687242798354e-01
+//                  8.77914951989026e-02
+//                  5.85276634659351e-02
+//                  3.90184423106234e-02
+//                  2.60122948737489e-02
+//                  1.73415299158326e-02
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "braid.hpp"
+
+// --------------------------------------------------------------------------
+// User-defined routines and objects
+// --------------------------------------------------------------------------
+
+class MyApp;
+
+// The vector is a plain value type, BraidCoreT holds it as a MyVector*
+class MyVector
+{
+public:
+   double value;
+
+   MyVector(double value_) : value(value_) { }
+
+   static braid_Int BufSize(MyApp &app, BraidBufferStatus &bstatus)
+   {
+      return sizeof(double);
+   }
+
+   braid_Int BufPack(void *buffer, BraidBufferStatus &bstatus) const
+   {
+      double *dbuffer = (double *) buffer;
+
+      dbuffer[0] = value;
+      bstatus.SetSize(sizeof(double));
+
+      return 0;
+   }
+
+   static MyVector BufUnpack(MyApp &app, void *buffer, BraidBufferStatus &bstatus)
+   {
+      double *dbuffer = (double *) buffer;
+
+      return MyVector(dbuffer[0]);
+   }
+};
+
+// The App needs no base class, only the members that BraidCoreT calls
+class MyApp
+{
+public:
+   // Used by BraidCoreT
+   MPI_Comm     comm_t;
+   braid_Real   tstart;
+   braid_Real   tstop;
+   braid_Int    ntime;
+
+   int          rank;
+
+   MyApp(MPI_Comm comm_t_, int rank_, double tstart_, double tstop_, int ntime_)
+      : comm_t(comm_t_), tstart(tstart_), tstop(tstop_), ntime(ntime_), rank(rank_) { }
+
+   braid_Int Step(MyVector &u, MyVector *ustop, MyVector *fstop,
+                  BraidStepStatus &pstatus)
+   {
+      double tstart_, tstop_;
+      pstatus.GetTstartTstop(&tstart_, &tstop_);
+
+      // Use backward Euler to propagate solution
+      u.value = 1./(1. + tstop_ - tstart_)*u.value;
+
+      return 0;
+   }
+
+   MyVector Init(braid_Real t)
+   {
+      if (t == tstart)
+      {
+         // Initial condition
+         return MyVector(1.0);
+      }
+      // All other time points set to arbitrary value
+      return MyVector(0.456);
+   }
+
+   MyVector Clone(const MyVector &u) { return MyVector(u.value); }
+
+   braid_Int Sum(braid_Real alpha, const MyVector &x, braid_Real beta, MyVector &y)
+   {
+      y.value = alpha*x.value + beta*y.value;
+      return 0;
+   }
+
+   braid_Real SpatialNorm(const MyVector &u) { return fabs(u.value); }
+
+   braid_Int Access(const MyVector &u, BraidAccessStatus &astatus)
+   {
+      char       filename[255];
+      FILE      *file;
+      braid_Int  index;
+
+      // Print solution to file
+      astatus.GetTIndex(&index);
+      sprintf(filename, "%s.%04d.%03d", "ex-01-pp.out", index, rank);
+      file = fopen(filename, "w");
+      fprintf(file, "%.14e\n", u.value);
+      fflush(file);
+      fclose(file);
+
+      return 0;
+   }
+};
+
+// Set the options of a BraidCoreT and run XBraid
+template <class Core>
+void
+RunBraid(Core &core, int max_levels, int min_coarse, int cfactor, int maxiter)
+{
+   core.SetPrintLevel(2);
+   core.SetMaxLevels(max_levels);
+   core.SetMinCoarse(min_coarse);
+   core.SetCFactor(-1, cfactor);
+   core.SetMaxIter(maxiter);
+   core.SetAbsTol(1.0e-06);
+
+   core.Drive();
+}
+
+// --------------------------------------------------------------------------
+// Main driver
+// --------------------------------------------------------------------------
+
+int main (int argc, char *argv[])
+{
+   double      tstart, tstop;
+   int         ntime, rank, arg_index;
+   int         max_levels, min_coarse, cfactor, maxiter, pool;
+
+   // Define time domain: ntime intervals
+   ntime  = 10;
+   tstart = 0.0;
+   tstop  = tstart + ntime/2.;
+
+   max_levels = 2;
+   min_coarse = 2;
+   cfactor    = 2;
+   maxiter    = 100;
+   pool       = -1;
+
+   // Initialize MPI
+   MPI_Init(&argc, &argv);
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   // Parse command line
+   arg_index = 1;
+   while (arg_index < argc)
+   {
+      if ( strcmp(argv[arg_index], "-help") == 0 )
+      {
+         if (rank == 0)
+         {
+            printf("\n");
+            printf(" Solves u' = -u, u(0) = 1 with backward Euler and BraidCoreT\n\n");
+            printf("  -ntime <ntime>       : set num time points (default %d)\n", ntime);
+            printf("  -ml    <max_levels>  : set max levels (default %d)\n", max_levels);
+            printf("  -mc    <min_coarse>  : set min possible coarse level size (default %d)\n", min_coarse);
+            printf("  -cf    <cfactor>     : set coarsening factor (default %d)\n", cfactor);
+            printf("  -mi    <max_iter>    : set max iterations (default %d)\n", maxiter);
+            printf("  -pool  <max_free>    : recycle freed vectors with a BraidVectorPool,\n");
+            printf("                         keeping at most max_free of them\n");
+            printf("\n");
+         }
+         MPI_Finalize();
+         return (0);
+      }
+      else if ( strcmp(argv[arg_index], "-ntime") == 0 )
+      {
+         arg_index++;
+         ntime = atoi(argv[arg_index++]);
+         tstop = tstart + ntime/2.;
+      }
+      else if ( strcmp(argv[arg_index], "-ml") == 0 )
+      {
+         arg_index++;
+         max_levels = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-mc") == 0 )
+      {
+         arg_index++;
+         min_coarse = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-cf") == 0 )
+      {
+         arg_index++;
+         cfactor = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-mi") == 0 )
+      {
+         arg_index++;
+         maxiter = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-pool") == 0 )
+      {
+         arg_index++;
+         pool = atoi(argv[arg_index++]);
+      }
+      else
+      {
+         if (rank == 0)
+         {
+            printf("ABORTING: incorrect command line parameter %s\n", argv[arg_index]);
+         }
+         MPI_Finalize();
+         return (0);
+      }
+   }
+
+   // Set up the app and run XBraid.  Each core is destroyed at the end of its
+   // block, before MPI_Finalize.
+   MyApp app(MPI_COMM_WORLD, rank, tstart, tstop, ntime);
+   if (pool >= 0)
+   {
+      BraidCoreT< MyApp, MyVector, BraidVectorPool<MyVector> > core(MPI_COMM_WORLD, &app);
+      core.GetAllocator().SetMaxFree(pool);
+      RunBraid(core, max_levels, min_coarse, cfactor, maxiter);
+      if (rank == 0)
+      {
+         printf("  pool free vectors     = %d\n", (int) core.GetAllocator().NumFree());
+      }
+   }
+   else
+   {
+      BraidCoreT<MyApp, MyVector> core(MPI_COMM_WORLD, &app);
+      RunBraid(core, max_levels, min_coarse, cfactor, maxiter);
+   }
+
+   MPI_Finalize();
+
+   return (0);
+}
@@ -61,11 +61,7 @@ typedef struct _braid_App_struct
    int      myid;        /* Rank of the processor */
    double   gamma;       /* Relaxation parameter for objective function */
    int      ntime;       /* Total number of time-steps (starting at time 0) */
-
-   int      ilower;      /* Lower index for my proc */
-   int      iupper;      /* Upper index for my proc */
-   int      npoints;     /* Number of time points on my proc */
-   double **w;           /* Adjoint vectors at each time point on my proc */
+   double   dt;          /* Time step size */
 
 } my_App;
 
@@ -459,35 +455,31 @@ my_SpatialNorm(braid_App     app,
 /*------------------------------------*/
 
 int
-my_Access(braid_App          app,
-          braid_Vector       u,
-          braid_AccessStatus astatus)
+my_InnerProd(braid_App     app,
+             braid_Vector  u,
+             braid_Vector  v,
+             double       *prod_ptr)
 {
-   int   done, index, ii;
-
-   /* Print solution to file if simulation is over */
-   braid_AccessStatusGetDone(astatus, &done);
+   int i;
+   double dot = 0.0;
 
-   if (done)
+   for (i = 0; i < 2; i++)
    {
-      braid_AccessStatusGetILowerUpper(astatus, &(app->ilower), &(app->iupper));
-      (app->npoints) = (app->iupper) - (app->ilower) + 1;
+      dot += (u->values)[i]*(v->values)[i];
+   }
+   *prod_ptr = dot;
 
-      /* Allocate w array in app */
-      if ((app->w) == NULL)
-      {
-         (app->w) = (double **) calloc((app->npoints), sizeof(double *));
-      }
+   return 0;
+}
 
-      braid_AccessStatusGetTIndex(astatus, &index);
-      ii = index - (app->ilower);
-      if (app->w[ii] != NULL)
-      {
-         free(app->w[ii]);
-      }
-      vec_create(2, &(app->w[ii]));
-      vec_copy(2, (u->values), (app->w[ii]));
-   }
+/*------------------------------------*/
+
+int
+my_Access(braid_App          app,
+          braid_Vector       u,
+          braid_AccessStatus astatus)
+{
+   /* The finest grid goes to my_AccessBulk, this only sees coarse levels */
 
 //   {
 //      char  filename[255];
@@ -508,6 +500,97 @@ my_Access(braid_App          app,
 
 /*------------------------------------*/
 
+/* Print the adjoint w, state u and control v to file when XBraid is done.  All
+ * local adjoint vectors arrive in one call, in time order. */
+int
+my_AccessBulk(braid_App           app,
+              braid_Int           nvectors,
+              braid_Vector       *w,
+              braid_Real         *t,
+              braid_Int          *idx,
+              braid_AccessStatus  astatus)
+{
+   double  dt = (app->dt);
+   char    filename[255];
+   FILE   *file;
+   int     done, i, index;
+
+   braid_AccessStatusGetDone(astatus, &done);
+   if (!done)
+   {
+      return 0;
+   }
+
+   /* Print adjoint w to file */
+   {
+      sprintf(filename, "%s.%03d", "out/ex-04-omgrit.out.w", (app->myid));
+      file = fopen(filename, "w");
+      for (i = 0; i < nvectors; i++)
+      {
+         index = idx[i] + 1;
+         fprintf(file, "%05d: % 1.14e, % 1.14e\n", index, (w[i]->values)[0], (w[i]->values)[1]);
+      }
+      fflush(file);
+      fclose(file);
+   }
+
+   /* Compute state u from adjoint w and print to file */
+   /* ZTODO: This requires communication to do correctly */
+   {
+      double *u;
+
+      sprintf(filename, "%s.%03d", "out/ex-04-omgrit.out.u", (app->myid));
+      file = fopen(filename, "w");
+      vec_create(2, &u);
+      for (i = 0; i < nvectors; i++)
+      {
+         if ((i+1) < nvectors)
+         {
+            vec_copy(2, (w[i+1]->values), u);
+            apply_PhiAdjoint(dt, u);
+            vec_axpy(2, -1.0, (w[i]->values), u);
+         }
+         else
+         {
+            vec_copy(2, (w[i]->values), u);
+            vec_scale(2, -1.0, u);
+         }
+         apply_Uinv(dt, u);
+
+         index = idx[i] + 1;
+         fprintf(file, "%05d: % 1.14e, % 1.14e\n", index, u[0], u[1]);
+      }
+      vec_destroy(u);
+      fflush(file);
+      fclose(file);
+   }
+
+   /* Compute control v from adjoint w and print to file */
+   {
+      double *v;
+
+      sprintf(filename, "%s.%03d", "out/ex-04-omgrit.out.v", (app->myid));
+      file = fopen(filename, "w");
+      vec_create(2, &v);
+      for (i = 0; i < nvectors; i++)
+      {
+         apply_DAdjoint(dt, (w[i]->values), v);
+         vec_scale(1, -1.0, v);
+         apply_Vinv(dt, (app->gamma), v);
+
+         index = idx[i] + 1;
+         fprintf(file, "%05d: % 1.14e\n", index, v[0]);
+      }
+      vec_destroy(v);
+      fflush(file);
+      fclose(file);
+   }
+
+   return 0;
+}
+
+/*------------------------------------*/
+
 int
 my_BufSize(braid_App           app,
            int                 *size_ptr,
@@ -578,9 +661,11 @@ main(int argc, char *argv[])
 
    int         rank, ntime, arg_index;
    double      gamma;
-   int         max_levels, min_coarse, nrelax, nrelaxc, cfactor, maxiter;
+   int         max_levels, min_coarse, nrelax, nrelaxc, cfactor, maxiter, direct;
+   int         anderson_dim, anderson_ortho;
    int         access_level, print_level;
    double      tol;
+   char       *wckpfile, *rckpfile;
 
    /* Initialize MPI */
    MPI_Init(&argc, &argv);
@@ -599,11 +684,16 @@ main(int argc, char *argv[])
    min_coarse     = 1;
    nrelax         = 1;
    nrelaxc        = 7;
+   direct         = 0;
+   anderson_dim   = 0;
+   anderson_ortho = 0;
    maxiter        = 20;
    cfactor        = 2;
    tol            = 1.0e-6;
    access_level   = 1;
    print_level    = 2;
+   wckpfile       = NULL;
+   rckpfile       = NULL;
 
    /* Parse command line */
    arg_index = 1;
@@ -621,11 +711,15 @@ main(int argc, char *argv[])
          printf("  -ml <max_levels>        : Max number of braid levels \n");
          printf("  -nu  <nrelax>           : Num F-C relaxations\n");
          printf("  -nuc <nrelaxc>          : Num F-C relaxations on coarsest grid\n");
+         printf("  -direct                 : Direct solve on coarsest grid (with -ml 1, of the whole problem)\n");
+         printf("  -anderson <kdim> <ortho>: Anderson acceleration over the last kdim cycles, Gram-Schmidt variant ortho\n");
          printf("  -mi <maxiter>           : Max iterations \n");
          printf("  -cf <cfactor>           : Coarsening factor \n");
          printf("  -tol <tol>              : Stopping tolerance \n");
          printf("  -access <access_level>  : Braid access level \n");
          printf("  -print <print_level>    : Braid print level \n");
+         printf("  -wckp <file>            : Write a checkpoint when done\n");
+         printf("  -rckp <file>            : Continue from a checkpoint\n");
          exit(1);
       }
       else if ( strcmp(argv[arg_index], "-ntime") == 0 )
@@ -653,6 +747,27 @@ main(int argc, char *argv[])
          arg_index++;
          nrelaxc = atoi(argv[arg_index++]);
       }
+      else if ( strcmp(argv[arg_index], "-direct") == 0 )
+      {
+         arg_index++;
+         direct = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-anderson") == 0 )
+      {
+         arg_index++;
+         anderson_dim   = atoi(argv[arg_index++]);
+         anderson_ortho = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-wckp") == 0 )
+      {
+         arg_index++;
+         wckpfile = argv[arg_index++];
+      }
+      else if ( strcmp(argv[arg_index], "-rckp") == 0 )
+      {
+         arg_index++;
+         rckpfile = argv[arg_index++];
+      }
       else if ( strcmp(argv[arg_index], "-mi") == 0 )
       {
          arg_index++;
@@ -694,13 +809,14 @@ main(int argc, char *argv[])
    app->myid     = rank;
    app->ntime    = ntime;
    app->gamma    = gamma;
-   app->w        = NULL;
+   app->dt       = dt;
 
    /* Initialize XBraid */
    braid_InitTriMGRIT(MPI_COMM_WORLD, MPI_COMM_WORLD, dt, tstop, ntime-1, app,
                       my_TriResidual, my_TriSolve, my_Init, my_Clone, my_Free,
                       my_Sum, my_SpatialNorm, my_Access,
                       my_BufSize, my_BufPack, my_BufUnpack, &core);
+   braid_SetAccessBulk(core, my_AccessBulk);
 
    /* Set some XBraid(_Adjoint) parameters */
    braid_SetMaxLevels(core, max_levels);
@@ -715,35 +831,31 @@ main(int argc, char *argv[])
    braid_SetPrintLevel( core, print_level);       
    braid_SetMaxIter(core, maxiter);
    braid_SetAbsTol(core, tol);
+   braid_SetTriDirect(core, direct);
+   if (anderson_dim > 0)
+   {
+      braid_SetAnderson(core, anderson_dim, anderson_ortho, my_InnerProd);
+   }
 
    /* Parallel-in-time TriMGRIT simulation */
    start=clock();
+   if (rckpfile != NULL)
+   {
+      braid_ReadCheckpoint(core, rckpfile);
+   }
    braid_Drive(core);
+   if (wckpfile != NULL)
+   {
+      braid_WriteCheckpoint(core, wckpfile);
+   }
    end=clock();
 
    time = (double)(end-start)/CLOCKS_PER_SEC;
 
+   /* The adjoint w, state u and control v were printed by my_AccessBulk */
    if (access_level > 0)
    {
-      char  filename[255];
-      FILE *file;
-      int   i, index;
-
-      /* Print adjoint w to file */
       printf("Total Run Time: %f s \n", time);
-      {
-         sprintf(filename, "%s.%03d", "out/ex-04-omgrit.out.w", (app->myid));
-         file = fopen(filename, "w");
-         for (i = 0; i < (app->npoints); i++)
-         {
-            double **w = (app->w);
-
-            index = (app->ilower) + i + 1;
-            fprintf(file, "%05d: % 1.14e, % 1.14e\n", index, w[i][0], w[i][1]);
-         }
-         fflush(file);
-         fclose(file);
-      }
 
       time = (double)(end-start)/CLOCKS_PER_SEC;
 
@@ -757,70 +869,6 @@ main(int argc, char *argv[])
             fflush(file);
             fclose(file);
          }
-
-
-      /* Compute state u from adjoint w and print to file */
-      /* ZTODO: This requires communication to do correctly */
-      {
-         double *u;
-
-         sprintf(filename, "%s.%03d", "out/ex-04-omgrit.out.u", (app->myid));
-         file = fopen(filename, "w");
-         vec_create(2, &u);
-         for (i = 0; i < (app->npoints); i++)
-         {
-            double **w = (app->w);
-
-            if ((i+1) < (app->npoints))
-            {
-               vec_copy(2, w[i+1], u);
-               apply_PhiAdjoint(dt, u);
-               vec_axpy(2, -1.0, w[i], u);
-            }
-            else
-            {
-               vec_copy(2, w[i], u);
-               vec_scale(2, -1.0, u);
-            }
-            apply_Uinv(dt, u);
-
-            index = (app->ilower) + i + 1;
-            fprintf(file, "%05d: % 1.14e, % 1.14e\n", index, u[0], u[1]);
-         }
-         vec_destroy(u);
-         fflush(file);
-         fclose(file);
-      }
-
-      /* Compute control v from adjoint w and print to file */
-      {
-         double *v;
-
-         sprintf(filename, "%s.%03d", "out/ex-04-omgrit.out.v", (app->myid));
-         file = fopen(filename, "w");
-         vec_create(2, &v);
-         for (i = 0; i < (app->npoints); i++)
-         {
-            double **w = (app->w);
-
-            apply_DAdjoint(dt, w[i], v);
-            vec_scale(1, -1.0, v);
-            apply_Vinv(dt, (app->gamma), v);
-
-            index = (app->ilower) + i + 1;
-            fprintf(file, "%05d: % 1.14e\n", index, v[0]);
-         }
-         vec_destroy(v);
-         fflush(file);
-         fclose(file);
-
-         for (i = 0; i < (app->npoints); i++)
-         {
-            free(app->w[i]);
-         }
-         free(app->w);
-      }
-
    }
 
    free(app);
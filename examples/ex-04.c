@@ -406,6 +406,7 @@ int main (int argc, char *argv[])
    double  *gradient; 
    double   objective, gamma, stepsize, mygnorm, gnorm, gtol, rnorm, rnorm_adj;
    int      max_levels, cfactor, access_level, print_level, braid_maxiter;
+   int      reuse;
    double   braid_tol, braid_adjtol;
 
    /* Define time domain */
@@ -427,6 +428,7 @@ int main (int argc, char *argv[])
    braid_adjtol   = 1.0e-6;
    access_level   = 1;
    print_level    = 0;
+   reuse          = 1;
    
    start = clock();
 
@@ -453,6 +455,7 @@ int main (int argc, char *argv[])
          printf("  -batol <braid_adjtol>   : Braid adjoint halting tolerance \n");
          printf("  -access <access_level>  : Braid access level \n");
          printf("  -print <print_level>    : Braid print level \n");
+         printf("  -reuse <reuse>          : Start each optimization iteration from the previous solution (1, default) or init (0)\n");
          exit(1);
       }
       else if ( strcmp(argv[arg_index], "-ntime") == 0 )
@@ -515,6 +518,11 @@ int main (int argc, char *argv[])
          arg_index++;
          print_level = atoi(argv[arg_index++]);
       }
+      else if ( strcmp(argv[arg_index], "-reuse") == 0 )
+      {
+         arg_index++;
+         reuse = atoi(argv[arg_index++]);
+      }
       else
       {
          printf("ABORTING: incorrect command line parameter %s\n", argv[arg_index]);
@@ -557,6 +565,7 @@ int main (int argc, char *argv[])
    braid_SetMaxIter(core, braid_maxiter);
    braid_SetAbsTol(core, braid_tol);
    braid_SetAbsTolAdjoint(core, braid_adjtol);
+   braid_SetReuseSolution(core, reuse);
 
    /* Prepare optimization output */
    if (rank == 0)
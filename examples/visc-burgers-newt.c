@@ -81,6 +81,16 @@ typedef struct _braid_Vector_struct
   double **values;     /* Holds the R^M state vector (u_1, u_2,...,u_M) for ui vi and wi*/
 } my_Vector;
 
+/* Linearization of the Newton step at one time-step (see braid_SetTriNewton) */
+typedef struct
+{
+  double *u;                  /* State u the step is linearized about */
+  double *w;                  /* Adjoint w the step is linearized about */
+  double *Ba, *Bl, *Bb;       /* LU factorization of B */
+  double *BTa, *BTl, *BTb;    /* LU factorization of B^T */
+  double *Ca, *Cl, *Cb;       /* LU factorization of C */
+} my_Lin;
+
 /*--------------------------------------------------------------------------
  * Vector utility routines
  *--------------------------------------------------------------------------*/
@@ -139,15 +149,12 @@ vec_scale(int size, double alpha, double *x)
  *--------------------------------------------------------------------------*/
 
 /* B inverse and C inverse are actually the inverses of (A + gamma*B^n) and (dx*dt + gamma*C^n) 
- * as required in the solve */
+ * as required in the solve.  Each is a tridiagonal LU factorization (diagonal ai of U,
+ * superdiagonal bi of U, subdiagonal li of L) followed by a solve */
 
 void
-apply_B_inverse(double dt, double dx, double nu, int M, double *u, double *r)
+factor_B(double dt, double dx, double nu, int M, double *u, double *ai, double *li, double *bi)
 {   
-  /* Find LU decomposition */
-  double *ai = (double*) malloc( M*sizeof(double) );
-  double *li = (double*) malloc( (M-1)*sizeof(double) );
-  double *bi = (double*) malloc( (M-1)*sizeof(double) );
   ai[0] = 1+2*b(dt,dx,nu)+g(dt,dx)*u[1];
   for(int i=1; i<M-1; i++)
   {
@@ -158,40 +165,11 @@ apply_B_inverse(double dt, double dx, double nu, int M, double *u, double *r)
   bi[M-2] = -b(dt,dx,nu)-g(dt,dx)*u[M-1];
   li[M-2] = (-b(dt,dx,nu)+g(dt,dx)*u[M-2])/ai[M-2];
   ai[M-1] = 1+2*b(dt,dx,nu)-g(dt,dx)*u[M-2]-bi[M-2]*li[M-2];
-
-  /* Solve Lw=u (Lw=f) */
-  double *w;
-  vec_create(M, &w);
-  double *f;
-  vec_create(M, &f);
-  vec_copy(M, r, f);
-  w[0]=f[0];
-  for (int i = 1; i < M; i++)
-  {
-    w[i]=f[i]-li[i-1]*w[i-1];
-  }
-
-  /* Now solve Ux=w */ 
-  r[M-1]=w[M-1]/ai[M-1];
-  for (int i = M-2; i >= 0; i--)
-  {
-    r[i]=(w[i]-bi[i]*r[i+1])/ai[i];      
-  }
-
-  vec_destroy(w);
-  vec_destroy(f);
-  free(ai);
-  free(li);
-  free(bi);
 }
 
 void
-apply_B_transpose_inverse(double dt, double dx, double nu, int M, double *u, double *r)
+factor_B_transpose(double dt, double dx, double nu, int M, double *u, double *ai, double *li, double *bi)
 {
-  /* Find LU decomposition */
-  double *ai = (double*) malloc( M*sizeof(double) );
-  double *li = (double*) malloc( (M-1)*sizeof(double) );
-  double *bi = (double*) malloc( (M-1)*sizeof(double) );
   ai[0] = 1+2*b(dt,dx,nu)+g(dt,dx)*u[1];
   for(int i=1; i<M-1; i++)
   {
@@ -202,41 +180,11 @@ apply_B_transpose_inverse(double dt, double dx, double nu, int M, double *u, dou
   bi[M-2] = -b(dt,dx,nu)+g(dt,dx)*u[M-2];
   li[M-2] = (-b(dt,dx,nu)-g(dt,dx)*u[M-1])/ai[M-2];
   ai[M-1] = 1+2*b(dt,dx,nu)-g(dt,dx)*u[M-2]-bi[M-2]*li[M-2];
-
-  /* Solve Lw=u (Lw=f) */
-  double *w;
-  vec_create(M, &w);
-  double *f;
-  vec_create(M, &f);
-  vec_copy(M, r, f);
-  w[0]=f[0];
-  for (int i = 1; i < M; i++)
-  {
-    w[i]=f[i]-li[i-1]*w[i-1];
-  }
-
-  /* Now solve Ux=w */ 
-  r[M-1]=w[M-1]/ai[M-1];
-  for (int i = M-2; i >= 0; i--)
-  {
-    r[i]=(w[i]-bi[i]*r[i+1])/ai[i];      
-  }
-
-  vec_destroy(w);
-  vec_destroy(f);
-  free(ai);
-  free(li);
-  free(bi);
 }
 
 void
-apply_C_inverse(double dt, double dx, double nu, int M, double *u, double *r)
+factor_C(double dt, double dx, double nu, int M, double *u, double *ai, double *li, double *bi)
 {  
-  /* Find LU decomposition */
-  double *ai = (double*) malloc( M*sizeof(double) );
-  double *li = (double*) malloc( (M-1)*sizeof(double) );
-  double *bi = (double*) malloc( (M-1)*sizeof(double) );
-  
   ai[0] = dx*dt;
   for(int i=1; i<M; i++)
   {
@@ -244,7 +192,13 @@ apply_C_inverse(double dt, double dx, double nu, int M, double *u, double *r)
     li[i-1] = g(dt,dx)*(u[i-1]-u[i])/ai[i-1];
     ai[i] = dx*dt-g(dt,dx)*g(dt,dx)*(u[i-1]-u[i])*(u[i-1]-u[i])/ai[i-1];
   }
+}
 
+/* Solve LUx=r with a factorization from the routines above, overwriting r with x */
+
+void
+solve_LU(int M, double *ai, double *li, double *bi, double *r)
+{
   /* Solve Lw=u (Lw=f) */
   double *w;
   vec_create(M, &w);
@@ -266,6 +220,42 @@ apply_C_inverse(double dt, double dx, double nu, int M, double *u, double *r)
 
   vec_destroy(w);
   vec_destroy(f);
+}
+
+void
+apply_B_inverse(double dt, double dx, double nu, int M, double *u, double *r)
+{   
+  double *ai = (double*) malloc( M*sizeof(double) );
+  double *li = (double*) malloc( (M-1)*sizeof(double) );
+  double *bi = (double*) malloc( (M-1)*sizeof(double) );
+  factor_B(dt, dx, nu, M, u, ai, li, bi);
+  solve_LU(M, ai, li, bi, r);
+  free(ai);
+  free(li);
+  free(bi);
+}
+
+void
+apply_B_transpose_inverse(double dt, double dx, double nu, int M, double *u, double *r)
+{
+  double *ai = (double*) malloc( M*sizeof(double) );
+  double *li = (double*) malloc( (M-1)*sizeof(double) );
+  double *bi = (double*) malloc( (M-1)*sizeof(double) );
+  factor_B_transpose(dt, dx, nu, M, u, ai, li, bi);
+  solve_LU(M, ai, li, bi, r);
+  free(ai);
+  free(li);
+  free(bi);
+}
+
+void
+apply_C_inverse(double dt, double dx, double nu, int M, double *u, double *r)
+{  
+  double *ai = (double*) malloc( M*sizeof(double) );
+  double *li = (double*) malloc( (M-1)*sizeof(double) );
+  double *bi = (double*) malloc( (M-1)*sizeof(double) );
+  factor_C(dt, dx, nu, M, u, ai, li, bi);
+  solve_LU(M, ai, li, bi, r);
   free(ai);
   free(li);
   free(bi);
@@ -566,6 +556,8 @@ my_TriSolve(braid_App       app,
    double alpha = (app->alpha);
 
    double *dW, *dU, *dV, *storage1, *storage2, *storage3, *storageW;
+   double *ulin, *wlin;
+   my_Lin *lin;
    vec_create(mspace, &dW);
    vec_create(mspace, &dU);
    vec_create(mspace, &dV);
@@ -612,13 +604,24 @@ my_TriSolve(braid_App       app,
    vec_copy(mspace, u->values[1], r2);
    vec_copy(mspace, u->values[2], r3);
 
+   /* Linearize about the current u and w, or reuse the linearization kept by
+    * braid (Newton-TriMGRIT) */
+   braid_TriStatusGetLinearization(status, (void **) &lin);
+   ulin = storage1;
+   wlin = storage3;
+   if (lin != NULL)
+   {
+     ulin = lin->u;
+     wlin = lin->w;
+   }
 
    /*solve for deltaW*/
 
     vec_copy(mspace, r1, dW);
-    apply_C_inverse(dt,dx,nu,mspace,storage3,dW);
+    if (lin != NULL) solve_LU(mspace, lin->Ca, lin->Cl, lin->Cb, dW);
+    else apply_C_inverse(dt,dx,nu,mspace,wlin,dW);
     vec_copy(mspace, dW, utmp);
-    apply_B_transpose(dt,mspace,nu,dW,storage1);
+    apply_B_transpose(dt,mspace,nu,dW,ulin);
     vec_scale(mspace,g(dt,dx),dW);
     apply_A(dt,dx,nu,mspace,utmp);
     vec_axpy(mspace, 1.0, utmp, dW);
@@ -627,9 +630,11 @@ my_TriSolve(braid_App       app,
     vec_axpy(mspace, -1.0, r3, dW);
 
    //apply c_tilde inverse
-    apply_B_transpose_inverse(dt,dx,nu,mspace,storage1,dW);
-    apply_C(dt,dx,nu,mspace,storage3,dW);
-    apply_B_inverse(dt,dx,nu,mspace,storage1,dW);
+    if (lin != NULL) solve_LU(mspace, lin->BTa, lin->BTl, lin->BTb, dW);
+    else apply_B_transpose_inverse(dt,dx,nu,mspace,ulin,dW);
+    apply_C(dt,dx,nu,mspace,wlin,dW);
+    if (lin != NULL) solve_LU(mspace, lin->Ba, lin->Bl, lin->Bb, dW);
+    else apply_B_inverse(dt,dx,nu,mspace,ulin,dW);
 
     //update dU and dV based on dW
     //dV
@@ -639,7 +644,8 @@ my_TriSolve(braid_App       app,
     //dU
     vec_copy(mspace, r3, dU);
     vec_axpy(mspace, dt, dV, dU);
-    apply_B_transpose_inverse(dt,dx,nu,mspace,storage1,dU);
+    if (lin != NULL) solve_LU(mspace, lin->BTa, lin->BTl, lin->BTb, dU);
+    else apply_B_transpose_inverse(dt,dx,nu,mspace,ulin,dU);
 
 
    /* Complete update of solution */
@@ -672,6 +678,89 @@ my_TriSolve(braid_App       app,
 
 /*------------------------------------*/
 
+/* Linearize the Newton step of TriSolve about the current u and w, so that
+ * braid can reuse it in later solves */
+
+int
+my_TriLinearize(braid_App       app,
+                braid_Vector    uleft,
+                braid_Vector    uright,
+                braid_Vector    u,
+                braid_TriStatus status,
+                void          **lin_ptr)
+{
+   double  t, tprev, tnext, dt, dx;
+   int     mspace = (app->mspace);
+   double  nu = (app->nu);
+   my_Lin *lin = (my_Lin *) *lin_ptr;
+
+   /* Get the time-step size */
+   braid_TriStatusGetTriT(status, &t, &tprev, &tnext);
+   if (t < tnext)
+   {
+      dt = tnext - t;
+   }
+   else
+   {
+      dt = t - tprev;
+   }
+
+   /* Get the space-step size */
+   dx = 1/((double)(mspace+1));
+
+   if (lin == NULL)
+   {
+      lin = (my_Lin *) malloc(sizeof(my_Lin));
+      vec_create(mspace, &(lin->u));
+      vec_create(mspace, &(lin->w));
+      vec_create(mspace, &(lin->Ba));
+      vec_create(mspace-1, &(lin->Bl));
+      vec_create(mspace-1, &(lin->Bb));
+      vec_create(mspace, &(lin->BTa));
+      vec_create(mspace-1, &(lin->BTl));
+      vec_create(mspace-1, &(lin->BTb));
+      vec_create(mspace, &(lin->Ca));
+      vec_create(mspace-1, &(lin->Cl));
+      vec_create(mspace-1, &(lin->Cb));
+   }
+
+   vec_copy(mspace, u->values[0], lin->u);
+   vec_copy(mspace, u->values[2], lin->w);
+   factor_B(dt, dx, nu, mspace, lin->u, lin->Ba, lin->Bl, lin->Bb);
+   factor_B_transpose(dt, dx, nu, mspace, lin->u, lin->BTa, lin->BTl, lin->BTb);
+   factor_C(dt, dx, nu, mspace, lin->w, lin->Ca, lin->Cl, lin->Cb);
+
+   *lin_ptr = lin;
+
+   return 0;
+}
+
+/*------------------------------------*/
+
+int
+my_TriLinFree(braid_App  app,
+              void      *lin_)
+{
+   my_Lin *lin = (my_Lin *) lin_;
+
+   vec_destroy(lin->u);
+   vec_destroy(lin->w);
+   vec_destroy(lin->Ba);
+   vec_destroy(lin->Bl);
+   vec_destroy(lin->Bb);
+   vec_destroy(lin->BTa);
+   vec_destroy(lin->BTl);
+   vec_destroy(lin->BTb);
+   vec_destroy(lin->Ca);
+   vec_destroy(lin->Cl);
+   vec_destroy(lin->Cb);
+   free(lin);
+
+   return 0;
+}
+
+/*------------------------------------*/
+
 /* This is only called from level 0 */
 
 int
@@ -907,7 +996,7 @@ main(int argc, char *argv[])
   int         rank, ntime, mspace, arg_index;
   double      alpha, nu;
   int         max_levels, min_coarse, nrelax, nrelaxc, cfactor, maxiter;
-  int         access_level, print_level;
+  int         access_level, print_level, newton_start, newton_lag, newton_clag;
   double      tol;
   double time;
   start=clock();
@@ -934,6 +1023,9 @@ main(int argc, char *argv[])
   tol            = 1.0e-6;
   access_level   = 2;
   print_level    = 2;
+  newton_start   = 0;
+  newton_lag     = 0;          /* Linearize in every TriSolve */
+  newton_clag    = 0;
 
   /* Parse command line */
   arg_index = 1;
@@ -960,6 +1052,8 @@ main(int argc, char *argv[])
       printf("  -tol <tol>              : Stopping tolerance \n");
       printf("  -access <access_level>  : Braid access level \n");
       printf("  -print <print_level>    : Braid print level \n");
+      printf("  -newton <start> <lag> <clag> : From iteration start on, reuse linearizations\n");
+      printf("                                 for lag (clag on coarse grids) iterations\n");
       exit(1);
     }
     else if ( strcmp(argv[arg_index], "-ntime") == 0 )
@@ -1027,6 +1121,13 @@ main(int argc, char *argv[])
       arg_index++;
       print_level = atoi(argv[arg_index++]);
     }
+    else if ( strcmp(argv[arg_index], "-newton") == 0 )
+    {
+      arg_index++;
+      newton_start = atoi(argv[arg_index++]);
+      newton_lag   = atoi(argv[arg_index++]);
+      newton_clag  = atoi(argv[arg_index++]);
+    }
     else
     {
       printf("ABORTING: incorrect command line parameter %s\n", argv[arg_index]);
@@ -1096,6 +1197,10 @@ main(int argc, char *argv[])
   braid_SetPrintLevel( core, print_level);       
   braid_SetMaxIter(core, maxiter);
   braid_SetAbsTol(core, tol);
+  if (newton_lag > 0)
+  {
+    braid_SetTriNewton(core, my_TriLinearize, my_TriLinFree, newton_start, newton_lag, newton_clag);
+  }
 
   /* Parallel-in-time TriMGRIT simulation */
   braid_Drive(core);
@@ -861,6 +861,28 @@ my_SpatialNorm(braid_App     app,
 
 /*------------------------------------*/
 
+int
+my_InnerProd(braid_App     app,
+             braid_Vector  u,
+             braid_Vector  v,
+             double       *prod_ptr)
+{
+   int i;
+   double dot = 0.0;
+   int mspace = (app->mspace);
+   for (i = 0; i <= mspace-1; i++)
+   {
+      dot += (u->values)[0][i]*(v->values)[0][i];
+      dot += (u->values)[1][i]*(v->values)[1][i];
+      dot += (u->values)[2][i]*(v->values)[2][i];
+   }
+   *prod_ptr = dot;
+
+   return 0;
+}
+
+/*------------------------------------*/
+
 // ZTODO: Need to compute u from adjoint and it reqires communication
 
 int
@@ -989,6 +1011,7 @@ main(int argc, char *argv[])
    double      alpha, nu;
    int         max_levels, min_coarse, nrelax, nrelaxc, cfactor, maxiter;
    int         access_level, print_level;
+   int         anderson_dim, anderson_ortho;
    double      tol;
    double time;
    start=clock();
@@ -1015,6 +1038,8 @@ main(int argc, char *argv[])
    tol            = 1.0e-6;
    access_level   = 2;
    print_level    = 2;
+   anderson_dim   = 0;
+   anderson_ortho = 0;
 
 
    /* Parse command line */
@@ -1042,6 +1067,7 @@ main(int argc, char *argv[])
          printf("  -tol <tol>              : Stopping tolerance \n");
          printf("  -access <access_level>  : Braid access level \n");
          printf("  -print <print_level>    : Braid print level \n");
+         printf("  -anderson <kdim> <ortho>: Anderson acceleration over the last kdim cycles, Gram-Schmidt variant ortho\n");
          exit(1);
       }
       else if ( strcmp(argv[arg_index], "-ntime") == 0 )
@@ -1109,6 +1135,12 @@ main(int argc, char *argv[])
          arg_index++;
          print_level = atoi(argv[arg_index++]);
       }
+      else if ( strcmp(argv[arg_index], "-anderson") == 0 )
+      {
+         arg_index++;
+         anderson_dim   = atoi(argv[arg_index++]);
+         anderson_ortho = atoi(argv[arg_index++]);
+      }
       else
       {
          printf("ABORTING: incorrect command line parameter %s\n", argv[arg_index]);
@@ -1182,6 +1214,10 @@ main(int argc, char *argv[])
    braid_SetPrintLevel( core, print_level);       
    braid_SetMaxIter(core, maxiter);
    braid_SetAbsTol(core, tol);
+   if (anderson_dim > 0)
+   {
+      braid_SetAnderson(core, anderson_dim, anderson_ortho, my_InnerProd);
+   }
 
    /* Parallel-in-time TriMGRIT simulation */
    braid_Drive(core);
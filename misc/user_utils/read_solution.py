@@ -0,0 +1,81 @@
+# Copyright (c) 2013, Lawrence Livermore National Security, LLC. 
+# Produced at the Lawrence Livermore National Laboratory. Written by 
+# Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin 
+# Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+# 
+# This file is part of XBraid. For support, post issues to the XBraid Github page.
+# 
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License (as published by the Free Software
+# Foundation) version 2.1 dated February 1999.
+# 
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+# PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+# License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc., 59
+# Temple Place, Suite 330, Boston, MA 02111-1307 USA
+#
+
+import numpy as np
+from sys import argv, exit
+
+##
+# Reader for the binary solution files written by braid_SetWriteSolution.
+# The records are memory mapped, so nothing is read until it is used.
+#
+#   t, index, size, data = read_solution('file.bin')
+#   u = solution_values('file.bin', dtype='<f8', offset=8)
+#
+# The meaning of the data bytes is set by the user's BufPack routine.
+
+header_size = 64
+record_head = 24
+
+def read_header(filename):
+    header = np.fromfile(filename, dtype='<i8', count=header_size//8)
+    if header[0:1].tobytes() != b'XBRDSOL\x00':
+        raise ValueError(filename + ' is not an XBraid solution file')
+    # version, number of records, record size, data size
+    return int(header[1]), int(header[2]), int(header[3]), int(header[4])
+
+def read_solution(filename):
+    version, nrecords, recsize, datasize = read_header(filename)
+    rec = np.dtype([('t', '<f8'), ('index', '<i8'), ('size', '<i8'),
+                    ('data', 'u1', (datasize,))])
+    recs = np.memmap(filename, dtype=rec, mode='r', offset=header_size,
+                     shape=(nrecords,))
+    return recs['t'], recs['index'], recs['size'], recs['data']
+
+def solution_values(filename, dtype='<f8', offset=0, count=-1):
+    ''' Map the packed data of each record as an array of dtype, skipping
+        offset bytes (e.g., a size stored by BufPack) '''
+    version, nrecords, recsize, datasize = read_header(filename)
+    dtype = np.dtype(dtype)
+    if count < 0:
+        count = (datasize - offset) // dtype.itemsize
+    raw = np.memmap(filename, dtype='u1', mode='r')
+    return np.ndarray((nrecords, count), dtype=dtype, buffer=raw,
+                      offset=header_size + record_head + offset,
+                      strides=(recsize, dtype.itemsize))
+
+if __name__ == "__main__":
+
+    if len(argv) != 2 or argv[1] in ('-help', '--help', 'help'):
+        print('''
+              Reader for XBraid binary solution files
+
+              Usage:  python read_solution.py <file>
+
+              Prints the time points and sizes in the file.  Import
+              read_solution() and solution_values() to use the data.
+              ''')
+        exit()
+
+    version, nrecords, recsize, datasize = read_header(argv[1])
+    t, index, size, data = read_solution(argv[1])
+    print('version %d, %d records of %d bytes' % (version, nrecords, recsize))
+    print('time [%e, %e], packed size %d to %d bytes' %
+          (t[0], t[-1], size.min(), size.max()))
@@ -0,0 +1,147 @@
+#!/bin/bash
+#BHEADER**********************************************************************
+#
+# Copyright (c) 2013, Lawrence Livermore National Security, LLC. 
+# Produced at the Lawrence Livermore National Laboratory. Written by 
+# Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin 
+# Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+# 
+# This file is part of XBraid. For support, post issues to the XBraid Github page.
+# 
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License (as published by the Free Software
+# Foundation) version 2.1 dated February 1999.
+# 
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+# PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+# License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc., 59
+# Temple Place, Suite 330, Boston, MA 02111-1307 USA
+#
+#EHEADER**********************************************************************
+
+# scriptname holds the script name, with the .sh removed
+scriptname=`basename $0 .sh`
+
+# Echo usage information
+case $1 in
+   -h|-help)
+      cat <<EOF
+
+   $0 [-h|-help] 
+
+   where: -h|-help   prints this usage information and exits
+
+   This script runs the example ex-04-omgrit, which prints its solution with a
+   bulk access routine (braid_SetAccessBulk), and compares the residual history
+   and the solution files against the saved output of the same runs with
+   per-point access.  The output is written to $scriptname.out, $scriptname.err
+   and $scriptname.dir.
+   This test passes if $scriptname.err is empty.
+
+   Example usage: ./test.sh $0 
+
+EOF
+      exit
+      ;;
+esac
+
+# Determine csplit and mpirun command for this machine 
+OS=`uname`
+case $OS in
+   Linux*) 
+      MACHINES_FILE="hostname"
+      if [ ! -f $MACHINES_FILE ] ; then
+         hostname > $MACHINES_FILE
+      fi
+      RunString="mpirun -machinefile `pwd`/$MACHINES_FILE $*"
+      csplitcommand="csplit"
+      ;;
+   Darwin*)
+      csplitcommand="gcsplit"
+      RunString="mpirun --hostfile ~/.machinefile_mac"
+      ;;
+   *)
+      RunString="mpirun"
+      csplitcommand="csplit"
+      ;;
+esac
+
+
+# Setup
+example_dir=`pwd`/../examples
+test_dir=`pwd`
+output_dir=`pwd`/$scriptname.dir
+rm -fr $output_dir
+mkdir -p $output_dir/out
+
+
+# compile the regression test examples 
+echo "Compiling regression test examples"
+cd $example_dir
+make ex-04-omgrit
+cd $test_dir
+
+# Run the following regression tests.  The runs cover one rank, several
+# ranks, access after every iteration (-access 2), and the direct solve.  The
+# example writes its solution to out/, one file per rank for each of w, u and v.
+TESTS=( "$RunString -np 1 $example_dir/ex-04-omgrit -ntime 32" \
+        "$RunString -np 3 $example_dir/ex-04-omgrit -ntime 32" \
+        "$RunString -np 4 $example_dir/ex-04-omgrit -ntime 64 -access 2" \
+        "$RunString -np 2 $example_dir/ex-04-omgrit -ntime 32 -direct" )
+
+# The below commands will then dump each of the tests to the output files 
+#   $output_dir/unfiltered.std.out.0, 
+#   $output_dir/std.out.0, 
+#   $output_dir/std.err.0,
+#    
+#   $output_dir/unfiltered.std.out.1,
+#   $output_dir/std.out.1, 
+#   $output_dir/std.err.1,
+#   ...
+#
+# The unfiltered output is the direct output of the script, whereas std.out.*
+# is filtered by a grep for the lines that are to be checked.  
+#
+lines_to_check="Braid: \|\| r_[0-9]* \|\| = [^,]*|^  iterations .*|^[0-9]{5}: .*"
+#
+# Then, each std.out.num is compared against stored correct output in 
+# $scriptname.saved.num, which is generated by splitting $scriptname.saved
+#
+TestDelimiter='# Begin Test'
+$csplitcommand -n 1 --silent --prefix $output_dir/$scriptname.saved. $scriptname.saved "%$TestDelimiter%" "/$TestDelimiter.*/" {*}
+#
+# The result of that diff is appended to std.err.num. 
+
+# Run regression tests
+counter=0
+for test in "${TESTS[@]}"
+do
+   echo "Running Test $counter"
+   # Run in $output_dir, whose out/ collects the solution files of the example
+   cd $output_dir
+   rm -f out/ex-04-omgrit.out.*
+   eval "$test" 1>> unfiltered.std.out.$counter  2>> std.out.$counter
+   cat out/ex-04-omgrit.out.w.* out/ex-04-omgrit.out.u.* out/ex-04-omgrit.out.v.* >> unfiltered.std.out.$counter
+   egrep -o "$lines_to_check" unfiltered.std.out.$counter > std.out.$counter
+   diff -U3 -B -bI"$TestDelimiter" $scriptname.saved.$counter std.out.$counter >> std.err.$counter
+   cd $test_dir
+   counter=$(( $counter + 1 ))
+done 
+
+
+# Echo to stderr all nonempty error files in $output_dir.  test.sh
+# collects these file names and puts them in the error report
+for errfile in $( find $output_dir ! -size 0 -name "*.err.*" )
+do
+   echo $errfile >&2
+done
+
+
+# remove machinefile, if created
+if [ -n $MACHINES_FILE ] ; then
+   rm $MACHINES_FILE 2> /dev/null
+fi
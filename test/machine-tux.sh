@@ -68,6 +68,12 @@ TESTS=( "diffusion1D.sh " \
         "test-checkout-compile.sh " \
         "adjoint.sh " \
         "shellvector_bdf2.sh "\
+        "perf.sh "\
+        "shmcomm.sh "\
+        "compress.sh "\
+        "async.sh "\
+        "bulkaccess.sh "\
+        "braidcoret.sh "\
         "memcheck-tux-jacob.sh ")
 #       Need to fix the issues with refinement = 2 
 #        "ode1D.sh" \
@@ -0,0 +1,236 @@
+#!/bin/bash
+#BHEADER**********************************************************************
+#
+# Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+# Produced at the Lawrence Livermore National Laboratory. Written by
+# Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin
+# Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+#
+# This file is part of XBraid. For support, post issues to the XBraid Github page.
+#
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License (as published by the Free Software
+# Foundation) version 2.1 dated February 1999.
+#
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+# PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+# License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc., 59
+# Temple Place, Suite 330, Boston, MA 02111-1307 USA
+#
+#EHEADER**********************************************************************
+
+# scriptname holds the script name, with the .sh removed
+scriptname=`basename $0 .sh`
+
+# Tolerance (percent) on the counts, and factor on the time ratio
+count_tol=10
+time_factor=3
+
+# Echo usage information
+calibrate="no"
+timing="no"
+while [ $# -gt 0 ]
+do
+case $1 in
+   -h|-help)
+      cat <<EOF
+
+   $0 [-h|-help] [-timing] [-calibrate]
+
+   where: -h|-help     prints this usage information and exits
+          -timing      also checks the wall time (see below)
+          -calibrate   writes the measured values to $scriptname.saved.new, to
+                       replace $scriptname.saved after an intended change
+                       (implies -timing)
+
+   This script runs performance regression tests of Braid.  Each test writes a
+   bench record (BRAID_BENCH_FILE) with the number of calls to each user
+   routine, the peak number of live user vectors, and the bytes and number of
+   allocations through the Braid allocation macros.  These are checked against
+   the budgets in $scriptname.saved, with a tolerance of $count_tol percent.
+   With -timing, the wall time is also checked relative to sequential time
+   stepping of drive-lorenz, run with the same launcher and number of ranks as
+   the tests, and may be $time_factor times the saved ratio.  This depends on
+   the machine, so it is not part of the default check.
+   The output is written to $scriptname.out, $scriptname.err and
+   $scriptname.dir. This test passes if $scriptname.err is empty.
+
+   Example usage: ./test.sh $0
+
+EOF
+      exit
+      ;;
+   -timing)
+      timing="yes"
+      shift
+      ;;
+   -calibrate)
+      calibrate="yes"
+      timing="yes"
+      shift
+      ;;
+   *)
+      break
+      ;;
+esac
+done
+
+# Determine csplit and mpirun command for this machine
+OS=`uname`
+case $OS in
+   Linux*)
+      MACHINES_FILE="hostname"
+      if [ ! -f $MACHINES_FILE ] ; then
+         hostname > $MACHINES_FILE
+      fi
+      RunString="mpirun -machinefile `pwd`/$MACHINES_FILE $*"
+      csplitcommand="csplit"
+      ;;
+   Darwin*)
+      csplitcommand="gcsplit"
+      RunString="mpirun --hostfile ~/.machinefile_mac"
+      ;;
+   *)
+      RunString="mpirun"
+      csplitcommand="csplit"
+      ;;
+esac
+
+
+# Setup
+example_dir=`pwd`/../examples
+driver_dir=`pwd`/../drivers
+test_dir=`pwd`
+output_dir=`pwd`/$scriptname.dir
+rm -fr $output_dir 2> /dev/null
+mkdir -p $output_dir/out
+
+
+# compile the regression test drivers
+echo "Compiling regression test drivers"
+cd $example_dir
+make ex-04-omgrit advec-diff-imp
+cd $test_dir
+cd $driver_dir
+make drive-lorenz drive-burgers-1D HYPRE_LIB= HYPRE_FLAGS=
+cd $test_dir
+
+
+# Calibration: sequential time stepping, the best of three runs, on as many
+# ranks as the tests so that oversubscription slows both alike
+calibration="$RunString -np 2 $driver_dir/drive-lorenz -ntime 40000 -ml 1"
+
+# Run the following regression tests
+TESTS=( "$RunString -np 2 $driver_dir/drive-lorenz -ntime 10000 -tstop 10 -ml 3 -cf 2" \
+        "$RunString -np 2 $driver_dir/drive-burgers-1D -nt 1024 -ml 3 -cf 2" \
+        "$RunString -np 2 $example_dir/ex-04-omgrit -ntime 4096 -ml 2 -cf 2 -direct" \
+        "$RunString -np 2 $example_dir/advec-diff-imp -ntime 256 -mspace 8 -ml 2 -direct -mi 30" )
+
+# The values checked for each test, as named in the bench record
+values_to_check="step triresidual trisolve clone free bufpack vectors_peak alloc_bytes alloc_count"
+
+# The below commands will then dump each of the tests to the output files
+#   $output_dir/unfiltered.std.out.0,
+#   $output_dir/bench.0,
+#   $output_dir/std.out.0,
+#   $output_dir/std.err.0,
+#   ...
+#
+# where bench.* is the bench record and std.out.* holds the values to check,
+# one "name value" per line, and with -timing time_ratio, the wall time over
+# the calibration time.  Then, each std.out.num is compared against the budgets in
+# $scriptname.saved.num, which is generated by splitting $scriptname.saved
+#
+TestDelimiter='# Begin Test'
+$csplitcommand -n 1 --silent --prefix $output_dir/$scriptname.saved. $scriptname.saved "%$TestDelimiter%" "/$TestDelimiter.*/" {*}
+#
+# Each value over its budget is appended to std.err.num.
+
+# Echo the value of field $1 in the bench record $2
+bench_value()
+{
+   grep -o "\"$1\": [-0-9.e+]*" $2 | tail -1 | sed 's/.*: //'
+}
+
+# Calibrate
+if [ "$timing" = "yes" ]; then
+   cd $output_dir
+   calibration_time=""
+   for i in 1 2 3
+   do
+      rm -f $output_dir/calibration
+      eval "BRAID_BENCH_FILE=$output_dir/calibration $calibration" > /dev/null 2>&1
+      t=`bench_value time $output_dir/calibration`
+      calibration_time=`awk -v a="$calibration_time" -v b="$t" 'BEGIN { if (a == "" || b+0 < a+0) print b; else print a }'`
+   done
+   echo "calibration time $calibration_time" > $output_dir/calibration
+   cd $test_dir
+fi
+
+# Run regression tests
+counter=0
+for test in "${TESTS[@]}"
+do
+   echo "Running Test $counter"
+   # Run in $output_dir, which collects the solution files (in out/ for the
+   # examples)
+   cd $output_dir
+   eval "BRAID_BENCH_FILE=$output_dir/bench.$counter $test" 1>> unfiltered.std.out.$counter 2>> unfiltered.std.out.$counter
+   if [ -f bench.$counter ]; then
+      for value in $values_to_check
+      do
+         echo "$value `bench_value $value bench.$counter`" >> std.out.$counter
+      done
+      if [ "$timing" = "yes" ]; then
+         awk -v t="`bench_value time bench.$counter`" -v c="$calibration_time" \
+            'BEGIN { printf "time_ratio %.3f\n", t/c }' >> std.out.$counter
+      fi
+      awk -v tol=$count_tol -v factor=$time_factor '
+         FNR == NR { if ($1 !~ /^#/) budget[$1] = $2; next }
+         ($1 in budget) {
+            if ($1 == "time_ratio") limit = budget[$1]*factor
+            else                    limit = budget[$1]*(1 + tol/100)
+            if ($2+0 > limit)
+               printf "%s = %s is over the budget %s (limit %g)\n", $1, $2, budget[$1], limit
+         }' $scriptname.saved.$counter std.out.$counter >> std.err.$counter
+   else
+      echo "no bench record written" >> std.err.$counter
+   fi
+   # check whether test was successfull (portable on UNIX systems)
+   if [ `du std.err.$counter | cut -f1` -gt 0 ]; then
+      echo "...did not pass."
+   fi
+   cd $test_dir
+   counter=$(( $counter + 1 ))
+done
+
+
+# Write the measured values as the new budgets
+if [ "$calibrate" = "yes" ]; then
+   rm -f $scriptname.saved.new
+   for (( i = 0; i < $counter; i++ ))
+   do
+      echo "$TestDelimiter $i" >> $scriptname.saved.new
+      cat $output_dir/std.out.$i >> $scriptname.saved.new
+   done
+   echo "Wrote $scriptname.saved.new"
+fi
+
+
+# Echo to stderr all nonempty error files in $output_dir.  test.sh
+# collects these file names and puts them in the error report
+for errfile in $( find $output_dir ! -size 0 -name "*.err.*" )
+do
+   echo $errfile >&2
+done
+
+
+# remove machinefile, if created
+if [ -n $MACHINES_FILE ] ; then
+   rm $MACHINES_FILE 2> /dev/null
+fi
+rm braid.out.cycle 2> /dev/null
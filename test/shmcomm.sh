@@ -0,0 +1,162 @@
+#!/bin/bash
+#BHEADER**********************************************************************
+#
+# Copyright (c) 2013, Lawrence Livermore National Security, LLC. 
+# Produced at the Lawrence Livermore National Laboratory. Written by 
+# Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin 
+# Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+# 
+# This file is part of XBraid. For support, post issues to the XBraid Github page.
+# 
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License (as published by the Free Software
+# Foundation) version 2.1 dated February 1999.
+# 
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+# PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+# License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc., 59
+# Temple Place, Suite 330, Boston, MA 02111-1307 USA
+#
+#EHEADER**********************************************************************
+
+# scriptname holds the script name, with the .sh removed
+scriptname=`basename $0 .sh`
+
+# Echo usage information
+case $1 in
+   -h|-help)
+      cat <<EOF
+
+   $0 [-h|-help] 
+
+   where: -h|-help   prints this usage information and exits
+
+   This script runs drive-burgers-1D with the shared-memory exchange between
+   time neighbors (braid_SetShmComm), on more ranks than each rank has message
+   slots (one), and compares the residual history with the MPI exchange.  The
+   output is written to $scriptname.out, $scriptname.err and $scriptname.dir.
+   This test passes if $scriptname.err is empty.
+
+   Example usage: ./test.sh $0 
+
+EOF
+      exit
+      ;;
+esac
+
+# Determine csplit and mpirun command for this machine 
+OS=`uname`
+case $OS in
+   Linux*) 
+      MACHINES_FILE="hostname"
+      if [ ! -f $MACHINES_FILE ] ; then
+         hostname > $MACHINES_FILE
+      fi
+      RunString="mpirun -machinefile `pwd`/$MACHINES_FILE $*"
+      csplitcommand="csplit"
+      ;;
+   Darwin*)
+      csplitcommand="gcsplit"
+      RunString="mpirun --hostfile ~/.machinefile_mac"
+      ;;
+   *)
+      RunString="mpirun"
+      csplitcommand="csplit"
+      ;;
+esac
+
+
+# Setup
+driver_dir=`pwd`/../drivers
+test_dir=`pwd`
+output_dir=`pwd`/$scriptname.dir
+rm -fr $output_dir
+mkdir -p $output_dir
+
+
+# compile the regression test drivers 
+echo "Compiling regression test drivers"
+cd $driver_dir
+make drive-burgers-1D HYPRE_LIB= HYPRE_FLAGS=
+cd $test_dir
+
+# Run the following regression tests.  All ranks run on one node, so every
+# message between time neighbors goes through the shared-memory slots.  Each
+# -shm run is followed by the same run with MPI messages, and both must print
+# the same residual history.  The runs cover multilevel V-cycles, FMG and a
+# deep hierarchy whose coarse levels are empty on most ranks.
+TESTS=( "$RunString -np 8 $driver_dir/drive-burgers-1D -st 1 -nx 32 -nt 128 -ml 4 -shm" \
+        "$RunString -np 8 $driver_dir/drive-burgers-1D -st 1 -nx 32 -nt 128 -ml 4" \
+        "$RunString -np 3 $driver_dir/drive-burgers-1D -st 1 -nx 32 -nt 128 -ml 4 -shm" \
+        "$RunString -np 3 $driver_dir/drive-burgers-1D -st 1 -nx 32 -nt 128 -ml 4" \
+        "$RunString -np 8 $driver_dir/drive-burgers-1D -st 1 -nx 32 -nt 128 -ml 3 -fmg 1 -shm" \
+        "$RunString -np 8 $driver_dir/drive-burgers-1D -st 1 -nx 32 -nt 128 -ml 3 -fmg 1" \
+        "$RunString -np 8 $driver_dir/drive-burgers-1D -prob 0 -st 1 -nx 32 -nt 64 -ml 6 -cf 2 -shm" \
+        "$RunString -np 8 $driver_dir/drive-burgers-1D -prob 0 -st 1 -nx 32 -nt 64 -ml 6 -cf 2" )
+
+# The below commands will then dump each of the tests to the output files 
+#   $output_dir/unfiltered.std.out.0, 
+#   $output_dir/std.out.0, 
+#   $output_dir/std.err.0,
+#    
+#   $output_dir/unfiltered.std.out.1,
+#   $output_dir/std.out.1, 
+#   $output_dir/std.err.1,
+#   ...
+#
+# The unfiltered output is the direct output of the script, whereas std.out.*
+# is filtered by a grep for the lines that are to be checked.  
+#
+lines_to_check="Braid: \|\| r_[0-9]* \|\| = [^,]*|^  iterations .*"
+#
+# Then, each std.out.num is compared against stored correct output in 
+# $scriptname.saved.num, which is generated by splitting $scriptname.saved
+#
+TestDelimiter='# Begin Test'
+$csplitcommand -n 1 --silent --prefix $output_dir/$scriptname.saved. $scriptname.saved "%$TestDelimiter%" "/$TestDelimiter.*/" {*}
+#
+# The result of that diff is appended to std.err.num. 
+
+# Run regression tests
+counter=0
+for test in "${TESTS[@]}"
+do
+   echo "Running Test $counter"
+   # Run in $output_dir, which collects the solution files of the driver
+   cd $output_dir
+   eval "$test" 1>> unfiltered.std.out.$counter  2>> std.out.$counter
+   egrep -o "$lines_to_check" unfiltered.std.out.$counter > std.out.$counter
+   diff -U3 -B -bI"$TestDelimiter" $scriptname.saved.$counter std.out.$counter >> std.err.$counter
+   cd $test_dir
+   counter=$(( $counter + 1 ))
+done 
+
+
+# Each -shm run must match the MPI run that follows it
+counter=0
+while [ $counter -lt ${#TESTS[@]} ]
+do
+   next=$(( $counter + 1 ))
+   cd $output_dir
+   diff std.out.$counter std.out.$next >> std.err.$counter
+   cd $test_dir
+   counter=$(( $counter + 2 ))
+done
+
+
+# Echo to stderr all nonempty error files in $output_dir.  test.sh
+# collects these file names and puts them in the error report
+for errfile in $( find $output_dir ! -size 0 -name "*.err.*" )
+do
+   echo $errfile >&2
+done
+
+
+# remove machinefile, if created
+if [ -n $MACHINES_FILE ] ; then
+   rm $MACHINES_FILE 2> /dev/null
+fi